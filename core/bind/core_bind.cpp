@@ -76,6 +76,30 @@ RES _ResourceLoader::load(const String &p_path, const String &p_type_hint, bool
 	return ret;
 }
 
+Error _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+	return ResourceLoader::load_threaded_request(p_path, p_type_hint, p_use_sub_threads);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(const String &p_path, const Variant &r_progress) {
+	float progress = 0;
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(p_path, &progress);
+	// Only write to an array the caller passed, never to a default shared by all calls.
+	if (r_progress.get_type() == Variant::ARRAY) {
+		Array progress_array = r_progress;
+		progress_array.resize(1);
+		progress_array[0] = progress;
+	}
+	return (ThreadLoadStatus)status;
+}
+
+RES _ResourceLoader::load_threaded_get(const String &p_path) {
+	Error err = OK;
+	RES ret = ResourceLoader::load_threaded_get(p_path, &err);
+
+	ERR_FAIL_COND_V_MSG(err != OK, ret, "Error loading resource: '" + p_path + "'.");
+	return ret;
+}
+
 PoolVector<String> _ResourceLoader::get_recognized_extensions_for_type(const String &p_type) {
 	List<String> exts;
 	ResourceLoader::get_recognized_extensions_for_type(p_type, &exts);
@@ -122,6 +146,9 @@ bool _ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 void _ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_interactive", "path", "type_hint"), &_ResourceLoader::load_interactive, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "no_cache"), &_ResourceLoader::load, DEFVAL(""), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads"), &_ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &_ResourceLoader::load_threaded_get);
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &_ResourceLoader::get_recognized_extensions_for_type);
 	ClassDB::bind_method(D_METHOD("set_abort_on_missing_resources", "abort"), &_ResourceLoader::set_abort_on_missing_resources);
 	ClassDB::bind_method(D_METHOD("get_dependencies", "path"), &_ResourceLoader::get_dependencies);
@@ -130,6 +157,11 @@ void _ResourceLoader::_bind_methods() {
 #ifndef DISABLE_DEPRECATED
 	ClassDB::bind_method(D_METHOD("has", "path"), &_ResourceLoader::has);
 #endif // DISABLE_DEPRECATED
+
+	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_LOADED);
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -684,6 +716,29 @@ uint64_t _OS::get_dynamic_memory_usage() const {
 	return OS::get_singleton()->get_dynamic_memory_usage();
 }
 
+Dictionary _OS::get_small_allocator_stats() const {
+	Dictionary ret;
+	ret["enabled"] = Memory::is_small_allocator_enabled();
+	if (!Memory::is_small_allocator_enabled()) {
+		return ret;
+	}
+
+	Memory::SmallAllocStats stats = Memory::get_small_alloc_stats();
+	ret["bytes_in_use"] = stats.bytes_in_use;
+	ret["bytes_reserved"] = stats.bytes_reserved;
+	ret["cross_thread_frees"] = stats.cross_thread_frees;
+
+	Array class_sizes;
+	Array class_allocations;
+	for (int i = 0; i < Memory::SMALL_ALLOC_CLASS_COUNT; i++) {
+		class_sizes.push_back(stats.class_sizes[i]);
+		class_allocations.push_back(stats.class_allocations[i]);
+	}
+	ret["class_sizes"] = class_sizes;
+	ret["class_allocations"] = class_allocations;
+	return ret;
+}
+
 void _OS::set_native_icon(const String &p_filename) {
 	OS::get_singleton()->set_native_icon(p_filename);
 }
@@ -1369,6 +1424,7 @@ void _OS::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_static_memory_usage"), &_OS::get_static_memory_usage);
 	ClassDB::bind_method(D_METHOD("get_static_memory_peak_usage"), &_OS::get_static_memory_peak_usage);
 	ClassDB::bind_method(D_METHOD("get_dynamic_memory_usage"), &_OS::get_dynamic_memory_usage);
+	ClassDB::bind_method(D_METHOD("get_small_allocator_stats"), &_OS::get_small_allocator_stats);
 
 	ClassDB::bind_method(D_METHOD("get_user_data_dir"), &_OS::get_user_data_dir);
 	ClassDB::bind_method(D_METHOD("get_system_dir", "dir", "shared_storage"), &_OS::get_system_dir, DEFVAL(true));
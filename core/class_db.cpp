@@ -232,6 +232,14 @@ ClassDB::APIType ClassDB::current_api = API_CORE;
 
 void ClassDB::set_current_api(APIType p_api) {
 	current_api = p_api;
+
+	// API_NONE means registration is done, see main.cpp. Anything else means it's (re)starting.
+	if (p_api == API_NONE) {
+		method_tables_enabled.set();
+	} else {
+		method_tables_enabled.clear();
+		_invalidate_method_tables();
+	}
 }
 
 ClassDB::APIType ClassDB::get_current_api() {
@@ -624,7 +632,140 @@ void ClassDB::get_method_list(StringName p_class, List<MethodInfo> *p_methods, b
 	}
 }
 
-MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
+SafeFlag ClassDB::method_tables_enabled;
+std::atomic<ClassDB::MethodTable *> ClassDB::method_table(nullptr);
+ClassDB::MethodTable *ClassDB::retired_method_tables = nullptr;
+SafeNumeric<uint32_t> ClassDB::method_table_generation(1);
+Mutex ClassDB::method_table_mutex;
+
+uint32_t ClassDB::_method_table_hash(const StringName &p_class, const StringName &p_name) {
+	uint32_t hash = hash_djb2_one_32(p_name.hash(), p_class.hash());
+	return hash ? hash : 1; // Zero marks an empty slot.
+}
+
+const ClassDB::MethodTableEntry *ClassDB::_method_table_find(const MethodTable *p_table, uint32_t p_hash, const StringName &p_class, const StringName &p_name) {
+	uint32_t pos = p_hash & p_table->mask;
+	while (true) {
+		const MethodTableEntry &entry = p_table->entries[pos];
+		uint32_t hash = entry.hash.load(std::memory_order_acquire);
+		if (hash == 0) {
+			return nullptr;
+		}
+		if (hash == p_hash && entry.class_name == p_class && entry.name == p_name) {
+			return &entry;
+		}
+		pos = (pos + 1) & p_table->mask;
+	}
+}
+
+void ClassDB::_method_table_insert(MethodTable *p_table, uint32_t p_hash, uint32_t p_generation, const StringName &p_class, const StringName &p_name, MethodBind *p_method) {
+	uint32_t pos = p_hash & p_table->mask;
+	while (p_table->entries[pos].hash.load(std::memory_order_relaxed) != 0) {
+		pos = (pos + 1) & p_table->mask;
+	}
+	MethodTableEntry &entry = p_table->entries[pos];
+	entry.generation = p_generation;
+	entry.class_name = p_class;
+	entry.name = p_name;
+	entry.method = p_method;
+	entry.hash.store(p_hash, std::memory_order_release);
+	p_table->count++;
+}
+
+// Called with the read lock held; takes the table mutex after it, like the writers do.
+bool ClassDB::_flatten_method_table(const StringName &p_class) {
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type) {
+		return false;
+	}
+
+	MutexLock table_lock(method_table_mutex);
+
+	MethodTable *table = method_table.load(std::memory_order_relaxed);
+	if (table && _method_table_find(table, _method_table_hash(p_class, StringName()), p_class, StringName())) {
+		return true; // Another thread got here first.
+	}
+
+	// Most derived definition wins.
+	HashMap<StringName, MethodBind *> methods;
+	for (ClassInfo *t = type; t; t = t->inherits_ptr) {
+		const StringName *K = nullptr;
+		while ((K = t->method_map.next(K))) {
+			MethodBind *method = t->method_map[*K];
+			if (method && !methods.has(*K)) {
+				methods[*K] = method;
+			}
+		}
+	}
+
+	// Keep the load factor at or below one half.
+	uint32_t needed = (table ? table->count : 0) + methods.size() + 1;
+	if (!table || needed * 2 > table->mask + 1) {
+		uint32_t capacity = table ? table->mask + 1 : 256;
+		while (needed * 2 > capacity) {
+			capacity <<= 1;
+		}
+
+		MethodTable *grown = memnew(MethodTable);
+		grown->mask = capacity - 1;
+		grown->entries = memnew_arr(MethodTableEntry, capacity);
+		if (table) {
+			for (uint32_t i = 0; i <= table->mask; i++) {
+				const MethodTableEntry &entry = table->entries[i];
+				uint32_t hash = entry.hash.load(std::memory_order_relaxed);
+				if (hash) {
+					_method_table_insert(grown, hash, entry.generation, entry.class_name, entry.name, entry.method);
+				}
+			}
+			// Entries keep their meaning, so caches pointing into the old table stay valid.
+			table->retired_next = retired_method_tables;
+			retired_method_tables = table;
+		}
+		table = grown;
+		method_table.store(table, std::memory_order_release);
+	}
+
+	// Only bumped under the table mutex, so this is the generation of the table being filled.
+	uint32_t generation = method_table_generation.get();
+	const StringName *K = nullptr;
+	while ((K = methods.next(K))) {
+		_method_table_insert(table, _method_table_hash(p_class, *K), generation, p_class, *K, methods[*K]);
+	}
+	_method_table_insert(table, _method_table_hash(p_class, StringName()), generation, p_class, StringName(), nullptr);
+
+	return true;
+}
+
+// Sets r_invalidated when the table was invalidated while flattening p_class, in which case the caller
+// has to fall back to _get_method_locked().
+const ClassDB::MethodTableEntry *ClassDB::_get_method_entry(const StringName &p_class, const StringName &p_name, bool &r_invalidated) {
+	uint32_t hash = _method_table_hash(p_class, p_name);
+	uint32_t marker_hash = _method_table_hash(p_class, StringName());
+	r_invalidated = false;
+
+	for (int attempt = 0; attempt < 2; attempt++) {
+		const MethodTable *table = method_table.load(std::memory_order_acquire);
+		if (table) {
+			const MethodTableEntry *entry = _method_table_find(table, hash, p_class, p_name);
+			if (entry) {
+				return entry;
+			}
+			if (_method_table_find(table, marker_hash, p_class, StringName())) {
+				return nullptr; // Class is flattened, so the method doesn't exist.
+			}
+		}
+		if (attempt == 0) {
+			OBJTYPE_RLOCK;
+			if (!_flatten_method_table(p_class)) {
+				return nullptr;
+			}
+		}
+	}
+	r_invalidated = true;
+	return nullptr;
+}
+
+MethodBind *ClassDB::_get_method_locked(const StringName &p_class, const StringName &p_name) {
 	OBJTYPE_RLOCK;
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -639,6 +780,54 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	return nullptr;
 }
 
+void ClassDB::_invalidate_method_tables() {
+	MutexLock table_lock(method_table_mutex);
+
+	// Bumping the generation makes every call site cache miss.
+	method_table_generation.increment();
+
+	MethodTable *table = method_table.load(std::memory_order_relaxed);
+	if (table) {
+		method_table.store(nullptr, std::memory_order_release);
+		table->retired_next = retired_method_tables;
+		retired_method_tables = table;
+	}
+}
+
+MethodBind *ClassDB::get_method_cached(const StringName &p_class, const StringName &p_name, MethodCallCache *r_cache) {
+	const MethodTableEntry *cached = static_cast<const MethodTableEntry *>(r_cache->entry.load(std::memory_order_acquire));
+	if (cached && cached->generation == method_table_generation.get() && cached->class_name == p_class && cached->name == p_name) {
+		return cached->method;
+	}
+
+	if (!method_tables_enabled.is_set()) {
+		return _get_method_locked(p_class, p_name);
+	}
+
+	bool invalidated;
+	const MethodTableEntry *entry = _get_method_entry(p_class, p_name, invalidated);
+	if (invalidated) {
+		return _get_method_locked(p_class, p_name);
+	}
+	if (!entry) {
+		return nullptr;
+	}
+	r_cache->entry.store(entry, std::memory_order_release);
+	return entry->method;
+}
+
+MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
+	if (method_tables_enabled.is_set()) {
+		bool invalidated;
+		const MethodTableEntry *entry = _get_method_entry(p_class, p_name, invalidated);
+		if (!invalidated) {
+			return entry ? entry->method : nullptr;
+		}
+	}
+
+	return _get_method_locked(p_class, p_name);
+}
+
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
 	OBJTYPE_WLOCK;
 
@@ -1223,6 +1412,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 #endif
 
 	type->method_map[mdname] = p_bind;
+	_invalidate_method_tables();
 
 	Vector<Variant> defvals;
 
@@ -1407,6 +1597,15 @@ void ClassDB::cleanup_defaults() {
 void ClassDB::cleanup() {
 	//OBJTYPE_LOCK; hah not here
 
+	method_tables_enabled.clear();
+	_invalidate_method_tables();
+	while (retired_method_tables) {
+		MethodTable *table = retired_method_tables;
+		retired_method_tables = table->retired_next;
+		memdelete_arr(table->entries);
+		memdelete(table);
+	}
+
 	const StringName *k = nullptr;
 
 	while ((k = classes.next(k))) {
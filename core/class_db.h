@@ -33,6 +33,7 @@
 
 #include "core/method_bind.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/print_string.h"
 
 /**	To bind more then 6 parameters include this:
@@ -159,6 +160,42 @@ public:
 	static Set<StringName> default_values_cached;
 
 private:
+	// Once all APIs are registered, get_method() resolves through one open addressing table keyed by
+	// (class, method), without taking the lock. Each class is flattened into it on first lookup, with
+	// inherited methods copied in, and a marker entry with an empty method name. Slots are published by
+	// storing their hash last. Growing or invalidating the table retires it instead of freeing it, so
+	// readers and call site caches never see freed entries; retired tables are freed in cleanup().
+	// Entries remember the generation they were inserted in, so a cached entry from an invalidated
+	// table misses.
+	struct MethodTableEntry {
+		std::atomic<uint32_t> hash = { 0 };
+		uint32_t generation = 0;
+		StringName class_name;
+		StringName name;
+		MethodBind *method = nullptr;
+	};
+
+	struct MethodTable {
+		uint32_t mask = 0;
+		uint32_t count = 0;
+		MethodTableEntry *entries = nullptr;
+		MethodTable *retired_next = nullptr;
+	};
+
+	static SafeFlag method_tables_enabled;
+	static std::atomic<MethodTable *> method_table;
+	static MethodTable *retired_method_tables;
+	static SafeNumeric<uint32_t> method_table_generation;
+	static Mutex method_table_mutex;
+
+	static uint32_t _method_table_hash(const StringName &p_class, const StringName &p_name);
+	static const MethodTableEntry *_method_table_find(const MethodTable *p_table, uint32_t p_hash, const StringName &p_class, const StringName &p_name);
+	static void _method_table_insert(MethodTable *p_table, uint32_t p_hash, uint32_t p_generation, const StringName &p_class, const StringName &p_name, MethodBind *p_method);
+	static bool _flatten_method_table(const StringName &p_class);
+	static const MethodTableEntry *_get_method_entry(const StringName &p_class, const StringName &p_name, bool &r_invalidated);
+	static MethodBind *_get_method_locked(const StringName &p_class, const StringName &p_name);
+	static void _invalidate_method_tables();
+
 	// Non-locking variants of get_parent_class and is_parent_class.
 	static StringName _get_parent_class(const StringName &p_class);
 	static bool _is_parent_class(const StringName &p_class, const StringName &p_inherits);
@@ -318,6 +355,7 @@ public:
 			ERR_FAIL_V_MSG(nullptr, "Method already bound: " + instance_type + "::" + p_name + ".");
 		}
 		type->method_map[p_name] = bind;
+		_invalidate_method_tables();
 #ifdef DEBUG_METHODS_ENABLED
 		// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 		//bind->set_return_type("Variant");
@@ -349,6 +387,9 @@ public:
 
 	static void get_method_list(StringName p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false, bool p_exclude_from_properties = false);
 	static MethodBind *get_method(StringName p_class, StringName p_name);
+	// Like get_method(), but remembers the result in r_cache, so a call site that keeps seeing the same
+	// class and method skips the lookup.
+	static MethodBind *get_method_cached(const StringName &p_class, const StringName &p_name, MethodCallCache *r_cache);
 
 	static void add_virtual_method(const StringName &p_class, const MethodInfo &p_method, bool p_virtual = true);
 	static void get_virtual_methods(const StringName &p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false);
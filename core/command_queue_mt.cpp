@@ -33,12 +33,20 @@
 #include "core/os/os.h"
 #include "core/project_settings.h"
 
-void CommandQueueMT::lock() {
-	mutex.lock();
-}
+#include <thread>
+
+thread_local CommandQueueMT::StagingSlot CommandQueueMT::thread_staging[CommandQueueMT::STAGING_SLOTS];
+CommandQueueMT *CommandQueueMT::first_queue = nullptr;
+uint64_t CommandQueueMT::last_serial = 0;
+BinaryMutex CommandQueueMT::queues_mutex;
 
-void CommandQueueMT::unlock() {
-	mutex.unlock();
+bool CommandQueueMT::_is_live(const CommandQueueMT *p_queue, uint64_t p_serial) {
+	for (CommandQueueMT *queue = first_queue; queue; queue = queue->next_queue) {
+		if (queue == p_queue) {
+			return queue->serial == p_serial;
+		}
+	}
+	return false;
 }
 
 void CommandQueueMT::wait_for_flush() {
@@ -47,76 +55,267 @@ void CommandQueueMT::wait_for_flush() {
 }
 
 CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
-	int idx = -1;
-
 	while (true) {
-		lock();
 		for (int i = 0; i < SYNC_SEMAPHORES; i++) {
-			if (!sync_sems[i].in_use) {
-				sync_sems[i].in_use = true;
-				idx = i;
-				break;
+			if (!sync_sems[i].in_use.load(std::memory_order_relaxed) && !sync_sems[i].in_use.exchange(true, std::memory_order_acquire)) {
+				return &sync_sems[i];
 			}
 		}
-		unlock();
 
-		if (idx == -1) {
-			wait_for_flush();
-		} else {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		wait_for_flush();
+		stall_count.increment();
+		stall_usec.add(OS::get_singleton()->get_ticks_usec() - from);
+	}
+}
+
+CommandQueueMT::Block *&CommandQueueMT::_claim_staging_slot() {
+	StagingSlot *claimed = nullptr;
+
+	MutexLock lock(queues_mutex);
+
+	// Prefer an empty slot, or one left behind by a queue that no longer exists.
+	for (int i = 0; i < STAGING_SLOTS; i++) {
+		StagingSlot &slot = thread_staging[i];
+		if (!slot.queue || !_is_live(slot.queue, slot.serial)) {
+			claimed = &slot;
 			break;
 		}
 	}
 
-	return &sync_sems[idx];
+	if (!claimed) {
+		// This thread pushes to more queues than there are slots, give up the oldest one.
+		claimed = &thread_staging[0];
+		if (claimed->block) {
+			claimed->queue->_retire_block(claimed->block);
+		}
+		for (int i = 1; i < STAGING_SLOTS; i++) {
+			thread_staging[i - 1] = thread_staging[i];
+		}
+		claimed = &thread_staging[STAGING_SLOTS - 1];
+	}
+
+	claimed->queue = this;
+	claimed->serial = serial;
+	claimed->block = nullptr;
+	return claimed->block;
 }
 
-bool CommandQueueMT::dealloc_one() {
-tryagain:
-	if (dealloc_ptr == (write_ptr_and_epoch >> 1)) {
-		// The queue is empty
-		return false;
+void CommandQueueMT::_replace_staging_block(Block *&r_block, uint32_t p_size) {
+	if (r_block) {
+		_retire_block(r_block);
+		r_block = nullptr;
 	}
 
-	uint32_t size = *(uint32_t *)&command_mem[dealloc_ptr];
+	// A staged block can't be flushed before it fills up, so however many threads push, staged blocks share
+	// half of the budget, leaving the rest to the blocks waiting for the consumer. Past that, threads get
+	// minimum sized blocks. Producers racing here may overshoot a little, which only makes the next blocks smaller.
+	uint64_t staged = staged_memory.get();
+	uint32_t staging_budget = command_mem_size / 2;
+	uint32_t size = staged < staging_budget ? MIN(block_size, (uint32_t)(staging_budget - staged)) : 0;
+	size = MAX(size, (uint32_t)MIN_BLOCK_SIZE);
+	size = MAX(size, (uint32_t)(sizeof(Block) + p_size + sizeof(CommandNode)));
 
-	if (size == 0) {
-		// End of command buffer wrap down
-		dealloc_ptr = 0;
-		goto tryagain;
+	// Wait for the consumer to make room, unless it has nothing left to run.
+	if (memory_used.get() + size > command_mem_size && pushed.get() != flushed.load(std::memory_order_relaxed)) {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		do {
+			if (sync && consumer_waiting.load() && consumer_waiting.exchange(false)) {
+				sync->post();
+			}
+			wait_for_flush();
+		} while (memory_used.get() + size > command_mem_size && pushed.get() != flushed.load(std::memory_order_relaxed));
+		stall_count.increment();
+		stall_usec.add(OS::get_singleton()->get_ticks_usec() - from);
 	}
 
-	if (size & 1) {
-		// Still used, nothing can be deallocated
-		return false;
+	Block *block = (Block *)memalloc(size);
+	block->size = size;
+	block->used = 0;
+	block->capacity = size - sizeof(Block) - sizeof(CommandNode);
+	block->prev = nullptr;
+
+	{
+		MutexLock lock(blocks_mutex);
+		block->next = blocks;
+		if (blocks) {
+			blocks->prev = block;
+		}
+		blocks = block;
 	}
+	memory_used.add(size);
+	staged_memory.add(size);
 
-	dealloc_ptr += (size >> 1) + 8;
-	return true;
+	r_block = block;
+}
+
+void CommandQueueMT::_retire_block(Block *p_block) {
+	staged_memory.sub(p_block->size);
+
+	// The capacity of the block leaves room for this node.
+	CommandNode *node = reinterpret_cast<CommandNode *>(&p_block->get_data()[p_block->used]);
+	node->retired_block = p_block;
+	_push_node(node);
+}
+
+void CommandQueueMT::_free_block(Block *p_block) {
+	{
+		MutexLock lock(blocks_mutex);
+		if (p_block->prev) {
+			p_block->prev->next = p_block->next;
+		} else {
+			blocks = p_block->next;
+		}
+		if (p_block->next) {
+			p_block->next->prev = p_block->prev;
+		}
+	}
+	memory_used.sub(p_block->size);
+	memfree(p_block);
+}
+
+void CommandQueueMT::wait_and_flush_one() {
+	ERR_FAIL_COND(!sync);
+
+	bool busy;
+	while (true) {
+		if (flush_one(busy)) {
+			return;
+		}
+		if (busy) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Tell the producers to wake us, and check again in case a command came in meanwhile.
+		consumer_waiting.store(true);
+		if (flush_one(busy)) {
+			consumer_waiting.store(false);
+			return;
+		}
+		if (busy) {
+			consumer_waiting.store(false);
+			std::this_thread::yield();
+			continue;
+		}
+
+		sync->wait();
+	}
+}
+
+void CommandQueueMT::flush_all() {
+	bool busy;
+	while (true) {
+		if (!flush_one(busy)) {
+			if (!busy) {
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+}
+
+CommandQueueMT::Stats CommandQueueMT::get_stats() const {
+	Stats stats;
+	stats.flushed = flushed.load(std::memory_order_relaxed);
+	stats.pushed = MAX(pushed.get(), stats.flushed);
+	stats.depth = stats.pushed - stats.flushed;
+	stats.max_depth = max_depth.load(std::memory_order_relaxed);
+	stats.memory_used = memory_used.get();
+	stats.stall_count = stall_count.get();
+	stats.stall_usec = stall_usec.get();
+	return stats;
+}
+
+CommandQueueMT::Stats CommandQueueMT::get_global_stats() {
+	Stats total;
+
+	MutexLock lock(queues_mutex);
+	for (CommandQueueMT *queue = first_queue; queue; queue = queue->next_queue) {
+		Stats stats = queue->get_stats();
+		total.pushed += stats.pushed;
+		total.flushed += stats.flushed;
+		total.depth += stats.depth;
+		total.max_depth = MAX(total.max_depth, stats.max_depth);
+		total.memory_used += stats.memory_used;
+		total.stall_count += stats.stall_count;
+		total.stall_usec += stats.stall_usec;
+	}
+	return total;
+}
+
+void CommandQueueMT::release_thread_staging() {
+	MutexLock lock(queues_mutex);
+	for (int i = 0; i < STAGING_SLOTS; i++) {
+		StagingSlot &slot = thread_staging[i];
+		if (!slot.block) {
+			slot.queue = nullptr;
+			continue;
+		}
+
+		if (_is_live(slot.queue, slot.serial)) {
+			slot.queue->_retire_block(slot.block);
+		}
+		slot.queue = nullptr;
+		slot.block = nullptr;
+	}
 }
 
 CommandQueueMT::CommandQueueMT(bool p_sync) {
-	read_ptr_and_epoch = 0;
-	write_ptr_and_epoch = 0;
-	dealloc_ptr = 0;
+	stub.next.store(nullptr);
+	stub.retired_block = nullptr;
+	head.store(&stub);
+	tail = &stub;
+	consumer_waiting.store(false);
+	flushed.store(0);
+	max_depth.store(0);
+	blocks = nullptr;
 
 	command_mem_size = GLOBAL_DEF_RST("memory/limits/command_queue/multithreading_queue_size_kb", DEFAULT_COMMAND_MEM_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/command_queue/multithreading_queue_size_kb", PropertyInfo(Variant::INT, "memory/limits/command_queue/multithreading_queue_size_kb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"));
 	command_mem_size *= 1024;
-	command_mem = (uint8_t *)memalloc(command_mem_size);
+	block_size = CLAMP(command_mem_size / 4, (uint32_t)MIN_BLOCK_SIZE, (uint32_t)MAX_BLOCK_SIZE);
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
-		sync_sems[i].in_use = false;
+		sync_sems[i].in_use.store(false);
 	}
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	} else {
 		sync = nullptr;
 	}
+
+	MutexLock lock(queues_mutex);
+	serial = ++last_serial;
+	prev_queue = nullptr;
+	next_queue = first_queue;
+	if (first_queue) {
+		first_queue->prev_queue = this;
+	}
+	first_queue = this;
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	{
+		MutexLock lock(queues_mutex);
+		if (prev_queue) {
+			prev_queue->next_queue = next_queue;
+		} else {
+			first_queue = next_queue;
+		}
+		if (next_queue) {
+			next_queue->prev_queue = prev_queue;
+		}
+	}
+
 	if (sync) {
 		memdelete(sync);
 	}
-	memfree(command_mem);
+
+	// Staging slots still pointing at these blocks no longer match a live queue, and are never used again.
+	while (blocks) {
+		Block *next = blocks->next;
+		memfree(blocks);
+		blocks = next;
+	}
 }
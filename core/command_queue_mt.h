@@ -34,9 +34,12 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/safe_refcount.h"
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -228,13 +231,11 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                          \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync)                                                            \
-			sync->post();                                                    \
+		publish(cmd);                                                        \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -243,17 +244,15 @@
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
-		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
+		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync)                                                                              \
-			sync->post();                                                                      \
+		publish(cmd);                                                                          \
 		ss->sem.wait();                                                                        \
-		ss->in_use = false;                                                                    \
+		ss->in_use.store(false, std::memory_order_release);                                    \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -262,24 +261,29 @@
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
-		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
+		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync)                                                                     \
-			sync->post();                                                             \
+		publish(cmd);                                                                 \
 		ss->sem.wait();                                                               \
-		ss->in_use = false;                                                           \
+		ss->in_use.store(false, std::memory_order_release);                           \
 	}
 
 #define MAX_CMD_PARAMS 13
 
+// Multiple producer, single consumer command queue.
+//
+// Any thread can push commands without taking a lock. Each producer thread writes its commands into
+// its own staging block, and links them into an intrusive lock-free list (Dmitry Vyukov's MPSC queue)
+// which the consumer thread drains. A full block is retired by pushing a marker through the same list,
+// so the consumer frees it once it has run every command written into it, and the producers never
+// touch the consumer's side of the queue.
 class CommandQueueMT {
 	struct SyncSemaphore {
 		Semaphore sem;
-		bool in_use;
+		std::atomic<bool> in_use;
 	};
 
 	struct CommandBase {
@@ -311,155 +315,204 @@ class CommandQueueMT {
 
 	enum {
 		DEFAULT_COMMAND_MEM_SIZE_KB = 256,
-		SYNC_SEMAPHORES = 8
+		SYNC_SEMAPHORES = 8,
+		MIN_BLOCK_SIZE = 4096,
+		MAX_BLOCK_SIZE = 65536,
+		STAGING_SLOTS = 4,
 	};
 
-	uint8_t *command_mem;
-	uint32_t read_ptr_and_epoch;
-	uint32_t write_ptr_and_epoch;
-	uint32_t dealloc_ptr;
-	uint32_t command_mem_size;
+	struct Block;
+
+	// Precedes every command in a block. A node without a command marks the end of a retired block.
+	struct CommandNode {
+		std::atomic<CommandNode *> next;
+		Block *retired_block;
+	};
+
+	struct Block {
+		Block *prev;
+		Block *next;
+		uint32_t size;
+		uint32_t used;
+		uint32_t capacity; // Leaves room for the node retiring the block.
+		uint32_t padding;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return reinterpret_cast<uint8_t *>(this + 1); }
+	};
+
+	// The block each thread is currently writing into, per queue.
+	struct StagingSlot {
+		CommandQueueMT *queue;
+		uint64_t serial;
+		Block *block;
+	};
+
+	static thread_local StagingSlot thread_staging[STAGING_SLOTS];
+
+	// Producers.
+	std::atomic<CommandNode *> head;
+	std::atomic<bool> consumer_waiting;
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
-	Mutex mutex;
+	uint64_t serial;
+	uint32_t command_mem_size;
+	uint32_t block_size;
+
+	// Consumer.
+	CommandNode *tail;
+	CommandNode stub;
+
+	// All the blocks, so they can be freed with the queue. Only locked to create or free a block.
+	BinaryMutex blocks_mutex;
+	Block *blocks;
+
+	SafeNumeric<uint64_t> pushed;
+	std::atomic<uint64_t> flushed;
+	std::atomic<uint64_t> max_depth;
+	SafeNumeric<uint64_t> memory_used;
+	SafeNumeric<uint64_t> staged_memory; // Blocks producers are still writing into.
+	SafeNumeric<uint64_t> stall_count;
+	SafeNumeric<uint64_t> stall_usec;
+
 	Semaphore *sync;
 
-	template <class T>
-	T *allocate() {
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
-
-		// Assert that the buffer is big enough to hold at least two messages.
-		ERR_FAIL_COND_V(alloc_size * 2 + sizeof(uint32_t) > command_mem_size, nullptr);
-
-	tryagain:
-		uint32_t write_ptr = write_ptr_and_epoch >> 1;
-
-		if (write_ptr < dealloc_ptr) {
-			// behind dealloc_ptr, check that there is room
-			if ((dealloc_ptr - write_ptr) <= alloc_size) {
-				// There is no more room, try to deallocate something
-				if (dealloc_one()) {
-					goto tryagain;
-				}
-				return nullptr;
-			}
-		} else {
-			// ahead of dealloc_ptr, check that there is room
-
-			if ((command_mem_size - write_ptr) < alloc_size + sizeof(uint32_t)) {
-				// no room at the end, wrap down;
-
-				if (dealloc_ptr == 0) { // don't want write_ptr to become dealloc_ptr
-
-					// There is no more room, try to deallocate something
-					if (dealloc_one()) {
-						goto tryagain;
-					}
-					return nullptr;
-				}
-
-				// if this happens, it's a bug
-				ERR_FAIL_COND_V((command_mem_size - write_ptr) < 8, nullptr);
-				// zero means, wrap to beginning
-
-				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-				*p = 1;
-				write_ptr_and_epoch = 0 | (1 & ~write_ptr_and_epoch); // Invert epoch.
-				// See if we can get the thread to run and clear up some more space while we wait.
-				// This is required if alloc_size * 2 + 4 > COMMAND_MEM_SIZE
-				if (sync) {
-					sync->post();
-				}
-				goto tryagain;
+	// Live queues, for the statistics and to retire the blocks of exiting threads.
+	CommandQueueMT *prev_queue;
+	CommandQueueMT *next_queue;
+	static CommandQueueMT *first_queue;
+	static uint64_t last_serial;
+	static BinaryMutex queues_mutex;
+
+	_FORCE_INLINE_ Block *&_get_staging_block() {
+		for (int i = 0; i < STAGING_SLOTS; i++) {
+			StagingSlot &slot = thread_staging[i];
+			if (slot.queue == this && slot.serial == serial) {
+				return slot.block;
 			}
 		}
-		// Allocate the size and the 'in use' bit.
-		// First bit used to mark if command is still in use (1)
-		// or if it has been destroyed and can be deallocated (0).
-		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
-		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-		*p = (size << 1) | 1;
-		write_ptr += 8;
-		// allocate the command
-		T *cmd = memnew_placement(&command_mem[write_ptr], T);
-		write_ptr += size;
-		write_ptr_and_epoch = (write_ptr << 1) | (write_ptr_and_epoch & 1);
-		return cmd;
+		return _claim_staging_slot();
 	}
 
 	template <class T>
-	T *allocate_and_lock() {
-		lock();
-		T *ret;
-
-		while ((ret = allocate<T>()) == nullptr) {
-			unlock();
-			// sleep a little until fetch happened and some room is made
-			wait_for_flush();
-			lock();
+	T *allocate() {
+		const uint32_t size = sizeof(CommandNode) + ((sizeof(T) + 8 - 1) & ~(8 - 1));
+
+		Block *&block = _get_staging_block();
+		if (unlikely(!block || block->used + size > block->capacity)) {
+			_replace_staging_block(block, size);
 		}
 
-		return ret;
+		CommandNode *node = reinterpret_cast<CommandNode *>(&block->get_data()[block->used]);
+		node->retired_block = nullptr;
+		block->used += size;
+
+		return memnew_placement(node + 1, T);
 	}
 
-	bool flush_one(bool p_lock = true) {
-		if (p_lock) {
-			lock();
+	template <class T>
+	void publish(T *p_command) {
+		_push_node(reinterpret_cast<CommandNode *>(p_command) - 1);
+		pushed.increment();
+
+		// Only the consumer waiting for commands needs waking, and only once.
+		if (sync && consumer_waiting.load() && consumer_waiting.exchange(false)) {
+			sync->post();
 		}
-	tryagain:
+	}
+
+	_FORCE_INLINE_ void _push_node(CommandNode *p_node) {
+		p_node->next.store(nullptr, std::memory_order_relaxed);
+		CommandNode *prev = head.exchange(p_node);
+		prev->next.store(p_node, std::memory_order_release);
+	}
+
+	// Returns nullptr if there is nothing to pop. r_busy is set if that is only because a producer
+	// is halfway through linking a command, which is then available almost immediately.
+	CommandNode *_pop_node(bool &r_busy) {
+		r_busy = false;
 
-		// tried to read an empty queue
-		if (read_ptr_and_epoch == write_ptr_and_epoch) {
-			if (p_lock) {
-				unlock();
+		CommandNode *node = tail;
+		CommandNode *next = node->next.load(std::memory_order_acquire);
+		if (node == &stub) {
+			if (!next) {
+				r_busy = head.load() != &stub;
+				return nullptr;
 			}
-			return false;
+			tail = next;
+			node = next;
+			next = next->next.load(std::memory_order_acquire);
 		}
 
-		uint32_t read_ptr = read_ptr_and_epoch >> 1;
-		uint32_t size_ptr = read_ptr;
-		uint32_t size = *(uint32_t *)&command_mem[read_ptr] >> 1;
+		if (next) {
+			tail = next;
+			return node;
+		}
 
-		if (size == 0) {
-			*(uint32_t *)&command_mem[read_ptr] = 0; // clear in-use bit.
-			//end of ringbuffer, wrap
-			read_ptr_and_epoch = 0 | (1 & ~read_ptr_and_epoch); // Invert epoch.
-			goto tryagain;
+		if (node != head.load()) {
+			r_busy = true;
+			return nullptr;
 		}
 
-		read_ptr += 8;
+		// The node is the last one, put the stub back behind it so it can be popped.
+		_push_node(&stub);
+		next = node->next.load(std::memory_order_acquire);
+		if (next) {
+			tail = next;
+			return node;
+		}
 
-		CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+		r_busy = true;
+		return nullptr;
+	}
 
-		read_ptr += size;
+	bool flush_one(bool &r_busy) {
+		while (true) {
+			CommandNode *node = _pop_node(r_busy);
+			if (!node) {
+				return false;
+			}
 
-		read_ptr_and_epoch = (read_ptr << 1) | (read_ptr_and_epoch & 1);
+			if (node->retired_block) {
+				_free_block(node->retired_block);
+				continue;
+			}
 
-		if (p_lock) {
-			unlock();
-		}
-		cmd->call();
-		if (p_lock) {
-			lock();
-		}
+			// The producer counts the command just after linking it, so it may not be counted yet.
+			uint64_t done = flushed.load(std::memory_order_relaxed);
+			uint64_t count = pushed.get();
+			if (count > done && count - done > max_depth.load(std::memory_order_relaxed)) {
+				max_depth.store(count - done, std::memory_order_relaxed);
+			}
 
-		cmd->post();
-		cmd->~CommandBase();
-		*(uint32_t *)&command_mem[size_ptr] &= ~1;
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(node + 1);
+			cmd->call();
+			cmd->post();
+			cmd->~CommandBase();
 
-		if (p_lock) {
-			unlock();
+			flushed.store(done + 1, std::memory_order_relaxed);
+			return true;
 		}
-		return true;
 	}
 
-	void lock();
-	void unlock();
+	static bool _is_live(const CommandQueueMT *p_queue, uint64_t p_serial);
+
 	void wait_for_flush();
 	SyncSemaphore *_alloc_sync_sem();
-	bool dealloc_one();
+	Block *&_claim_staging_slot();
+	void _replace_staging_block(Block *&r_block, uint32_t p_size);
+	void _retire_block(Block *p_block);
+	void _free_block(Block *p_block);
 
 public:
+	struct Stats {
+		uint64_t pushed = 0;
+		uint64_t flushed = 0;
+		uint64_t depth = 0;
+		uint64_t max_depth = 0;
+		uint64_t memory_used = 0;
+		uint64_t stall_count = 0;
+		uint64_t stall_usec = 0;
+	};
+
 	/* NORMAL PUSH COMMANDS */
 	DECL_PUSH(0)
 	SPACE_SEP_LIST(DECL_PUSH, 13)
@@ -472,20 +525,14 @@ public:
 	DECL_PUSH_AND_SYNC(0)
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 13)
 
-	void wait_and_flush_one() {
-		ERR_FAIL_COND(!sync);
-		sync->wait();
-		flush_one();
-	}
+	void wait_and_flush_one();
+	void flush_all();
 
-	void flush_all() {
-		//ERR_FAIL_COND(sync);
-		lock();
-		while (flush_one(false)) {
-			;
-		}
-		unlock();
-	}
+	Stats get_stats() const;
+	static Stats get_global_stats();
+
+	// Retires the staging blocks of the calling thread, call before it exits.
+	static void release_thread_staging();
 
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
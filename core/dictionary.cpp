@@ -30,81 +30,360 @@
 
 #include "dictionary.h"
 
-#include "core/ordered_hash_map.h"
+#include "core/hashfuncs.h"
 #include "core/safe_refcount.h"
 #include "core/variant.h"
 
+// Entries are kept in insertion order, in a chain of blocks that are never reallocated, so pointers
+// returned by operator[], getptr() and next() stay valid while the dictionary grows. Each block is
+// as large as all the blocks before it together, so a dictionary with n entries has O(log n) blocks.
+// Lookups go through an open addressing index of entry pointers; dictionaries with few entries don't
+// have one and are scanned instead. Erasing leaves a hole in its block, which iteration skips; once
+// holes outnumber the entries, the chain is compacted.
 struct DictionaryPrivate {
+	enum {
+		FIRST_BLOCK_CAPACITY = 8,
+		SCAN_MAX = 8, // Up to this many entries, holes included, are scanned without an index.
+	};
+
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash;
+		bool erased;
+	};
+
+	struct Block {
+		Block *next;
+		uint32_t capacity;
+		uint32_t used;
+
+		_FORCE_INLINE_ Entry *entries() {
+			return reinterpret_cast<Entry *>(this + 1);
+		}
+	};
+
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
-};
+	Block *first;
+	Block *last;
+	uint32_t count; // Entries, holes not included.
+	uint32_t erased_count;
+	Entry **index;
+	uint32_t index_mask;
+
+	_FORCE_INLINE_ uint32_t _total() const {
+		return count + erased_count;
+	}
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.empty()) {
-		return;
+	Entry *find(const Variant &p_key) const {
+		uint32_t hash = VariantHasher::hash(p_key);
+
+		if (!index) {
+			for (Block *block = first; block; block = block->next) {
+				Entry *entries = block->entries();
+				for (uint32_t i = 0; i < block->used; i++) {
+					if (entries[i].hash == hash && !entries[i].erased && VariantComparator::compare(entries[i].key, p_key)) {
+						return &entries[i];
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		uint32_t pos = hash & index_mask;
+		while (Entry *entry = index[pos]) {
+			if (entry->hash == hash && !entry->erased && VariantComparator::compare(entry->key, p_key)) {
+				return entry;
+			}
+			pos = (pos + 1) & index_mask;
+		}
+		return nullptr;
 	}
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	void _index_insert(Entry *p_entry) {
+		uint32_t pos = p_entry->hash & index_mask;
+		while (index[pos]) {
+			pos = (pos + 1) & index_mask;
+		}
+		index[pos] = p_entry;
 	}
-}
 
-Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
+	// Rebuilds the index with room for at least p_entries entries; holes are left out.
+	void _rebuild_index(uint32_t p_entries) {
+		uint32_t capacity = SCAN_MAX * 4;
+		while (capacity < p_entries * 2) {
+			capacity <<= 1;
+		}
+		if (index) {
+			memfree(index);
+		}
+		index = (Entry **)memalloc(sizeof(Entry *) * capacity);
+		memset(index, 0, sizeof(Entry *) * capacity);
+		index_mask = capacity - 1;
+
+		for (Block *block = first; block; block = block->next) {
+			Entry *entries = block->entries();
+			for (uint32_t i = 0; i < block->used; i++) {
+				if (!entries[i].erased) {
+					_index_insert(&entries[i]);
+				}
+			}
 		}
-		index++;
 	}
 
-	return Variant();
-}
+	static Block *_alloc_block(uint32_t p_capacity) {
+		Block *block = (Block *)memalloc(sizeof(Block) + sizeof(Entry) * p_capacity);
+		block->next = nullptr;
+		block->capacity = p_capacity;
+		block->used = 0;
+		return block;
+	}
 
-Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
+	static void _free_blocks(Block *p_block) {
+		while (p_block) {
+			Block *next = p_block->next;
+			Entry *entries = p_block->entries();
+			for (uint32_t i = 0; i < p_block->used; i++) {
+				entries[i].~Entry();
+			}
+			memfree(p_block);
+			p_block = next;
+		}
+	}
+
+	Entry *insert(const Variant &p_key, const Variant &p_value) {
+		if (!last || last->used == last->capacity) {
+			Block *block = _alloc_block(last ? MAX((uint32_t)FIRST_BLOCK_CAPACITY, _total()) : (uint32_t)FIRST_BLOCK_CAPACITY);
+			if (last) {
+				last->next = block;
+			} else {
+				first = block;
+			}
+			last = block;
+		}
+
+		Entry *entry = memnew_placement(&last->entries()[last->used], Entry);
+		last->used++;
+		entry->key = p_key;
+		entry->value = p_value;
+		entry->hash = VariantHasher::hash(p_key);
+		entry->erased = false;
+		count++;
+
+		if (index) {
+			if (_total() * 2 > index_mask + 1) {
+				_rebuild_index(_total());
+			} else {
+				_index_insert(entry);
+			}
+		} else if (_total() > SCAN_MAX) {
+			_rebuild_index(_total());
+		}
+		return entry;
+	}
+
+	bool erase(const Variant &p_key) {
+		Entry *entry = find(p_key);
+		if (!entry) {
+			return false;
+		}
+
+		// The index keeps pointing to the hole, so probing goes on past it.
+		entry->erased = true;
+		entry->key = Variant();
+		entry->value = Variant();
+		count--;
+		erased_count++;
+
+		if (count == 0) {
+			clear();
+		} else if (erased_count > count && _total() > SCAN_MAX) {
+			_compact();
+		}
+		return true;
+	}
+
+	// Moves the entries into one block, without holes.
+	void _compact() {
+		uint32_t capacity = FIRST_BLOCK_CAPACITY;
+		while (capacity < count) {
+			capacity <<= 1;
+		}
+		Block *block = _alloc_block(capacity);
+		Entry *to = block->entries();
+		for (Block *from = first; from; from = from->next) {
+			Entry *entries = from->entries();
+			for (uint32_t i = 0; i < from->used; i++) {
+				if (!entries[i].erased) {
+					memnew_placement(&to[block->used], Entry(entries[i]));
+					block->used++;
+				}
+			}
+		}
+		_free_blocks(first);
+		first = block;
+		last = block;
+		erased_count = 0;
+
+		if (count > SCAN_MAX) {
+			_rebuild_index(count);
+		} else if (index) {
+			memfree(index);
+			index = nullptr;
+			index_mask = 0;
+		}
+	}
+
+	void clear() {
+		_free_blocks(first);
+		first = nullptr;
+		last = nullptr;
+		count = 0;
+		erased_count = 0;
+		if (index) {
+			memfree(index);
+			index = nullptr;
+			index_mask = 0;
 		}
-		index++;
 	}
 
-	return Variant();
+	// The entry after p_entry, or the first one, skipping holes.
+	Entry *next_entry(const Entry *p_entry) const {
+		Block *block = first;
+		uint32_t i = 0;
+		if (p_entry) {
+			// The last block holds at least half of the entries.
+			if (last && p_entry >= last->entries() && p_entry < last->entries() + last->used) {
+				block = last;
+			}
+			while (block && (p_entry < block->entries() || p_entry >= block->entries() + block->used)) {
+				block = block->next;
+			}
+			if (!block) {
+				return nullptr;
+			}
+			size_t offset = (const char *)p_entry - (const char *)block->entries();
+			if (offset % sizeof(Entry)) {
+				return nullptr; // Points inside an entry, not at one.
+			}
+			i = offset / sizeof(Entry) + 1;
+		}
+
+		for (; block; block = block->next, i = 0) {
+			Entry *entries = block->entries();
+			for (; i < block->used; i++) {
+				if (!entries[i].erased) {
+					return &entries[i];
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	Entry *entry_at(int p_index) const {
+		if (p_index < 0 || (uint32_t)p_index >= count) {
+			return nullptr;
+		}
+		uint32_t remaining = p_index;
+		for (Block *block = first; block; block = block->next) {
+			Entry *entries = block->entries();
+			if (erased_count == 0) {
+				// No holes, so the block can be skipped as a whole.
+				if (remaining < block->used) {
+					return &entries[remaining];
+				}
+				remaining -= block->used;
+				continue;
+			}
+			for (uint32_t i = 0; i < block->used; i++) {
+				if (!entries[i].erased) {
+					if (remaining == 0) {
+						return &entries[i];
+					}
+					remaining--;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	DictionaryPrivate() {
+		first = nullptr;
+		last = nullptr;
+		count = 0;
+		erased_count = 0;
+		index = nullptr;
+		index_mask = 0;
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
+};
+
+#define FOREACH_ENTRY(m_entry) for (DictionaryPrivate::Entry *m_entry = _p->next_entry(nullptr); m_entry; m_entry = _p->next_entry(m_entry))
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	FOREACH_ENTRY(E) {
+		p_keys->push_back(E->key);
+	}
+}
+
+Variant Dictionary::get_key_at_index(int p_index) const {
+	DictionaryPrivate::Entry *E = _p->entry_at(p_index);
+	if (!E) {
+		return Variant();
+	}
+	return E->key;
+}
+
+Variant Dictionary::get_value_at_index(int p_index) const {
+	DictionaryPrivate::Entry *E = _p->entry_at(p_index);
+	if (!E) {
+		return Variant();
+	}
+	return E->value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
-	return _p->variant_map[p_key];
+	DictionaryPrivate::Entry *E = _p->find(p_key);
+	if (!E) {
+		// consistent with Map behaviour
+		E = _p->insert(p_key, Variant());
+	}
+	return E->value;
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
-	return _p->variant_map[p_key];
+	DictionaryPrivate::Entry *E = _p->find(p_key);
+	CRASH_COND(!E);
+	return E->value;
 }
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryPrivate::Entry *E = _p->find(p_key);
 
 	if (!E) {
 		return nullptr;
 	}
-	return &E.get();
+	return &E->value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
+	DictionaryPrivate::Entry *E = _p->find(p_key);
 
 	if (!E) {
 		return nullptr;
 	}
-	return &E.get();
+	return &E->value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryPrivate::Entry *E = _p->find(p_key);
 
 	if (!E) {
 		return Variant();
 	}
-	return E.get();
+	return E->value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -117,14 +396,14 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->count;
 }
 bool Dictionary::empty() const {
-	return !_p->variant_map.size();
+	return !_p->count;
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != nullptr;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -137,7 +416,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 bool Dictionary::erase(const Variant &p_key) {
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -166,7 +445,7 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 }
 
 void Dictionary::clear() {
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::_unref() const {
@@ -179,9 +458,9 @@ void Dictionary::_unref() const {
 uint32_t Dictionary::hash() const {
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_djb2_one_32(E.key().hash(), h);
-		h = hash_djb2_one_32(E.value().hash(), h);
+	FOREACH_ENTRY(E) {
+		h = hash_djb2_one_32(E->key.hash(), h);
+		h = hash_djb2_one_32(E->value.hash(), h);
 	}
 
 	return h;
@@ -189,15 +468,15 @@ uint32_t Dictionary::hash() const {
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (empty()) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
+	FOREACH_ENTRY(E) {
+		varr[i] = E->key;
 		i++;
 	}
 
@@ -206,15 +485,15 @@ Array Dictionary::keys() const {
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (empty()) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
+	FOREACH_ENTRY(E) {
+		varr[i] = E->value;
 		i++;
 	}
 
@@ -224,24 +503,25 @@ Array Dictionary::values() const {
 const Variant *Dictionary::next(const Variant *p_key) const {
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.front()) {
-			return &_p->variant_map.front().key();
-		}
-		return nullptr;
+		DictionaryPrivate::Entry *E = _p->next_entry(nullptr);
+		return E ? &E->key : nullptr;
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next()) {
-		return &E.next().key();
+	// Keys handed out by next() point into an entry, so no lookup is needed for them.
+	const DictionaryPrivate::Entry *from = reinterpret_cast<const DictionaryPrivate::Entry *>(p_key);
+	DictionaryPrivate::Entry *E = _p->next_entry(from);
+	if (!E) {
+		from = _p->find(*p_key);
+		E = from ? _p->next_entry(from) : nullptr;
 	}
-	return nullptr;
+	return E ? &E->key : nullptr;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 	Dictionary n;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
+	FOREACH_ENTRY(E) {
+		n._p->insert(E->key, p_deep ? E->value.duplicate(true) : E->value);
 	}
 
 	return n;
@@ -252,7 +532,7 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 }
 
 const void *Dictionary::id() const {
-	return _p->variant_map.id();
+	return _p;
 }
 
 Dictionary::Dictionary(const Dictionary &p_from) {
@@ -105,7 +105,23 @@ PackedData::PackedData() {
 	root->parent = nullptr;
 	disabled = false;
 
-	add_pack_source(memnew(PackedSourcePCK));
+	pck_source = memnew(PackedSourcePCK);
+	add_pack_source(pck_source);
+}
+
+void PackedData::set_use_mmap(bool p_enable) {
+	ERR_FAIL_COND_MSG(!files.empty(), "Pack memory mapping must be set before any pack is loaded.");
+
+	int idx = sources.find(pck_source);
+	ERR_FAIL_COND(idx == -1);
+
+	memdelete(pck_source);
+	if (p_enable) {
+		pck_source = memnew(PackedSourcePCKMapped);
+	} else {
+		pck_source = memnew(PackedSourcePCK);
+	}
+	sources.write[idx] = pck_source;
 }
 
 void PackedData::_free_packed_dirs(PackedDir *p_dir) {
@@ -215,16 +231,75 @@ FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFi
 
 //////////////////////////////////////////////////////////////////
 
+bool PackedSourcePCKMapped::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	if (!PackedSourcePCK::try_open_pack(p_path, p_replace_files, p_offset)) {
+		return false;
+	}
+
+	MutexLock lock(packs_mutex);
+	if (packs.has(p_path)) {
+		return true;
+	}
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, true);
+
+	MappedPack mp;
+	mp.f = f;
+	mp.size = f->get_len();
+	mp.data = f->map_read_only();
+	if (!mp.data) {
+		memdelete(f);
+		WARN_PRINT("Can't memory map pack '" + p_path + "', reading it through regular file access.");
+		return true;
+	}
+
+	packs[p_path] = mp;
+	return true;
+}
+
+FileAccess *PackedSourcePCKMapped::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	const uint8_t *data = nullptr;
+	{
+		MutexLock lock(packs_mutex);
+		Map<String, MappedPack>::Element *E = packs.find(p_file->pack);
+		if (E && p_file->offset <= E->get().size && p_file->size <= E->get().size - p_file->offset) {
+			data = E->get().data + p_file->offset;
+		}
+	}
+	// Packs stay mapped until the source is freed, the data outlives the lock.
+	if (!data) {
+		return PackedSourcePCK::get_file(p_path, p_file);
+	}
+
+	return memnew(FileAccessPack(p_path, *p_file, data));
+}
+
+PackedSourcePCKMapped::~PackedSourcePCKMapped() {
+	for (Map<String, MappedPack>::Element *E = packs.front(); E; E = E->next()) {
+		memdelete(E->get().f);
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_V(ERR_UNAVAILABLE);
 	return ERR_UNAVAILABLE;
 }
 
 void FileAccessPack::close() {
+	if (data) {
+		data = nullptr;
+		return;
+	}
 	f->close();
 }
 
 bool FileAccessPack::is_open() const {
+	if (!f) {
+		return data != nullptr;
+	}
 	return f->is_open();
 }
 
@@ -235,7 +310,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (f) {
+		f->seek(pf.offset + p_position);
+	}
 	pos = p_position;
 }
 
@@ -261,6 +338,10 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -278,19 +359,38 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	if (to_read > 0 && data) {
+		memcpy(p_dst, data + pos, to_read);
+	}
+
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (!data) {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::borrow_buffer(uint64_t p_length) const {
+	if (!data || eof || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = data + pos;
+	pos += p_length;
+
+	return ptr;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -316,14 +416,21 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data) :
 		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		f(nullptr),
+		data(p_data) {
+	pos = 0;
+	eof = false;
+
+	if (data) {
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
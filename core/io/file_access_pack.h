@@ -35,6 +35,7 @@
 #include "core/map.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/print_string.h"
 #include "core/set.h"
 
@@ -95,6 +96,7 @@ private:
 	Map<PathMD5, PackedFile> files;
 
 	Vector<PackSource *> sources;
+	PackSource *pck_source;
 
 	PackedDir *root;
 
@@ -107,6 +109,8 @@ public:
 	void add_pack_source(PackSource *p_source);
 	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files); // for PackSource
 
+	void set_use_mmap(bool p_enable); // Must be called before any pack is added.
+
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
@@ -136,6 +140,27 @@ public:
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
 };
 
+// Keeps every pack it opens memory mapped, so files are read straight from
+// the page cache (shared between processes using the same pack) and can be
+// borrowed with FileAccess::borrow_buffer() without copying.
+class PackedSourcePCKMapped : public PackedSourcePCK {
+	struct MappedPack {
+		FileAccess *f;
+		const uint8_t *data;
+		uint64_t size;
+	};
+
+	// Packs can be loaded at runtime while other threads open files.
+	Mutex packs_mutex;
+	Map<String, MappedPack> packs;
+
+public:
+	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	~PackedSourcePCKMapped();
+};
+
 class FileAccessPack : public FileAccess {
 	PackedData::PackedFile pf;
 
@@ -143,6 +168,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 
 	FileAccess *f;
+	const uint8_t *data; // Only set when the pack is memory mapped, f is not used then.
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -162,6 +188,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	virtual const uint8_t *borrow_buffer(uint64_t p_length) const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -174,7 +201,7 @@ public:
 
 	virtual bool file_exists(const String &p_name);
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data = nullptr);
 	~FileAccessPack();
 };
 
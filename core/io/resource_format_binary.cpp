@@ -105,14 +105,19 @@ StringName ResourceInteractiveLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
+		const uint8_t *borrowed = f->borrow_buffer(len);
+		if (borrowed) {
+			s.parse_utf8((const char *)borrowed, len);
+			return s;
+		}
+		if ((int)len > str_buf.size()) {
+			str_buf.resize(len);
+		}
+		f->get_buffer((uint8_t *)&str_buf[0], len);
 		s.parse_utf8(&str_buf[0]);
 		return s;
 	}
@@ -596,13 +601,32 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	int s = stage;
 
+	if (s == 0 && ResourceLoader::is_loading_with_sub_threads()) {
+		// Start loading all the dependencies in parallel, each stage below then only waits for one.
+		for (int i = 0; i < external_resources.size(); i++) {
+			String path = external_resources[i].path;
+
+			if (remaps.has(path)) {
+				path = remaps[path];
+			}
+			external_resources.write[i].threaded = ResourceLoader::load_threaded_request(path, external_resources[i].type, true) == OK;
+		}
+	}
+
 	if (s < external_resources.size()) {
 		String path = external_resources[s].path;
 
 		if (remaps.has(path)) {
 			path = remaps[path];
 		}
-		RES res = ResourceLoader::load(path, external_resources[s].type);
+		RES res;
+		if (external_resources[s].threaded) {
+			// Consumed, whatever happens next.
+			external_resources.write[s].threaded = false;
+			res = ResourceLoader::load_threaded_get(path);
+		} else {
+			res = ResourceLoader::load(path, external_resources[s].type);
+		}
 		if (res.is_null()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
 				ResourceLoader::notify_dependency_error(local_path, path, external_resources[s].type);
@@ -746,14 +770,19 @@ static String get_ustring(FileAccess *f) {
 
 String ResourceInteractiveLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
 	if (len == 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
+	const uint8_t *borrowed = f->borrow_buffer(len);
+	if (borrowed) {
+		s.parse_utf8((const char *)borrowed, len);
+		return s;
+	}
+	if (len > str_buf.size()) {
+		str_buf.resize(len);
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], len);
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -850,6 +879,7 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 
 		er.path = get_unicode_string();
 
+		er.threaded = false;
 		external_resources.push_back(er);
 	}
 
@@ -923,6 +953,18 @@ ResourceInteractiveLoaderBinary::ResourceInteractiveLoaderBinary() :
 }
 
 ResourceInteractiveLoaderBinary::~ResourceInteractiveLoaderBinary() {
+	// Release the threaded dependency loads that weren't retrieved because loading stopped early.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].threaded) {
+			String path = external_resources[i].path;
+
+			if (remaps.has(path)) {
+				path = remaps[path];
+			}
+			ResourceLoader::load_threaded_get(path);
+		}
+	}
+
 	if (f) {
 		memdelete(f);
 	}
@@ -58,6 +58,7 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	struct ExtResource {
 		String path;
 		String type;
+		bool threaded; // Requested with ResourceLoader::load_threaded_request(), not retrieved yet.
 	};
 
 	Vector<ExtResource> external_resources;
@@ -43,6 +43,10 @@ Ref<ResourceFormatLoader> ResourceLoader::loader[ResourceLoader::MAX_LOADERS];
 
 int ResourceLoader::loader_count = 0;
 
+// The threaded load task run by the calling thread, if any.
+static thread_local String current_load_task;
+static thread_local bool current_load_use_sub_threads = false;
+
 Error ResourceInteractiveLoader::wait() {
 	Error err = poll();
 	while (err == OK) {
@@ -335,6 +339,13 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	}
 
 	if (!p_no_cache) {
+		thread_load_mutex.lock();
+		if (thread_load_tasks.has(local_path)) {
+			// Being loaded by a threaded request, share its result instead of loading it twice.
+			return _wait_for_load_task(local_path, false, r_error);
+		}
+		thread_load_mutex.unlock();
+
 		{
 			bool success = _add_to_loading_map(local_path);
 			ERR_FAIL_COND_V_MSG(!success, RES(), "Resource: '" + local_path + "' is already being loaded. Cyclic reference?");
@@ -410,6 +421,295 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	return res;
 }
 
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+	ERR_FAIL_COND_V(p_path.empty(), ERR_INVALID_PARAMETER);
+
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	thread_load_mutex.lock();
+
+	if (current_load_task != String()) {
+		// Requested while loading another resource, count it towards that load's progress.
+		ThreadLoadTask *parent = thread_load_tasks.getptr(current_load_task);
+		if (parent && parent->sub_tasks.find(local_path) == -1) {
+			parent->sub_tasks.push_back(local_path);
+		}
+	}
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (task) {
+		task->requests++;
+		thread_load_mutex.unlock();
+		return OK;
+	}
+
+	ThreadLoadTask new_task;
+	new_task.type_hint = p_type_hint;
+	new_task.use_sub_threads = p_use_sub_threads;
+	new_task.requests = 1;
+	thread_load_tasks[local_path] = new_task;
+
+#ifndef NO_THREADS
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && !thread_load_exit) {
+		// Release the groups of loads that have finished, each one must be waited on once.
+		for (int i = thread_load_groups.size() - 1; i >= 0; i--) {
+			if (pool->is_group_task_completed(thread_load_groups[i])) {
+				pool->wait_for_group_task_completion(thread_load_groups[i]);
+				thread_load_groups.remove(i);
+			}
+		}
+
+		thread_load_queue.push_back(local_path);
+		thread_load_groups.push_back(pool->add_group_task(_thread_load_function, nullptr, 1));
+		thread_load_mutex.unlock();
+		return OK;
+	}
+#endif
+
+	// No worker threads to hand it to. The request waits for it like a load would, so cycles are still detected.
+	if (current_load_task != String()) {
+		thread_load_tasks.getptr(current_load_task)->waiting_for = local_path;
+	}
+	_run_load_task(local_path);
+	if (current_load_task != String()) {
+		thread_load_tasks.getptr(current_load_task)->waiting_for = String();
+	}
+	thread_load_mutex.unlock();
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	MutexLock lock(thread_load_mutex);
+
+	const ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task) {
+		if (r_progress) {
+			*r_progress = 0;
+		}
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	if (r_progress) {
+		*r_progress = _get_load_task_progress(local_path, 0);
+	}
+	return task->status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+	String local_path;
+	if (p_path.is_rel_path()) {
+		local_path = "res://" + p_path;
+	} else {
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	}
+
+	thread_load_mutex.lock();
+
+	if (!thread_load_tasks.has(local_path)) {
+		thread_load_mutex.unlock();
+		if (r_error) {
+			*r_error = ERR_INVALID_PARAMETER;
+		}
+		ERR_FAIL_V_MSG(RES(), "Attempted to get a threaded load of '" + local_path + "' that was never requested (or was already retrieved).");
+	}
+
+	return _wait_for_load_task(local_path, true, r_error);
+}
+
+bool ResourceLoader::is_loading_with_sub_threads() {
+	return current_load_use_sub_threads;
+}
+
+// Runs on the worker pool, once per request. Loads the oldest queued request, if a waiting thread hasn't taken it over.
+void ResourceLoader::_thread_load_function(void *p_userdata, uint32_t p_index) {
+	MutexLock lock(thread_load_mutex);
+
+	if (thread_load_exit || thread_load_queue.empty()) {
+		return;
+	}
+
+	String local_path = thread_load_queue.front()->get();
+	thread_load_queue.pop_front();
+	_run_load_task(local_path);
+}
+
+// Called with thread_load_mutex locked, returns with it locked.
+void ResourceLoader::_run_load_task(const String &p_local_path) {
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	task->started = true;
+	String type_hint = task->type_hint;
+	bool use_sub_threads = task->use_sub_threads;
+
+	thread_load_mutex.unlock();
+
+	String prev_load_task = current_load_task;
+	bool prev_load_use_sub_threads = current_load_use_sub_threads;
+	current_load_task = p_local_path;
+	current_load_use_sub_threads = use_sub_threads;
+
+	Error err = OK;
+	RES res;
+	Ref<ResourceInteractiveLoader> ril = load_interactive(p_local_path, type_hint, false, &err);
+	if (ril.is_valid()) {
+		while (true) {
+			err = ril->poll();
+			if (err == ERR_FILE_EOF) {
+				err = OK;
+				res = ril->get_resource();
+				break;
+			}
+			if (err != OK) {
+				break;
+			}
+
+			int stage_count = ril->get_stage_count();
+			if (stage_count > 0) {
+				thread_load_mutex.lock();
+				thread_load_tasks.getptr(p_local_path)->progress = float(ril->get_stage()) / stage_count;
+				thread_load_mutex.unlock();
+			}
+		}
+		ril.unref();
+	}
+
+	current_load_task = prev_load_task;
+	current_load_use_sub_threads = prev_load_use_sub_threads;
+
+	thread_load_mutex.lock();
+
+	task = thread_load_tasks.getptr(p_local_path);
+	task->resource = res;
+	if (res.is_valid()) {
+		task->status = THREAD_LOAD_LOADED;
+		task->progress = 1.0;
+		task->error = OK;
+	} else {
+		task->status = THREAD_LOAD_FAILED;
+		task->error = err != OK ? err : ERR_CANT_OPEN;
+	}
+
+	for (int i = 0; i < task->waiters; i++) {
+		task->semaphore->post();
+	}
+
+	_release_load_task(p_local_path);
+}
+
+// Called with thread_load_mutex locked. Erases the task once it's done and nobody needs it any more.
+// A task still in progress is left to the thread running it, which calls this when it ends.
+void ResourceLoader::_release_load_task(const String &p_local_path) {
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (task->requests > 0 || task->waiters > 0 || task->status == THREAD_LOAD_IN_PROGRESS) {
+		return;
+	}
+
+	if (task->semaphore) {
+		memdelete(task->semaphore);
+	}
+	thread_load_tasks.erase(p_local_path);
+}
+
+// Called with thread_load_mutex locked, returns with it unlocked.
+RES ResourceLoader::_wait_for_load_task(const String &p_local_path, bool p_consume, Error *r_error) {
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+
+	if (task->status == THREAD_LOAD_IN_PROGRESS) {
+		if (current_load_task != String()) {
+			// If the task (or one it's waiting for) waits for the one run by this thread, neither would finish.
+			String waiting = p_local_path;
+			for (uint32_t i = 0; i <= thread_load_tasks.size() && waiting != String(); i++) {
+				if (waiting == current_load_task) {
+					if (p_consume) {
+						task->requests--;
+					}
+					_release_load_task(p_local_path);
+					thread_load_mutex.unlock();
+					if (r_error) {
+						*r_error = ERR_CYCLIC_LINK;
+					}
+					ERR_FAIL_V_MSG(RES(), "Resource: '" + current_load_task + "' depends on '" + p_local_path + "', which is being loaded. Cyclic reference?");
+				}
+				const ThreadLoadTask *waiting_task = thread_load_tasks.getptr(waiting);
+				waiting = waiting_task ? waiting_task->waiting_for : String();
+			}
+
+			thread_load_tasks.getptr(current_load_task)->waiting_for = p_local_path;
+		}
+
+		if (!task->started) {
+			// Not picked up by a loading thread yet, load it here rather than wait.
+			thread_load_queue.erase(p_local_path);
+			_run_load_task(p_local_path);
+		} else {
+			if (!task->semaphore) {
+				task->semaphore = memnew(Semaphore);
+			}
+			task->waiters++;
+			Semaphore *semaphore = task->semaphore;
+
+			thread_load_mutex.unlock();
+			semaphore->wait();
+			thread_load_mutex.lock();
+
+			thread_load_tasks.getptr(p_local_path)->waiters--;
+		}
+
+		if (current_load_task != String()) {
+			thread_load_tasks.getptr(current_load_task)->waiting_for = String();
+		}
+		task = thread_load_tasks.getptr(p_local_path);
+	}
+
+	RES res = task->resource;
+	Error err = task->error;
+
+	if (p_consume) {
+		task->requests--;
+	}
+	_release_load_task(p_local_path);
+
+	thread_load_mutex.unlock();
+
+	if (r_error) {
+		*r_error = err;
+	}
+	return res;
+}
+
+// Called with thread_load_mutex locked.
+float ResourceLoader::_get_load_task_progress(const String &p_local_path, int p_depth) {
+	const ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task) {
+		return 1.0; // Already retrieved, so it's done.
+	}
+	if (task->status != THREAD_LOAD_IN_PROGRESS) {
+		return 1.0;
+	}
+	if (task->sub_tasks.empty() || p_depth > 16) {
+		return task->progress;
+	}
+
+	float progress = task->progress;
+	for (int i = 0; i < task->sub_tasks.size(); i++) {
+		progress += _get_load_task_progress(task->sub_tasks[i], p_depth + 1);
+	}
+	return progress / (task->sub_tasks.size() + 1);
+}
+
 bool ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 	String local_path;
 	if (p_path.is_rel_path()) {
@@ -968,8 +1268,41 @@ void ResourceLoader::remove_custom_loaders() {
 Mutex ResourceLoader::loading_map_mutex;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
 
+Mutex ResourceLoader::thread_load_mutex;
+HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
+List<String> ResourceLoader::thread_load_queue;
+Vector<ThreadWorkPool::GroupID> ResourceLoader::thread_load_groups;
+bool ResourceLoader::thread_load_exit = false;
+
+void ResourceLoader::stop_threaded_loads() {
+#ifndef NO_THREADS
+	thread_load_mutex.lock();
+	thread_load_exit = true;
+	Vector<ThreadWorkPool::GroupID> groups = thread_load_groups;
+	thread_load_groups.clear();
+	thread_load_mutex.unlock();
+
+	// Loads that haven't started are dropped, the ones that have are waited for.
+	for (int i = 0; i < groups.size(); i++) {
+		ThreadWorkPool::get_singleton()->wait_for_group_task_completion(groups[i]);
+	}
+#endif
+}
+
 void ResourceLoader::finalize() {
 #ifndef NO_THREADS
+	stop_threaded_loads();
+
+	const String *L = nullptr;
+	while ((L = thread_load_tasks.next(L))) {
+		ThreadLoadTask &task = thread_load_tasks[*L];
+		if (task.semaphore) {
+			memdelete(task.semaphore);
+		}
+	}
+	thread_load_tasks.clear();
+	thread_load_queue.clear();
+
 	const LoadingMapKey *K = nullptr;
 	while ((K = loading_map.next(K))) {
 		ERR_PRINT("Exited while resource is being loaded: " + K->path);
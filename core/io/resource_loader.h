@@ -31,7 +31,9 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/resource.h"
 
 class ResourceInteractiveLoader : public Reference {
@@ -88,6 +90,15 @@ typedef Error (*ResourceLoaderImport)(const String &p_path);
 typedef void (*ResourceLoadedCallback)(RES p_resource, const String &p_path);
 
 class ResourceLoader {
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
 	enum {
 		MAX_LOADERS = 64
 	};
@@ -137,11 +148,55 @@ class ResourceLoader {
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
 
+	//threaded loads, keyed by local path so concurrent requests for the same resource share one load
+	struct ThreadLoadTask {
+		String type_hint;
+		bool use_sub_threads;
+		bool started;
+		ThreadLoadStatus status;
+		float progress;
+		Error error;
+		RES resource;
+		int requests; // load_threaded_request() calls not yet matched by load_threaded_get().
+		int waiters;
+		Semaphore *semaphore; // Posted once per waiter when the load ends.
+		String waiting_for; // Task this one is blocked on, used to detect cyclic dependencies.
+		Vector<String> sub_tasks;
+
+		ThreadLoadTask() :
+				use_sub_threads(false),
+				started(false),
+				status(THREAD_LOAD_IN_PROGRESS),
+				progress(0),
+				error(OK),
+				requests(0),
+				waiters(0),
+				semaphore(nullptr) {}
+	};
+
+	static Mutex thread_load_mutex;
+	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static List<String> thread_load_queue;
+	static Vector<ThreadWorkPool::GroupID> thread_load_groups; // One per request handed to the worker pool, not released yet.
+	static bool thread_load_exit;
+
+	static void _thread_load_function(void *p_userdata, uint32_t p_index);
+	static void _run_load_task(const String &p_local_path);
+	static void _release_load_task(const String &p_local_path);
+	static RES _wait_for_load_task(const String &p_local_path, bool p_consume, Error *r_error);
+	static float _get_load_task_progress(const String &p_local_path, int p_depth);
+
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = nullptr);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false);
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
+	static RES load_threaded_get(const String &p_path, Error *r_error = nullptr);
+	static bool is_loading_with_sub_threads(); // For loaders: true while running a threaded load that should fan out its dependencies.
+	static void stop_threaded_loads(); // Must be called before the worker pool is deleted.
+
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
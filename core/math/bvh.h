@@ -101,6 +101,7 @@ public:
 
 	BVHHandle create(T *p_userdata, bool p_active, const BOUNDS &p_aabb = BOUNDS(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1) {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 
 		// not sure if absolutely necessary to flush collisions here. It will cost performance to, instead
 		// of waiting for update, so only uncomment this if there are bugs.
@@ -198,15 +199,22 @@ public:
 
 	////////////////////////////////////////////////////
 
+	// Moves only update the leaves straight away. The refitting of their ancestors is deferred
+	// until the tree is next culled, updated or added to, so that a batch of moves shares a single refit pass.
 	void move(BVHHandle p_handle, const BOUNDS &p_aabb) {
 		BVH_LOCKED_FUNCTION
-		if (tree.item_move(p_handle, p_aabb)) {
+		if (tree.item_move(p_handle, p_aabb, true)) {
 			if (USE_PAIRS) {
 				_add_changed_item(p_handle, p_aabb);
 			}
 		}
 	}
 
+	// Number of passes refit_deferred() has made over deferred moves, for tests.
+	uint32_t get_deferred_refit_pass_count() const {
+		return tree._deferred_refit_pass_count;
+	}
+
 	void recheck_pairs(BVHHandle p_handle) {
 		BVH_LOCKED_FUNCTION
 		if (USE_PAIRS) {
@@ -298,6 +306,7 @@ public:
 	// call e.g. once per frame (this does a trickle optimize)
 	void update() {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		tree.update();
 		_check_for_collisions();
 #ifdef BVH_INTEGRITY_CHECKS
@@ -308,6 +317,7 @@ public:
 	// this can be called more frequently than per frame if necessary
 	void update_collisions() {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		_check_for_collisions();
 	}
 
@@ -345,6 +355,7 @@ public:
 	// cull tests
 	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -363,6 +374,7 @@ public:
 
 	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -382,6 +394,7 @@ public:
 
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -399,6 +412,7 @@ public:
 
 	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) {
 		BVH_LOCKED_FUNCTION
+		tree.refit_deferred();
 		if (!p_convex.size()) {
 			return 0;
 		}
@@ -434,6 +448,9 @@ private:
 			return;
 		}
 
+		// pairing culls the tree directly
+		tree.refit_deferred();
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -30,31 +30,204 @@
 
 #include "message_queue.h"
 
+#include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
 MessageQueue *MessageQueue::singleton = nullptr;
 
+thread_local MessageQueue::Producer *MessageQueue::thread_producer = nullptr;
+thread_local uint64_t MessageQueue::thread_producer_serial = 0;
+
+static SafeNumeric<uint64_t> message_queue_serial;
+
 MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
-	_THREAD_SAFE_METHOD_
+MessageQueue::Page *MessageQueue::_alloc_page(Producer *p_producer, uint32_t p_size) {
+	Page *page = nullptr;
+
+	if (p_size <= PAGE_SIZE) {
+		MutexLock lock(p_producer->mutex);
+		page = p_producer->free_pages;
+		if (page) {
+			p_producer->free_pages = page->next.load(std::memory_order_relaxed);
+			retained.sub(page->size);
+		}
+	}
+
+	if (!page) {
+		uint32_t size = MAX(p_size, (uint32_t)PAGE_SIZE);
+		page = (Page *)memalloc(sizeof(Page) + size);
+		page->size = size;
+		memory_used.add(sizeof(Page) + size);
+	}
+
+	page->next.store(nullptr, std::memory_order_relaxed);
+	page->end.store(0, std::memory_order_relaxed);
+	page->read = 0;
+	return page;
+}
+
+void MessageQueue::_recycle_page(Producer *p_producer, Page *p_page) {
+	if (p_page->size == PAGE_SIZE && !p_producer->released.is_set() && retained.get() + p_page->size <= retained_max) {
+		retained.add(p_page->size);
+		MutexLock lock(p_producer->mutex);
+		p_page->next.store(p_producer->free_pages, std::memory_order_relaxed);
+		p_producer->free_pages = p_page;
+	} else {
+		memory_used.sub(sizeof(Page) + p_page->size);
+		memfree(p_page);
+	}
+}
+
+void MessageQueue::_free_producer(Producer *p_producer) {
+	released_pushed += p_producer->pushed.load(std::memory_order_relaxed);
+	released_pushed_bytes += p_producer->pushed_bytes.load(std::memory_order_relaxed);
+
+	Page *page = p_producer->first;
+	while (page) {
+		Page *next = page->next.load(std::memory_order_relaxed);
+		memory_used.sub(sizeof(Page) + page->size);
+		memfree(page);
+		page = next;
+	}
+	page = p_producer->free_pages;
+	while (page) {
+		Page *next = page->next.load(std::memory_order_relaxed);
+		retained.sub(page->size);
+		memory_used.sub(sizeof(Page) + page->size);
+		memfree(page);
+		page = next;
+	}
+	memdelete(p_producer);
+}
+
+MessageQueue::Producer *MessageQueue::_get_thread_producer() {
+	if (likely(thread_producer && thread_producer_serial == serial)) {
+		return thread_producer;
+	}
+
+	Producer *producer = memnew(Producer);
+	producer->free_pages = nullptr;
+	producer->pushed.store(0, std::memory_order_relaxed);
+	producer->pushed_bytes.store(0, std::memory_order_relaxed);
+	producer->first = _alloc_page(producer, PAGE_SIZE);
+	producer->last = producer->first;
+
+	{
+		MutexLock lock(producers_mutex);
+		producer->next = producers.load(std::memory_order_relaxed);
+		producers.store(producer, std::memory_order_release);
+	}
+
+	thread_producer = producer;
+	thread_producer_serial = serial;
+	return producer;
+}
+
+uint8_t *MessageQueue::_begin_message(uint32_t p_size, Producer *&r_producer, Page *&r_page, uint32_t &r_offset) {
+	Producer *producer = _get_thread_producer();
+	Page *page = producer->last;
+	uint32_t offset = page->end.load(std::memory_order_relaxed);
+
+	if (offset + p_size > page->size) {
+		// A call deferring more calls each time it runs would otherwise take all memory.
+		if (unlikely(memory_used.get() - retained.get() + MAX(p_size, (uint32_t)PAGE_SIZE) > pending_max)) {
+			return nullptr;
+		}
+
+		// The old page is complete once the new one is linked, flush() moves on from it when done.
+		Page *new_page = _alloc_page(producer, p_size);
+		page->next.store(new_page, std::memory_order_release);
+		producer->last = new_page;
+		page = new_page;
+		offset = 0;
+	}
+
+	r_producer = producer;
+	r_page = page;
+	r_offset = offset;
+	return page->data() + offset;
+}
+
+void MessageQueue::_report_overflow(const char *p_kind, const String &p_target, ObjectID p_id) {
+	// Only report once until the next flush, every further push would fail the same way.
+	if (overflow_reported.is_set()) {
+		return;
+	}
+	overflow_reported.set();
+
+	String type;
+	if (ObjectDB::get_instance(p_id)) {
+		type = ObjectDB::get_instance(p_id)->get_class();
+	}
+	print_line("Failed " + String(p_kind) + ": " + type + ":" + p_target + " target ID: " + itos(p_id));
+	ERR_PRINT("Message queue out of memory. Try increasing 'memory/limits/message_queue/max_pending_kb' in project settings.");
+}
+
+void MessageQueue::_end_message(Producer *p_producer, Page *p_page, uint32_t p_offset, uint32_t p_size) {
+	p_producer->pushed.store(p_producer->pushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	p_producer->pushed_bytes.store(p_producer->pushed_bytes.load(std::memory_order_relaxed) + p_size, std::memory_order_relaxed);
+	p_page->end.store(p_offset + p_size, std::memory_order_release);
+}
+
+MessageQueue::Message *MessageQueue::_peek(Producer *p_producer) {
+	Page *page = p_producer->first;
+	while (true) {
+		if (page->read < page->end.load(std::memory_order_acquire)) {
+			return (Message *)(page->data() + page->read);
+		}
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+		Page *next = page->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+		// The page may have been completed right before the next one was linked.
+		if (page->read < page->end.load(std::memory_order_acquire)) {
+			continue;
+		}
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id)) {
-			type = ObjectDB::get_instance(p_id)->get_class();
+		p_producer->first = next;
+		_recycle_page(p_producer, page);
+		page = next;
+	}
+}
+
+uint32_t MessageQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void MessageQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
 		}
-		print_line("Failed method: " + type + ":" + p_method + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	p_message->~Message();
+}
+
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+
+	Producer *producer;
+	Page *page;
+	uint32_t offset;
+	uint8_t *buffer = _begin_message(room_needed, producer, page, offset);
+	if (unlikely(!buffer)) {
+		_report_overflow("method", p_method, p_id);
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	Message *msg = memnew_placement(buffer, Message);
+	msg->order = order.increment();
 	msg->args = p_argcount;
 	msg->instance_id = p_id;
 	msg->target = p_method;
@@ -63,14 +236,13 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const V
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+		memnew_placement(&args[i], Variant(*p_args[i]));
 	}
 
+	_end_message(producer, page, offset, room_needed);
+
 	return OK;
 }
 
@@ -90,56 +262,53 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 }
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id)) {
-			type = ObjectDB::get_instance(p_id)->get_class();
-		}
-		print_line("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
+
+	Producer *producer;
+	Page *page;
+	uint32_t offset;
+	uint8_t *buffer = _begin_message(room_needed, producer, page, offset);
+	if (unlikely(!buffer)) {
+		_report_overflow("set", p_prop, p_id);
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(buffer, Message);
+	msg->order = order.increment();
 	msg->args = 1;
 	msg->instance_id = p_id;
 	msg->target = p_prop;
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
+	memnew_placement(msg + 1, Variant(p_value));
 
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	_end_message(producer, page, offset, room_needed);
 
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
+	uint32_t room_needed = sizeof(Message);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
+	Producer *producer;
+	Page *page;
+	uint32_t offset;
+	uint8_t *buffer = _begin_message(room_needed, producer, page, offset);
+	if (unlikely(!buffer)) {
+		_report_overflow("notification", itos(p_notification), p_id);
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
-
+	Message *msg = memnew_placement(buffer, Message);
+	msg->order = order.increment();
 	msg->type = TYPE_NOTIFICATION;
 	msg->instance_id = p_id;
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	_end_message(producer, page, offset, room_needed);
 
 	return OK;
 }
@@ -161,54 +330,57 @@ void MessageQueue::statistics() {
 	Map<StringName, int> call_count;
 	int null_count = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	// Like flush(), this must not run while another thread flushes.
+	for (Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+		for (Page *page = producer->first; page; page = page->next.load(std::memory_order_acquire)) {
+			uint32_t end = page->end.load(std::memory_order_acquire);
+			uint32_t read_pos = page->read;
+			while (read_pos < end) {
+				Message *message = (Message *)(page->data() + read_pos);
 
-		Object *target = ObjectDB::get_instance(message->instance_id);
+				Object *target = ObjectDB::get_instance(message->instance_id);
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (!call_count.has(message->target)) {
-						call_count[message->target] = 0;
-					}
+				if (target != nullptr) {
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
+							if (!call_count.has(message->target)) {
+								call_count[message->target] = 0;
+							}
 
-					call_count[message->target]++;
+							call_count[message->target]++;
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (!notify_count.has(message->notification)) {
-						notify_count[message->notification] = 0;
-					}
+						} break;
+						case TYPE_NOTIFICATION: {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
 
-					notify_count[message->notification]++;
+							notify_count[message->notification]++;
 
-				} break;
-				case TYPE_SET: {
-					if (!set_count.has(message->target)) {
-						set_count[message->target] = 0;
-					}
+						} break;
+						case TYPE_SET: {
+							if (!set_count.has(message->target)) {
+								set_count[message->target] = 0;
+							}
 
-					set_count[message->target]++;
+							set_count[message->target]++;
 
-				} break;
-			}
+						} break;
+					}
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
 
-			null_count++;
-		}
+					null_count++;
+				}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
+				read_pos += _get_message_size(message);
+			}
 		}
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(get_stats().usage));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -225,7 +397,33 @@ void MessageQueue::statistics() {
 }
 
 int MessageQueue::get_max_buffer_usage() const {
-	return buffer_max_used;
+	return max_usage.load(std::memory_order_relaxed);
+}
+
+MessageQueue::Stats MessageQueue::get_stats() const {
+	Stats stats;
+	stats.flushed = flushed.load(std::memory_order_relaxed);
+
+	uint64_t pushed_bytes = 0;
+	{
+		MutexLock lock(producers_mutex);
+		stats.pushed = released_pushed;
+		pushed_bytes = released_pushed_bytes;
+		for (Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+			stats.pushed += producer->pushed.load(std::memory_order_relaxed);
+			pushed_bytes += producer->pushed_bytes.load(std::memory_order_relaxed);
+		}
+	}
+
+	stats.pushed = MAX(stats.pushed, stats.flushed);
+	stats.pending = stats.pushed - stats.flushed;
+	stats.usage = MAX(pushed_bytes, flushed_bytes.load(std::memory_order_relaxed)) - flushed_bytes.load(std::memory_order_relaxed);
+	stats.max_usage = MAX(max_usage.load(std::memory_order_relaxed), stats.usage);
+	stats.memory_used = memory_used.get();
+	stats.last_flush_usec = last_flush_usec.load(std::memory_order_relaxed);
+	stats.max_flush_usec = max_flush_usec.load(std::memory_order_relaxed);
+	stats.last_flush_count = last_flush_count.load(std::memory_order_relaxed);
+	return stats;
 }
 
 void MessageQueue::_call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error) {
@@ -245,32 +443,38 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 }
 
 void MessageQueue::flush() {
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
+	{
+		MutexLock lock(producers_mutex);
+		ERR_FAIL_COND(flushing); //already flushing, you did something odd
+		flushing = true;
 	}
 
-	uint32_t read_pos = 0;
-
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
-
-	ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	flushing = true;
-
-	while (read_pos < buffer_end) {
-		//lock on each iteration, so a call can re-add itself to the message queue
-
-		Message *message = (Message *)&buffer[read_pos];
+	uint64_t begin = OS::get_singleton() ? OS::get_singleton()->get_ticks_usec() : 0;
+	uint64_t usage = get_stats().usage;
+	if (usage > max_usage.load(std::memory_order_relaxed)) {
+		max_usage.store(usage, std::memory_order_relaxed);
+	}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+	uint64_t count = 0;
+
+	while (true) {
+		// Run the oldest published message of all threads, this includes messages pushed while flushing.
+		Producer *producer = nullptr;
+		Message *message = nullptr;
+		for (Producer *p = producers.load(std::memory_order_acquire); p; p = p->next) {
+			Message *m = _peek(p);
+			if (m && (!message || m->order < message->order)) {
+				producer = p;
+				message = m;
+			}
 		}
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+		if (!message) {
+			break;
+		}
 
-		_THREAD_SAFE_UNLOCK_
+		uint32_t size = _get_message_size(message);
+		producer->first->read += size;
 
 		Object *target = ObjectDB::get_instance(message->instance_id);
 
@@ -298,60 +502,101 @@ void MessageQueue::flush() {
 			}
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
+		_destroy_message(message);
+
+		flushed.store(flushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		flushed_bytes.store(flushed_bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+		count++;
+	}
+
+	{
+		// Free the pages of threads that have exited, now that their messages have run.
+		MutexLock lock(producers_mutex);
+		Producer *prev = nullptr;
+		Producer *producer = producers.load(std::memory_order_relaxed);
+		while (producer) {
+			Producer *next = producer->next;
+			if (producer->released.is_set() && !_peek(producer)) {
+				if (prev) {
+					prev->next = next;
+				} else {
+					producers.store(next, std::memory_order_release);
+				}
+				_free_producer(producer);
+			} else {
+				prev = producer;
 			}
+			producer = next;
 		}
 
-		message->~Message();
-
-		_THREAD_SAFE_LOCK_
+		flushing = false;
 	}
+	overflow_reported.clear();
 
-	buffer_end = 0; // reset buffer
-	flushing = false;
-	_THREAD_SAFE_UNLOCK_
+	uint64_t flush_usec = OS::get_singleton() ? OS::get_singleton()->get_ticks_usec() - begin : 0;
+	last_flush_usec.store(flush_usec, std::memory_order_relaxed);
+	last_flush_count.store(count, std::memory_order_relaxed);
+	if (flush_usec > max_flush_usec.load(std::memory_order_relaxed)) {
+		max_flush_usec.store(flush_usec, std::memory_order_relaxed);
+	}
 }
 
 bool MessageQueue::is_flushing() const {
 	return flushing;
 }
 
+void MessageQueue::release_thread_producer() {
+	if (!thread_producer) {
+		return;
+	}
+
+	if (singleton && thread_producer_serial == singleton->serial) {
+		thread_producer->released.set();
+	}
+	thread_producer = nullptr;
+}
+
 MessageQueue::MessageQueue() {
 	ERR_FAIL_COND_MSG(singleton != nullptr, "A MessageQueue singleton already exists.");
 	singleton = this;
 	flushing = false;
 
-	buffer_end = 0;
-	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	producers.store(nullptr);
+	serial = message_queue_serial.increment();
+	released_pushed = 0;
+	released_pushed_bytes = 0;
+	flushed.store(0);
+	flushed_bytes.store(0);
+	max_usage.store(0);
+	last_flush_usec.store(0);
+	max_flush_usec.store(0);
+	last_flush_count.store(0);
+
+	retained_max = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	retained_max *= 1024;
+
+	pending_max = GLOBAL_DEF_RST("memory/limits/message_queue/max_pending_kb", DEFAULT_MAX_PENDING_KB);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_pending_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_pending_kb", PROPERTY_HINT_RANGE, "4096,65536,1,or_greater"));
+	pending_max *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
-	uint32_t read_pos = 0;
-
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++) {
-				args[i].~Variant();
-			}
+	Producer *producer = producers.load();
+	while (producer) {
+		Message *message;
+		while ((message = _peek(producer))) {
+			producer->first->read += _get_message_size(message);
+			_destroy_message(message);
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
-		}
+		Producer *next = producer->next;
+		_free_producer(producer);
+		producer = next;
 	}
 
+	if (thread_producer_serial == serial) {
+		thread_producer = nullptr;
+	}
 	singleton = nullptr;
-	memdelete_arr(buffer);
 }
@@ -32,13 +32,21 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object.h"
-#include "core/os/thread_safe.h"
+#include "core/os/mutex.h"
+#include "core/safe_refcount.h"
 
-class MessageQueue {
-	_THREAD_SAFE_CLASS_
+#include <atomic>
 
+// Deferred calls, notifications and property sets, run on flush().
+// Every thread pushes into its own chain of pages, so threads don't contend with each other and the queue grows as
+// needed, up to memory/limits/message_queue/max_pending_kb.
+// flush() runs the messages of each thread in the order that thread pushed them. Messages are stamped before they are
+// published, so messages pushed by different threads at the same time may run in either order.
+class MessageQueue {
 	enum {
-		DEFAULT_QUEUE_SIZE_KB = 4096
+		DEFAULT_QUEUE_SIZE_KB = 4096,
+		DEFAULT_MAX_PENDING_KB = 65536,
+		PAGE_SIZE = 16 * 1024
 	};
 
 	enum {
@@ -51,6 +59,7 @@ class MessageQueue {
 	};
 
 	struct Message {
+		uint64_t order; // push order, only exact between messages of one thread
 		ObjectID instance_id;
 		StringName target;
 		int16_t type;
@@ -60,10 +69,62 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
-	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+	// Messages are appended by the owning thread and published by advancing end. Only flush() reads them.
+	struct Page {
+		std::atomic<Page *> next;
+		std::atomic<uint32_t> end;
+		uint32_t read;
+		uint32_t size;
+
+		_FORCE_INLINE_ uint8_t *data() { return reinterpret_cast<uint8_t *>(this) + sizeof(Page); }
+	};
+
+	struct Producer {
+		Page *first; // oldest page, owned by flush()
+		Page *last; // page being written, owned by the pushing thread
+		Page *free_pages; // pages recycled by flush(), guarded by mutex
+		BinaryMutex mutex;
+		std::atomic<uint64_t> pushed; // written by the pushing thread only
+		std::atomic<uint64_t> pushed_bytes;
+		SafeFlag released; // the thread has exited
+		Producer *next;
+	};
+
+	std::atomic<Producer *> producers;
+	Mutex producers_mutex; // guards adding and removing producers
+	SafeNumeric<uint64_t> order;
+	uint64_t serial;
+
+	uint32_t retained_max; // page memory kept for reuse between flushes
+	uint64_t pending_max; // page memory pending messages can take
+	SafeFlag overflow_reported;
+	SafeNumeric<uint64_t> retained;
+	SafeNumeric<uint64_t> memory_used;
+
+	// Totals of producers that have been removed.
+	uint64_t released_pushed;
+	uint64_t released_pushed_bytes;
+
+	std::atomic<uint64_t> flushed;
+	std::atomic<uint64_t> flushed_bytes;
+	std::atomic<uint64_t> max_usage;
+	std::atomic<uint64_t> last_flush_usec;
+	std::atomic<uint64_t> max_flush_usec;
+	std::atomic<uint64_t> last_flush_count;
+
+	static thread_local Producer *thread_producer;
+	static thread_local uint64_t thread_producer_serial;
+
+	Page *_alloc_page(Producer *p_producer, uint32_t p_size);
+	void _recycle_page(Producer *p_producer, Page *p_page);
+	void _free_producer(Producer *p_producer);
+	Producer *_get_thread_producer();
+	uint8_t *_begin_message(uint32_t p_size, Producer *&r_producer, Page *&r_page, uint32_t &r_offset);
+	void _report_overflow(const char *p_kind, const String &p_target, ObjectID p_id);
+	void _end_message(Producer *p_producer, Page *p_page, uint32_t p_offset, uint32_t p_size);
+	Message *_peek(Producer *p_producer);
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -72,6 +133,18 @@ class MessageQueue {
 	bool flushing;
 
 public:
+	struct Stats {
+		uint64_t pushed = 0;
+		uint64_t flushed = 0;
+		uint64_t pending = 0;
+		uint64_t usage = 0; // bytes taken by pending messages
+		uint64_t max_usage = 0;
+		uint64_t memory_used = 0; // bytes allocated for pages
+		uint64_t last_flush_usec = 0;
+		uint64_t max_flush_usec = 0;
+		uint64_t last_flush_count = 0;
+	};
+
 	static MessageQueue *get_singleton();
 
 	Error push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
@@ -89,6 +162,10 @@ public:
 	bool is_flushing() const;
 
 	int get_max_buffer_usage() const;
+	Stats get_stats() const;
+
+	// Called when a thread exits, so its pages are freed once flushed.
+	static void release_thread_producer();
 
 	MessageQueue();
 	~MessageQueue();
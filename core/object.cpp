@@ -893,6 +893,20 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 		return Variant();
 	}
 
+	return _call_unfreed(p_method, p_args, p_argcount, r_error, nullptr);
+}
+
+Variant Object::call_cached(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCallCache *p_cache) {
+	if (_overrides_call() || p_method == CoreStringNames::get_singleton()->_free) {
+		return call(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+	return _call_unfreed(p_method, p_args, p_argcount, r_error, p_cache);
+}
+
+// Script first, then the native method. Everything but free() ends up here.
+Variant Object::_call_unfreed(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCallCache *p_cache) {
 	Variant ret;
 	OBJ_DEBUG_LOCK
 	if (script_instance) {
@@ -912,7 +926,7 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 		}
 	}
 
-	MethodBind *method = ClassDB::get_method(get_class_name(), p_method);
+	MethodBind *method = p_cache ? ClassDB::get_method_cached(get_class_name(), p_method, p_cache) : ClassDB::get_method(get_class_name(), p_method);
 
 	if (method) {
 		ret = method->call(this, p_args, p_argcount, r_error);
@@ -1174,6 +1188,10 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
+	if (s->slot_map.empty()) {
+		return OK;
+	}
+
 	List<_ObjectSignalDisconnectData> disconnect_data;
 
 	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
@@ -1185,12 +1203,16 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 	OBJ_DEBUG_LOCK
 
-	Vector<const Variant *> bind_mem;
+	// Binds are appended to the arguments on the stack, unless there are too many.
+	const int BIND_STACK_MAX = 16;
+	const Variant *bind_stack[BIND_STACK_MAX];
+	Vector<const Variant *> bind_heap;
 
 	Error err = OK;
 
 	for (int i = 0; i < ssize; i++) {
-		const Connection &c = slot_map.getv(i).conn;
+		const Signal::Slot &slot = slot_map.getv(i);
+		const Connection &c = slot.conn;
 
 		Object *target = ObjectDB::get_instance(slot_map.getk(i)._id);
 		if (!target) {
@@ -1203,25 +1225,30 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 		if (c.binds.size()) {
 			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
+			argc = p_argcount + c.binds.size();
+			if (argc <= BIND_STACK_MAX) {
+				args = bind_stack;
+			} else {
+				bind_heap.resize(argc);
+				args = bind_heap.ptrw();
+			}
 
 			for (int j = 0; j < p_argcount; j++) {
-				bind_mem.write[j] = p_args[j];
+				args[j] = p_args[j];
 			}
 			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+				args[p_argcount + j] = &c.binds[j];
 			}
-
-			args = (const Variant **)bind_mem.ptr();
-			argc = bind_mem.size();
 		}
 
 		if (c.flags & CONNECT_DEFERRED) {
 			MessageQueue::get_singleton()->push_call(target->get_instance_id(), c.method, args, argc, true);
 		} else {
 			Variant::CallError ce;
+			// The slot is shared with the signal map, so it's resolved into a copy; a stale cache just misses.
+			MethodCallCache method_cache = slot.method_cache;
 			_emitting = true;
-			target->call(c.method, args, argc, ce);
+			target->call_cached(c.method, args, argc, ce, &method_cache);
 			_emitting = false;
 
 			if (ce.error != Variant::CallError::CALL_OK) {
@@ -1489,6 +1516,9 @@ Error Object::connect(const StringName &p_signal, Object *p_to_object, const Str
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
+	if (!(p_flags & CONNECT_DEFERRED)) {
+		ClassDB::get_method_cached(p_to_object->get_class_name(), p_to_method, &slot.method_cache);
+	}
 
 	s->slot_map[target] = slot;
 
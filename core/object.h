@@ -42,6 +42,7 @@
 #include "core/vmap.h"
 
 #include <atomic>
+#include <type_traits>
 
 #define VARIANT_ARG_LIST const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant()
 #define VARIANT_ARG_PASS p_arg1, p_arg2, p_arg3, p_arg4, p_arg5
@@ -261,6 +262,11 @@ public:                                            \
                                                    \
 private:
 
+// Never defined, only deduces the class declaring the call() that &T::call names. That is Object,
+// unless T or one of its parents overrides call(), which GDCLASS uses to implement _overrides_call().
+template <class T>
+T *_get_call_owner(Variant (T::*p_call)(const StringName &, const Variant **, int, Variant::CallError &));
+
 #define GDCLASS(m_class, m_inherits)                                                                                              \
 private:                                                                                                                          \
 	void operator=(const m_class &p_rval) {}                                                                                      \
@@ -338,6 +344,9 @@ protected:
 	virtual void _initialize_classv() override {                                                                                  \
 		initialize_class();                                                                                                       \
 	}                                                                                                                             \
+	virtual bool _overrides_call() const override {                                                                               \
+		return !std::is_same<decltype(_get_call_owner(&m_class::call)), Object *>::value;                                         \
+	}                                                                                                                             \
 	_FORCE_INLINE_ bool (Object::*_get_get() const)(const StringName &p_name, Variant &) const {                                  \
 		return (bool(Object::*)(const StringName &, Variant &) const) & m_class::_get;                                            \
 	}                                                                                                                             \
@@ -412,6 +421,22 @@ private:
 class ScriptInstance;
 class ObjectRC;
 
+// Call site cache for ClassDB::get_method_cached() and Object::call_cached(). A single pointer to a
+// ClassDB::MethodTableEntry, which carries its own generation, so threads sharing a call site can publish
+// and read it without tearing. Copyable, so call sites can keep arrays of them; an empty cache always misses.
+struct MethodCallCache {
+	std::atomic<const void *> entry; // Only ClassDB looks inside.
+
+	MethodCallCache() :
+			entry(nullptr) {}
+	MethodCallCache(const MethodCallCache &p_other) :
+			entry(p_other.entry.load(std::memory_order_acquire)) {}
+	MethodCallCache &operator=(const MethodCallCache &p_other) {
+		entry.store(p_other.entry.load(std::memory_order_acquire), std::memory_order_release);
+		return *this;
+	}
+};
+
 class Object {
 public:
 	enum ConnectFlags {
@@ -469,6 +494,7 @@ private:
 			int reference_count;
 			Connection conn;
 			List<Connection>::Element *cE;
+			MethodCallCache method_cache; // Resolved on connect, emit_signal() only reads it.
 			Slot() { reference_count = 0; }
 		};
 
@@ -504,6 +530,7 @@ private:
 
 	void _add_user_signal(const String &p_name, const Array &p_args = Array());
 	bool _has_user_signal(const StringName &p_name) const;
+	Variant _call_unfreed(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCallCache *p_cache);
 	Variant _emit_signal(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Array _get_signal_list() const;
 	Array _get_signal_connection_list(const String &p_signal) const;
@@ -558,6 +585,13 @@ protected:
 	_FORCE_INLINE_ void (Object::*_get_notification() const)(int) {
 		return &Object::_notification;
 	}
+
+	// True if call() is overridden, so call_cached() doesn't bypass it. GDCLASS implements it, classes
+	// overriding call() without GDCLASS must override it too.
+	virtual bool _overrides_call() const {
+		return false;
+	}
+
 	static void get_valid_parents_static(List<String> *p_parents);
 	static void _get_valid_parents_static(List<String> *p_parents);
 
@@ -710,6 +744,8 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	// Same as call(), but resolves native methods through the call site cache, see ClassDB::get_method_cached().
+	Variant call_cached(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCallCache *p_cache);
 	virtual void call_multilevel(const StringName &p_method, const Variant **p_args, int p_argcount);
 	virtual void call_multilevel_reversed(const StringName &p_method, const Variant **p_args, int p_argcount);
 	Variant call(const StringName &p_name, VARIANT_ARG_LIST); // C++ helper
@@ -111,6 +111,8 @@ public:
 	virtual real_t get_real() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+	virtual const uint8_t *borrow_buffer(uint64_t p_length) const { return nullptr; } ///< get a pointer to the next p_length bytes without copying them and skip past them; valid until the file is closed. Returns null (and reads nothing) if not supported, use get_buffer() then.
+	virtual const uint8_t *map_read_only() { return nullptr; } ///< map the whole file into memory, read only; valid until the file is closed. Returns null if not supported.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -35,6 +35,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -65,6 +66,338 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+
+#include "core/os/mutex.h"
+
+#include <atomic>
+
+// Allocations of up to SMALL_ALLOC_MAX_SIZE bytes are served from 64 KiB spans, each holding
+// objects of a single size class. A span belongs to the heap of the thread that carved or adopted it.
+// The owner allocates and frees through plain per-class free lists, while other threads push their
+// frees onto the span's atomic remote list, which the owner collects once its free list runs dry.
+// The spans of exited threads are orphaned and adopted by the next thread needing their class.
+// Spans are carved from regions taken from malloc, which are never given back.
+
+#define SMALL_ALLOC_MAX_SIZE 1024
+#define SMALL_ALLOC_SPAN_SHIFT 16
+#define SMALL_ALLOC_SPAN_SIZE (1 << SMALL_ALLOC_SPAN_SHIFT)
+#define SMALL_ALLOC_SPAN_HEADER 64
+#define SMALL_ALLOC_REGION_SPANS 16
+#define SMALL_ALLOC_PAGE_MAP_BITS 16
+
+static const uint32_t small_alloc_class_sizes[Memory::SMALL_ALLOC_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+// Size class of every size, rounded up to 16 bytes.
+static const uint8_t small_alloc_size_classes[SMALL_ALLOC_MAX_SIZE / 16 + 1] = {
+	0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11,
+	11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15,
+	15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17,
+	17, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19,
+	19
+};
+
+struct SmallAllocSpan {
+	std::atomic<void *> remote_free;
+	std::atomic<uint32_t> owner; // Heap id, 0 while orphaned.
+	uint32_t size_class;
+	SmallAllocSpan *next;
+};
+
+static_assert(sizeof(SmallAllocSpan) <= SMALL_ALLOC_SPAN_HEADER, "Small allocator span header too large.");
+
+struct SmallAllocHeap {
+	uint32_t id;
+	void *free_list[Memory::SMALL_ALLOC_CLASS_COUNT];
+	SmallAllocSpan *spans[Memory::SMALL_ALLOC_CLASS_COUNT];
+
+	// Only written by the owning thread, read by get_small_alloc_stats().
+	std::atomic<uint64_t> class_allocations[Memory::SMALL_ALLOC_CLASS_COUNT];
+	std::atomic<int64_t> bytes_in_use;
+	std::atomic<uint64_t> cross_thread_frees;
+
+	SmallAllocHeap *prev;
+	SmallAllocHeap *next;
+};
+
+static BinaryMutex small_alloc_mutex;
+static SmallAllocHeap *small_alloc_heaps = nullptr;
+static uint32_t small_alloc_last_heap_id = 0;
+static SmallAllocSpan *small_alloc_unused_spans = nullptr;
+static SmallAllocSpan *small_alloc_orphan_spans[Memory::SMALL_ALLOC_CLASS_COUNT] = {};
+static uint64_t small_alloc_bytes_reserved = 0;
+// Counters of the heaps of exited threads.
+static uint64_t small_alloc_retired_class_allocations[Memory::SMALL_ALLOC_CLASS_COUNT] = {};
+static int64_t small_alloc_retired_bytes_in_use = 0;
+static uint64_t small_alloc_retired_cross_thread_frees = 0;
+
+// Two level bitmap of the spans carved by the allocator, indexed by address.
+// It covers 48 bit addresses, regions beyond are left to malloc.
+static std::atomic<std::atomic<uint64_t> *> small_alloc_page_map[1 << SMALL_ALLOC_PAGE_MAP_BITS];
+
+static thread_local SmallAllocHeap *small_alloc_heap = nullptr;
+// Set when the thread exits; allocations made after that, e.g. by other thread_local destructors, fall back to malloc.
+static thread_local bool small_alloc_thread_exited = false;
+
+// Releases the heap of a thread when it exits, however the thread was started. Only constructed, and so
+// only registered for destruction, by threads that create a heap.
+struct SmallAllocThreadExit {
+	~SmallAllocThreadExit() {
+		small_alloc_thread_exited = true;
+		Memory::release_thread_cache();
+	}
+};
+
+static thread_local SmallAllocThreadExit small_alloc_thread_exit;
+
+template <class T>
+static _FORCE_INLINE_ void _small_alloc_count(std::atomic<T> &p_counter, T p_amount) {
+	// Counters have a single writer, so they don't need an atomic read-modify-write.
+	p_counter.store(p_counter.load(std::memory_order_relaxed) + p_amount, std::memory_order_relaxed);
+}
+
+static _FORCE_INLINE_ SmallAllocSpan *_small_alloc_find_span(const void *p_ptr) {
+	uint64_t index = (uint64_t)(uintptr_t)p_ptr >> SMALL_ALLOC_SPAN_SHIFT;
+	if (unlikely(index >> (2 * SMALL_ALLOC_PAGE_MAP_BITS))) {
+		return nullptr;
+	}
+	std::atomic<uint64_t> *leaf = small_alloc_page_map[index >> SMALL_ALLOC_PAGE_MAP_BITS].load(std::memory_order_acquire);
+	if (!leaf) {
+		return nullptr;
+	}
+	uint32_t bit = index & ((1 << SMALL_ALLOC_PAGE_MAP_BITS) - 1);
+	if (!(leaf[bit >> 6].load(std::memory_order_relaxed) & ((uint64_t)1 << (bit & 63)))) {
+		return nullptr;
+	}
+	return (SmallAllocSpan *)((uintptr_t)p_ptr & ~(uintptr_t)(SMALL_ALLOC_SPAN_SIZE - 1));
+}
+
+static _FORCE_INLINE_ void _small_alloc_push_remote(SmallAllocSpan *p_span, void *p_ptr) {
+	void *head = p_span->remote_free.load(std::memory_order_relaxed);
+	do {
+		*(void **)p_ptr = head;
+	} while (!p_span->remote_free.compare_exchange_weak(head, p_ptr, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Must be called with small_alloc_mutex locked.
+static bool _small_alloc_reserve_region() {
+	uint8_t *region = (uint8_t *)malloc(SMALL_ALLOC_SPAN_SIZE * (SMALL_ALLOC_REGION_SPANS + 1));
+	if (!region) {
+		return false;
+	}
+
+	uintptr_t first = ((uintptr_t)region + SMALL_ALLOC_SPAN_SIZE - 1) & ~(uintptr_t)(SMALL_ALLOC_SPAN_SIZE - 1);
+	uint64_t first_index = (uint64_t)first >> SMALL_ALLOC_SPAN_SHIFT;
+	if ((first_index + SMALL_ALLOC_REGION_SPANS) >> (2 * SMALL_ALLOC_PAGE_MAP_BITS)) {
+		free(region);
+		return false;
+	}
+
+	for (int i = 0; i < SMALL_ALLOC_REGION_SPANS; i++) {
+		uint64_t index = first_index + i;
+		std::atomic<std::atomic<uint64_t> *> &leaf_ptr = small_alloc_page_map[index >> SMALL_ALLOC_PAGE_MAP_BITS];
+		std::atomic<uint64_t> *leaf = leaf_ptr.load(std::memory_order_relaxed);
+		if (!leaf) {
+			leaf = (std::atomic<uint64_t> *)calloc((1 << SMALL_ALLOC_PAGE_MAP_BITS) / 64, sizeof(std::atomic<uint64_t>));
+			if (!leaf) {
+				// The remaining spans of the region are lost, but the registered ones remain usable.
+				break;
+			}
+			leaf_ptr.store(leaf, std::memory_order_release);
+		}
+		uint32_t bit = index & ((1 << SMALL_ALLOC_PAGE_MAP_BITS) - 1);
+		leaf[bit >> 6].store(leaf[bit >> 6].load(std::memory_order_relaxed) | ((uint64_t)1 << (bit & 63)), std::memory_order_relaxed);
+
+		SmallAllocSpan *span = (SmallAllocSpan *)(first + (uintptr_t)i * SMALL_ALLOC_SPAN_SIZE);
+		span->next = small_alloc_unused_spans;
+		small_alloc_unused_spans = span;
+		small_alloc_bytes_reserved += SMALL_ALLOC_SPAN_SIZE;
+	}
+
+	return small_alloc_unused_spans != nullptr;
+}
+
+static SmallAllocHeap *_small_alloc_create_heap() {
+	if (small_alloc_thread_exited) {
+		return nullptr;
+	}
+
+	void *mem = calloc(1, sizeof(SmallAllocHeap));
+	if (!mem) {
+		return nullptr;
+	}
+	SmallAllocHeap *heap = memnew_placement(mem, SmallAllocHeap);
+
+	{
+		MutexLock lock(small_alloc_mutex);
+		small_alloc_last_heap_id++;
+		if (small_alloc_last_heap_id == 0) {
+			small_alloc_last_heap_id++;
+		}
+		heap->id = small_alloc_last_heap_id;
+		heap->next = small_alloc_heaps;
+		if (small_alloc_heaps) {
+			small_alloc_heaps->prev = heap;
+		}
+		small_alloc_heaps = heap;
+	}
+
+	(void)&small_alloc_thread_exit; // Constructs it, so the heap is released on exit.
+	small_alloc_heap = heap;
+	return heap;
+}
+
+static _FORCE_INLINE_ SmallAllocHeap *_small_alloc_get_heap() {
+	SmallAllocHeap *heap = small_alloc_heap;
+	if (likely(heap)) {
+		return heap;
+	}
+	return _small_alloc_create_heap();
+}
+
+// Returns a list of free objects of the given class, or nullptr if no memory could be reserved.
+static void *_small_alloc_refill(SmallAllocHeap *p_heap, uint32_t p_class) {
+	for (SmallAllocSpan *span = p_heap->spans[p_class]; span; span = span->next) {
+		void *list = span->remote_free.exchange(nullptr, std::memory_order_acquire);
+		if (list) {
+			return list;
+		}
+	}
+
+	SmallAllocSpan *span;
+	{
+		MutexLock lock(small_alloc_mutex);
+
+		while (small_alloc_orphan_spans[p_class]) {
+			span = small_alloc_orphan_spans[p_class];
+			small_alloc_orphan_spans[p_class] = span->next;
+			span->owner.store(p_heap->id, std::memory_order_relaxed);
+			span->next = p_heap->spans[p_class];
+			p_heap->spans[p_class] = span;
+
+			void *list = span->remote_free.exchange(nullptr, std::memory_order_acquire);
+			if (list) {
+				return list;
+			}
+		}
+
+		if (!small_alloc_unused_spans && !_small_alloc_reserve_region()) {
+			return nullptr;
+		}
+		span = small_alloc_unused_spans;
+		small_alloc_unused_spans = span->next;
+	}
+
+	span->remote_free.store(nullptr, std::memory_order_relaxed);
+	span->owner.store(p_heap->id, std::memory_order_relaxed);
+	span->size_class = p_class;
+	span->next = p_heap->spans[p_class];
+	p_heap->spans[p_class] = span;
+
+	uint32_t size = small_alloc_class_sizes[p_class];
+	uint8_t *objects = (uint8_t *)span + SMALL_ALLOC_SPAN_HEADER;
+	uint32_t count = (SMALL_ALLOC_SPAN_SIZE - SMALL_ALLOC_SPAN_HEADER) / size;
+	void *list = nullptr;
+	for (uint32_t i = count; i > 0; i--) {
+		void *object = objects + (i - 1) * size;
+		*(void **)object = list;
+		list = object;
+	}
+	return list;
+}
+
+static _FORCE_INLINE_ void *_small_alloc(size_t p_bytes) {
+	uint32_t size_class = small_alloc_size_classes[(p_bytes + 15) >> 4];
+	SmallAllocHeap *heap = _small_alloc_get_heap();
+	if (unlikely(!heap)) {
+		return nullptr;
+	}
+
+	void *object = heap->free_list[size_class];
+	if (unlikely(!object)) {
+		object = _small_alloc_refill(heap, size_class);
+		if (!object) {
+			return nullptr;
+		}
+	}
+	heap->free_list[size_class] = *(void **)object;
+
+	_small_alloc_count<uint64_t>(heap->class_allocations[size_class], 1);
+	_small_alloc_count<int64_t>(heap->bytes_in_use, small_alloc_class_sizes[size_class]);
+	return object;
+}
+
+static _FORCE_INLINE_ void _small_free(SmallAllocSpan *p_span, void *p_ptr) {
+	uint32_t size_class = p_span->size_class;
+	SmallAllocHeap *heap = _small_alloc_get_heap();
+	if (unlikely(!heap)) {
+		_small_alloc_push_remote(p_span, p_ptr);
+		return;
+	}
+
+	_small_alloc_count<int64_t>(heap->bytes_in_use, -(int64_t)small_alloc_class_sizes[size_class]);
+	if (p_span->owner.load(std::memory_order_relaxed) == heap->id) {
+		*(void **)p_ptr = heap->free_list[size_class];
+		heap->free_list[size_class] = p_ptr;
+	} else {
+		_small_alloc_push_remote(p_span, p_ptr);
+		_small_alloc_count<uint64_t>(heap->cross_thread_frees, 1);
+	}
+}
+
+#endif // SMALL_ALLOCATOR_ENABLED
+
+static _FORCE_INLINE_ void *_alloc_raw(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_bytes <= SMALL_ALLOC_MAX_SIZE) {
+		void *mem = _small_alloc(p_bytes);
+		if (likely(mem)) {
+			return mem;
+		}
+	}
+#endif
+	return malloc(p_bytes);
+}
+
+static _FORCE_INLINE_ void *_realloc_raw(void *p_mem, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	SmallAllocSpan *span = _small_alloc_find_span(p_mem);
+	if (span) {
+		if (p_bytes == 0) {
+			_small_free(span, p_mem);
+			return nullptr;
+		}
+		if (p_bytes <= SMALL_ALLOC_MAX_SIZE && small_alloc_size_classes[(p_bytes + 15) >> 4] == span->size_class) {
+			return p_mem;
+		}
+		void *mem = _alloc_raw(p_bytes);
+		if (!mem) {
+			return nullptr;
+		}
+		memcpy(mem, p_mem, MIN(p_bytes, (size_t)small_alloc_class_sizes[span->size_class]));
+		_small_free(span, p_mem);
+		return mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes);
+}
+
+static _FORCE_INLINE_ void _free_raw(void *p_mem) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	SmallAllocSpan *span = _small_alloc_find_span(p_mem);
+	if (span) {
+		_small_free(span, p_mem);
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -72,7 +405,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	void *mem = _alloc_raw(p_bytes + (prepad ? PAD_ALIGN : 0));
 
 	ERR_FAIL_COND_V(!mem, nullptr);
 
@@ -121,12 +454,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_raw(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+			mem = (uint8_t *)_realloc_raw(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_COND_V(!mem, nullptr);
 
 			s = (uint64_t *)mem;
@@ -136,7 +469,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + PAD_ALIGN;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_realloc_raw(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -165,9 +498,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_free_raw(mem);
 	} else {
-		free(mem);
+		_free_raw(mem);
 	}
 }
 
@@ -191,6 +524,94 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+bool Memory::is_small_allocator_enabled() {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return true;
+#else
+	return false;
+#endif
+}
+
+Memory::SmallAllocStats Memory::get_small_alloc_stats() {
+	SmallAllocStats stats;
+	memset(&stats, 0, sizeof(stats));
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+	MutexLock lock(small_alloc_mutex);
+
+	int64_t bytes_in_use = small_alloc_retired_bytes_in_use;
+	stats.cross_thread_frees = small_alloc_retired_cross_thread_frees;
+	for (int i = 0; i < SMALL_ALLOC_CLASS_COUNT; i++) {
+		stats.class_sizes[i] = small_alloc_class_sizes[i];
+		stats.class_allocations[i] = small_alloc_retired_class_allocations[i];
+	}
+
+	for (SmallAllocHeap *heap = small_alloc_heaps; heap; heap = heap->next) {
+		bytes_in_use += heap->bytes_in_use.load(std::memory_order_relaxed);
+		stats.cross_thread_frees += heap->cross_thread_frees.load(std::memory_order_relaxed);
+		for (int i = 0; i < SMALL_ALLOC_CLASS_COUNT; i++) {
+			stats.class_allocations[i] += heap->class_allocations[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	// Heaps are read while they change, so the sum may briefly be off.
+	stats.bytes_in_use = MAX(bytes_in_use, 0);
+	stats.bytes_reserved = small_alloc_bytes_reserved;
+#endif
+
+	return stats;
+}
+
+void Memory::release_thread_cache() {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	SmallAllocHeap *heap = small_alloc_heap;
+	if (!heap) {
+		return;
+	}
+	small_alloc_heap = nullptr;
+
+	// Give the free objects back to their spans, they are collected by whoever adopts them.
+	for (int i = 0; i < SMALL_ALLOC_CLASS_COUNT; i++) {
+		void *object = heap->free_list[i];
+		while (object) {
+			void *next = *(void **)object;
+			_small_alloc_push_remote(_small_alloc_find_span(object), object);
+			object = next;
+		}
+	}
+
+	{
+		MutexLock lock(small_alloc_mutex);
+
+		for (int i = 0; i < SMALL_ALLOC_CLASS_COUNT; i++) {
+			SmallAllocSpan *span = heap->spans[i];
+			while (span) {
+				SmallAllocSpan *next = span->next;
+				span->owner.store(0, std::memory_order_relaxed);
+				span->next = small_alloc_orphan_spans[i];
+				small_alloc_orphan_spans[i] = span;
+				span = next;
+			}
+			small_alloc_retired_class_allocations[i] += heap->class_allocations[i].load(std::memory_order_relaxed);
+		}
+		small_alloc_retired_bytes_in_use += heap->bytes_in_use.load(std::memory_order_relaxed);
+		small_alloc_retired_cross_thread_frees += heap->cross_thread_frees.load(std::memory_order_relaxed);
+
+		if (heap->prev) {
+			heap->prev->next = heap->next;
+		} else {
+			small_alloc_heaps = heap->next;
+		}
+		if (heap->next) {
+			heap->next->prev = heap->prev;
+		}
+	}
+
+	heap->~SmallAllocHeap();
+	free(heap);
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	color = 1;
 	left = this;
@@ -51,6 +51,18 @@ class Memory {
 	static SafeNumeric<uint64_t> alloc_count;
 
 public:
+	enum {
+		SMALL_ALLOC_CLASS_COUNT = 20,
+	};
+
+	struct SmallAllocStats {
+		uint32_t class_sizes[SMALL_ALLOC_CLASS_COUNT];
+		uint64_t class_allocations[SMALL_ALLOC_CLASS_COUNT];
+		uint64_t bytes_in_use;
+		uint64_t bytes_reserved;
+		uint64_t cross_thread_frees;
+	};
+
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
@@ -58,6 +70,11 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	static bool is_small_allocator_enabled();
+	static SmallAllocStats get_small_alloc_stats();
+	// Done automatically when a thread exits. A thread allocating afterwards gets a new cache.
+	static void release_thread_cache();
 };
 
 class DefaultAllocator {
@@ -33,6 +33,8 @@
 
 #include "thread.h"
 
+#include "core/command_queue_mt.h"
+#include "core/message_queue.h"
 #include "core/script_language.h"
 
 #if !defined(NO_THREADS)
@@ -80,6 +82,8 @@ void Thread::callback(Thread *p_self, const Settings &p_settings, Callback p_cal
 	if (term_func) {
 		term_func();
 	}
+	CommandQueueMT::release_thread_staging();
+	MessageQueue::release_thread_producer();
 }
 
 void Thread::start(Thread::Callback p_callback, void *p_user, const Settings &p_settings) {
@@ -0,0 +1,256 @@
+/*************************************************************************/
+/*  thread_work_pool.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "thread_work_pool.h"
+
+#include "core/os/os.h"
+
+ThreadWorkPool *ThreadWorkPool::singleton = nullptr;
+
+void ThreadWorkPool::_thread_function(void *p_user) {
+	ThreadWorkPool *pool = (ThreadWorkPool *)p_user;
+	Thread::set_name("ThreadWorkPool");
+
+	while (true) {
+		pool->task_semaphore.wait();
+		if (pool->exit_threads.is_set()) {
+			break;
+		}
+		// Drain everything that is pending, extra wake ups will find nothing to do.
+		while (pool->_enter_next_group()) {
+		}
+	}
+}
+
+ThreadWorkPool::GroupID ThreadWorkPool::_add_group(Group *p_group) {
+	uint32_t chunks = (p_group->elements + p_group->grain - 1) / p_group->grain;
+	uint32_t wake_ups = MIN(chunks, threads.size());
+	if (p_group->max_threads) {
+		wake_ups = MIN(wake_ups, p_group->max_threads);
+	}
+
+	mutex.lock();
+	GroupID id = ++last_group_id;
+	p_group->self = id;
+	groups[id] = p_group;
+	if (p_group->elements == 0) {
+		p_group->dispatched = true;
+		p_group->completed = true;
+		p_group->done_semaphore.post();
+	} else {
+		pending_groups.push_back(p_group);
+	}
+	mutex.unlock();
+
+	for (uint32_t i = 0; i < wake_ups; i++) {
+		task_semaphore.post();
+	}
+
+	return id;
+}
+
+bool ThreadWorkPool::_enter_next_group() {
+	Group *group = nullptr;
+
+	mutex.lock();
+	for (uint32_t i = 0; i < pending_groups.size(); i++) {
+		Group *g = pending_groups[i];
+		if (!g->dispatched && (g->max_threads == 0 || g->active_threads < g->max_threads)) {
+			g->active_threads++;
+			group = g;
+			break;
+		}
+	}
+	mutex.unlock();
+
+	if (!group) {
+		return false;
+	}
+
+	_process_group(group);
+	_leave_group(group);
+	return true;
+}
+
+void ThreadWorkPool::_process_group(Group *p_group) {
+	const uint32_t elements = p_group->elements;
+	const uint32_t grain = p_group->grain;
+
+	while (!p_group->cancelled.is_set()) {
+		uint32_t from = p_group->index.postadd(grain);
+		if (from >= elements) {
+			break;
+		}
+		uint32_t to = MIN(from + grain, elements);
+
+		if (p_group->template_userdata) {
+			for (uint32_t i = from; i < to; i++) {
+				p_group->template_userdata->callback_indexed(i);
+			}
+		} else {
+			for (uint32_t i = from; i < to; i++) {
+				p_group->function(p_group->userdata, i);
+			}
+		}
+	}
+}
+
+void ThreadWorkPool::_leave_group(Group *p_group) {
+	mutex.lock();
+	p_group->active_threads--;
+	if (!p_group->dispatched) {
+		// This thread only leaves once there is nothing left to hand out.
+		p_group->dispatched = true;
+		pending_groups.erase(p_group);
+	}
+	if (p_group->active_threads == 0 && !p_group->completed) {
+		p_group->completed = true;
+		p_group->done_semaphore.post();
+	}
+	mutex.unlock();
+}
+
+ThreadWorkPool::GroupID ThreadWorkPool::add_group_task(GroupFunction p_function, void *p_userdata, uint32_t p_elements, uint32_t p_grain, uint32_t p_max_threads) {
+	ERR_FAIL_NULL_V(p_function, INVALID_GROUP_ID);
+
+	Group *group = memnew(Group);
+	group->function = p_function;
+	group->userdata = p_userdata;
+	group->elements = p_elements;
+	group->grain = MAX(1u, p_grain);
+	group->max_threads = p_max_threads;
+	return _add_group(group);
+}
+
+bool ThreadWorkPool::is_group_task_completed(GroupID p_group) const {
+	MutexLock lock(mutex);
+	Group *const *group = groups.getptr(p_group);
+	ERR_FAIL_COND_V_MSG(!group, false, "Invalid group task ID: " + itos(p_group) + ".");
+	return (*group)->completed;
+}
+
+void ThreadWorkPool::cancel_group_task(GroupID p_group) {
+	MutexLock lock(mutex);
+	Group *const *group = groups.getptr(p_group);
+	ERR_FAIL_COND_MSG(!group, "Invalid group task ID: " + itos(p_group) + ".");
+	(*group)->cancelled.set();
+}
+
+void ThreadWorkPool::wait_for_group_task_completion(GroupID p_group) {
+	mutex.lock();
+	Group **groupp = groups.getptr(p_group);
+	if (!groupp) {
+		mutex.unlock();
+		ERR_FAIL_MSG("Invalid group task ID: " + itos(p_group) + ".");
+	}
+	Group *group = *groupp;
+	if (group->waited) {
+		mutex.unlock();
+		ERR_FAIL_MSG("Group task " + itos(p_group) + " is already being waited on.");
+	}
+	group->waited = true;
+
+	bool participate = !group->dispatched && (group->max_threads == 0 || group->active_threads < group->max_threads);
+	if (participate) {
+		group->active_threads++;
+	}
+	mutex.unlock();
+
+	if (participate) {
+		_process_group(group);
+		_leave_group(group);
+	}
+
+	group->done_semaphore.wait();
+
+	mutex.lock();
+	groups.erase(p_group);
+	mutex.unlock();
+
+	if (group->template_userdata) {
+		memdelete(group->template_userdata);
+	}
+	memdelete(group);
+}
+
+void ThreadWorkPool::init(int p_thread_count) {
+	ERR_FAIL_COND_MSG(threads.size() > 0, "ThreadWorkPool is already initialized.");
+
+#ifdef NO_THREADS
+	p_thread_count = 0;
+#else
+	if (p_thread_count < 0) {
+		// The thread waiting for a group task works on it too, so leave it a core.
+		p_thread_count = MAX(1, OS::get_singleton()->get_processor_count() - 1);
+	}
+#endif
+
+	exit_threads.clear();
+	for (int i = 0; i < p_thread_count; i++) {
+		Thread *thread = memnew(Thread);
+		thread->start(&ThreadWorkPool::_thread_function, this);
+		threads.push_back(thread);
+	}
+}
+
+void ThreadWorkPool::finish() {
+	exit_threads.set();
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		task_semaphore.post();
+	}
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i]->wait_to_finish();
+		memdelete(threads[i]);
+	}
+	threads.clear();
+
+	if (groups.size()) {
+		WARN_PRINT(itos(groups.size()) + " group task(s) were never waited on, releasing them.");
+		const GroupID *k = nullptr;
+		while ((k = groups.next(k))) {
+			Group *group = groups[*k];
+			if (group->template_userdata) {
+				memdelete(group->template_userdata);
+			}
+			memdelete(group);
+		}
+		groups.clear();
+		pending_groups.clear();
+	}
+}
+
+ThreadWorkPool::ThreadWorkPool() {
+	singleton = this;
+}
+
+ThreadWorkPool::~ThreadWorkPool() {
+	finish();
+	singleton = nullptr;
+}
@@ -0,0 +1,175 @@
+/*************************************************************************/
+/*  thread_work_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "core/hash_map.h"
+#include "core/local_vector.h"
+#include "core/os/memory.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+// Persistent, engine-wide pool of worker threads.
+//
+// Work is submitted as group tasks: a callback that is invoked once for every
+// index in [0, elements). Indices are handed out in chunks of `grain` elements
+// through an atomic counter, so idle workers keep pulling chunks from whichever
+// group still has work left. The thread waiting for a group also pulls chunks
+// from it, so waiting from inside a group task (nested parallelism) or with no
+// worker threads at all never deadlocks.
+//
+// Every group task must be waited on exactly once, which releases it.
+
+class ThreadWorkPool {
+public:
+	typedef int64_t GroupID;
+	enum {
+		INVALID_GROUP_ID = -1
+	};
+
+	typedef void (*GroupFunction)(void *p_userdata, uint32_t p_index);
+
+private:
+	struct BaseTemplateUserdata {
+		virtual void callback_indexed(uint32_t p_index) = 0;
+		virtual ~BaseTemplateUserdata() {}
+	};
+
+	template <class C, class M, class U>
+	struct GroupUserdata : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback_indexed(uint32_t p_index) {
+			(instance->*method)(p_index, userdata);
+		}
+	};
+
+	struct Group {
+		GroupID self = INVALID_GROUP_ID;
+		GroupFunction function = nullptr;
+		void *userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+
+		uint32_t elements = 0;
+		uint32_t grain = 1;
+		uint32_t max_threads = 0; // 0 means no limit.
+
+		SafeNumeric<uint32_t> index; // Next element to hand out.
+		SafeFlag cancelled;
+
+		// Protected by the pool mutex.
+		uint32_t active_threads = 0;
+		bool dispatched = false; // No more chunks will be handed out.
+		bool completed = false; // Dispatched, and no thread is processing it any more.
+		bool waited = false;
+
+		Semaphore done_semaphore;
+	};
+
+	static ThreadWorkPool *singleton;
+
+	BinaryMutex mutex;
+	Semaphore task_semaphore;
+	SafeFlag exit_threads;
+
+	LocalVector<Thread *> threads;
+	HashMap<GroupID, Group *> groups;
+	LocalVector<Group *> pending_groups; // Groups that still have chunks to hand out.
+	GroupID last_group_id = 0;
+
+	static void _thread_function(void *p_user);
+
+	GroupID _add_group(Group *p_group);
+	bool _enter_next_group();
+	void _process_group(Group *p_group);
+	void _leave_group(Group *p_group);
+
+public:
+	static ThreadWorkPool *get_singleton() { return singleton; }
+
+	// Adds a group task that calls p_function(p_userdata, index) for every index.
+	// p_max_threads limits how many threads (including the waiting one) work on the group at once, 0 means no limit.
+	GroupID add_group_task(GroupFunction p_function, void *p_userdata, uint32_t p_elements, uint32_t p_grain = 1, uint32_t p_max_threads = 0);
+
+	// Same as add_group_task(), calling (p_instance->*p_method)(index, p_userdata) instead.
+	template <class C, class M, class U>
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, uint32_t p_elements, uint32_t p_grain = 1, uint32_t p_max_threads = 0) {
+		GroupUserdata<C, M, U> *ud = memnew((GroupUserdata<C, M, U>));
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+
+		Group *group = memnew(Group);
+		group->template_userdata = ud;
+		group->elements = p_elements;
+		group->grain = MAX(1u, p_grain);
+		group->max_threads = p_max_threads;
+		return _add_group(group);
+	}
+
+	// Returns true once every handed out chunk of the group has been processed.
+	bool is_group_task_completed(GroupID p_group) const;
+	// Stops handing out chunks of the group; chunks already being processed run to completion.
+	// The group must still be waited on.
+	void cancel_group_task(GroupID p_group);
+	// Helps processing the group until it is completed, then releases it.
+	void wait_for_group_task_completion(GroupID p_group);
+
+	// Parallel for: processes every index, using the calling thread as well, and returns when done.
+	template <class C, class M, class U>
+	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, uint32_t p_grain = 1, uint32_t p_max_threads = 0) {
+		if (p_elements == 0) {
+			return;
+		}
+		if (threads.size() == 0 || p_elements <= p_grain || p_max_threads == 1) {
+			// Not worth the dispatch.
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+			return;
+		}
+		wait_for_group_task_completion(add_template_group_task(p_instance, p_method, p_userdata, p_elements, p_grain, p_max_threads));
+	}
+
+	// Number of worker threads, not counting the threads that wait for group tasks.
+	uint32_t get_thread_count() const { return threads.size(); }
+
+	void init(int p_thread_count = -1);
+	void finish();
+
+	ThreadWorkPool();
+	~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -35,6 +35,7 @@
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/os/thread_work_pool.h"
 #include "core/safe_refcount.h"
 
 template <class C, class U>
@@ -66,8 +67,21 @@ void process_array_thread(void *ud) {
 
 // p_num_threads is the number of logical CPU cores to use (0 = use all logical CPU cores available).
 // Negative values subtract from the total number of logical CPU cores available.
+// When the engine-wide ThreadWorkPool is running, the work is dispatched to it instead of spawning threads.
 template <class C, class M, class U>
 void thread_process_array(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, int p_num_threads = 0) {
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0) {
+		uint32_t max_threads = 0;
+		if (p_num_threads < 0) {
+			max_threads = MAX(1, OS::get_singleton()->get_processor_count() + p_num_threads);
+		} else {
+			max_threads = p_num_threads;
+		}
+		pool->do_work(p_elements, p_instance, p_method, p_userdata, 1, max_threads);
+		return;
+	}
+
 	ThreadArrayProcessData<C, U> data;
 	data.method = p_method;
 	data.instance = p_instance;
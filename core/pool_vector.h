@@ -52,26 +52,39 @@ struct MemoryPool {
 		PoolAllocator::ID pool_id;
 		size_t size;
 
-		Alloc *free_list;
-
 		Alloc() :
 				lock(0),
 				mem(nullptr),
 				pool_id(POOL_ALLOCATOR_INVALID_ID),
-				size(0),
-				free_list(nullptr) {
+				size(0) {
 		}
 	};
 
-	static Alloc *allocs;
-	static Alloc *free_list;
-	static uint32_t alloc_count;
-	static uint32_t allocs_used;
-	static Mutex alloc_mutex;
-	static size_t total_memory;
-	static size_t max_memory;
+	static SafeNumeric<uint32_t> allocs_used;
+	static SafeNumeric<uint64_t> total_memory;
+	static SafeNumeric<uint64_t> max_memory;
+
+	// Allocs are created and destroyed on demand, so arrays on different threads never contend.
+	_FORCE_INLINE_ static Alloc *alloc_create() {
+		allocs_used.increment();
+		Alloc *alloc = memnew(Alloc);
+		alloc->refcount.init();
+		return alloc;
+	}
+
+	_FORCE_INLINE_ static void alloc_destroy(Alloc *p_alloc) {
+		memdelete(p_alloc);
+		allocs_used.decrement();
+	}
+
+	_FORCE_INLINE_ static void memory_changed(size_t p_old_size, size_t p_new_size) {
+#ifdef DEBUG_ENABLED
+		// Unsigned wraparound makes this a subtraction when shrinking.
+		uint64_t new_total = total_memory.add((uint64_t)p_new_size - (uint64_t)p_old_size);
+		max_memory.exchange_if_greater(new_total);
+#endif
+	}
 
-	static void setup(uint32_t p_max_allocs = (1 << 16));
 	static void cleanup();
 };
 
@@ -93,34 +106,13 @@ class PoolVector {
 
 		//must allocate something
 
-		MemoryPool::alloc_mutex.lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex.unlock();
-			ERR_FAIL_MSG("All memory pool allocations are in use, can't COW.");
-		}
-
 		MemoryPool::Alloc *old_alloc = alloc;
 
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
-
 		//copy the alloc data
+		alloc = MemoryPool::alloc_create();
 		alloc->size = old_alloc->size;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		alloc->lock.set(0);
 
-#ifdef DEBUG_ENABLED
-		MemoryPool::total_memory += alloc->size;
-		if (MemoryPool::total_memory > MemoryPool::max_memory) {
-			MemoryPool::max_memory = MemoryPool::total_memory;
-		}
-#endif
-
-		MemoryPool::alloc_mutex.unlock();
+		MemoryPool::memory_changed(0, alloc->size);
 
 		if (MemoryPool::memory_pool) {
 		} else {
@@ -144,11 +136,7 @@ class PoolVector {
 		if (old_alloc->refcount.unref()) {
 			//this should never happen but..
 
-#ifdef DEBUG_ENABLED
-			MemoryPool::alloc_mutex.lock();
-			MemoryPool::total_memory -= old_alloc->size;
-			MemoryPool::alloc_mutex.unlock();
-#endif
+			MemoryPool::memory_changed(old_alloc->size, 0);
 
 			{
 				Write w;
@@ -167,14 +155,7 @@ class PoolVector {
 				//if some resize
 			} else {
 				memfree(old_alloc->mem);
-				old_alloc->mem = nullptr;
-				old_alloc->size = 0;
-
-				MemoryPool::alloc_mutex.lock();
-				old_alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = old_alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex.unlock();
+				MemoryPool::alloc_destroy(old_alloc);
 			}
 		}
 	}
@@ -221,11 +202,7 @@ class PoolVector {
 			}
 		}
 
-#ifdef DEBUG_ENABLED
-		MemoryPool::alloc_mutex.lock();
-		MemoryPool::total_memory -= alloc->size;
-		MemoryPool::alloc_mutex.unlock();
-#endif
+		MemoryPool::memory_changed(alloc->size, 0);
 
 		if (MemoryPool::memory_pool) {
 			//resize memory pool
@@ -233,14 +210,7 @@ class PoolVector {
 			//if some resize
 		} else {
 			memfree(alloc->mem);
-			alloc->mem = nullptr;
-			alloc->size = 0;
-
-			MemoryPool::alloc_mutex.lock();
-			alloc->free_list = MemoryPool::free_list;
-			MemoryPool::free_list = alloc;
-			MemoryPool::allocs_used--;
-			MemoryPool::alloc_mutex.unlock();
+			MemoryPool::alloc_destroy(alloc);
 		}
 
 		alloc = nullptr;
@@ -506,23 +476,7 @@ Error PoolVector<T>::resize(int p_size) {
 		}
 
 		//must allocate something
-		MemoryPool::alloc_mutex.lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex.unlock();
-			ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "All memory pool allocations are in use.");
-		}
-
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
-
-		//cleanup the alloc
-		alloc->size = 0;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		MemoryPool::alloc_mutex.unlock();
+		alloc = MemoryPool::alloc_create();
 
 	} else {
 		ERR_FAIL_COND_V_MSG(alloc->lock.get() > 0, ERR_LOCKED, "Can't resize PoolVector if locked."); //can't resize if locked!
@@ -541,15 +495,7 @@ Error PoolVector<T>::resize(int p_size) {
 
 	_copy_on_write(); // make it unique
 
-#ifdef DEBUG_ENABLED
-	MemoryPool::alloc_mutex.lock();
-	MemoryPool::total_memory -= alloc->size;
-	MemoryPool::total_memory += new_size;
-	if (MemoryPool::total_memory > MemoryPool::max_memory) {
-		MemoryPool::max_memory = MemoryPool::total_memory;
-	}
-	MemoryPool::alloc_mutex.unlock();
-#endif
+	MemoryPool::memory_changed(alloc->size, new_size);
 
 	int cur_elements = alloc->size / sizeof(T);
 
@@ -589,14 +535,8 @@ Error PoolVector<T>::resize(int p_size) {
 		} else {
 			if (new_size == 0) {
 				memfree(alloc->mem);
-				alloc->mem = nullptr;
-				alloc->size = 0;
-
-				MemoryPool::alloc_mutex.lock();
-				alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex.unlock();
+				MemoryPool::alloc_destroy(alloc);
+				alloc = nullptr;
 
 			} else {
 				alloc->mem = memrealloc(alloc->mem, new_size);
@@ -99,8 +99,6 @@ extern void register_variant_methods();
 extern void unregister_variant_methods();
 
 void register_core_types() {
-	MemoryPool::setup();
-
 	StringName::setup();
 
 	register_global_constants();
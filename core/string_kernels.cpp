@@ -0,0 +1,604 @@
+/*************************************************************************/
+/*  string_kernels.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "string_kernels.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_KERNELS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(CharType) == 2 || sizeof(CharType) == 4, "CharType must be 16 or 32 bits wide.");
+
+#define CHAR_BYTES int(sizeof(CharType))
+// movemask_epi8 sets CHAR_BYTES bits per matching character.
+#define CHAR_BITS_MASK ((1u << sizeof(CharType)) - 1)
+
+static _FORCE_INLINE_ int _offset(int p_result, int p_from) {
+	return p_result < 0 ? -1 : p_result + p_from;
+}
+
+static _FORCE_INLINE_ bool _is_ascii(CharType p_char) {
+	return uint32_t(p_char) < 0x80;
+}
+
+/* Scalar */
+
+static int find_char_scalar(const CharType *p_str, int p_len, CharType p_char) {
+	for (int i = 0; i < p_len; i++) {
+		if (p_str[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static int find_scalar(const CharType *p_str, int p_len, const CharType *p_key, int p_key_len) {
+	const CharType first = p_key[0];
+	for (int i = 0; i <= p_len - p_key_len; i++) {
+		if (p_str[i] != first) {
+			continue;
+		}
+		int j = 1;
+		while (j < p_key_len && p_str[i + j] == p_key[j]) {
+			j++;
+		}
+		if (j == p_key_len) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static int find_ascii_nocase_scalar(const CharType *p_str, int p_len, CharType p_lower) {
+	const CharType upper = (p_lower >= 'a' && p_lower <= 'z') ? p_lower - ('a' - 'A') : p_lower;
+	for (int i = 0; i < p_len; i++) {
+		const CharType c = p_str[i];
+		if (c == p_lower || c == upper || !_is_ascii(c)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static bool equal_scalar(const CharType *p_a, const CharType *p_b, int p_len) {
+	for (int i = 0; i < p_len; i++) {
+		if (p_a[i] != p_b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static int skip_lower_scalar(const CharType *p_str, int p_len) {
+	int i = 0;
+	while (i < p_len && _is_ascii(p_str[i]) && !(p_str[i] >= 'A' && p_str[i] <= 'Z')) {
+		i++;
+	}
+	return i;
+}
+
+static int lower_ascii_scalar(const CharType *p_src, CharType *p_dst, int p_len) {
+	int i = 0;
+	for (; i < p_len; i++) {
+		const CharType c = p_src[i];
+		if (!_is_ascii(c)) {
+			break;
+		}
+		p_dst[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+	}
+	return i;
+}
+
+static int ascii_length_scalar(const CharType *p_str, int p_len) {
+	int i = 0;
+	while (i < p_len && _is_ascii(p_str[i])) {
+		i++;
+	}
+	return i;
+}
+
+static int encode_ascii_scalar(const CharType *p_src, uint8_t *p_dst, int p_len) {
+	int i = 0;
+	for (; i < p_len; i++) {
+		if (!_is_ascii(p_src[i])) {
+			break;
+		}
+		p_dst[i] = uint8_t(p_src[i]);
+	}
+	return i;
+}
+
+static int ascii_length_utf8_scalar(const uint8_t *p_str, int p_len) {
+	int i = 0;
+	while (i < p_len && p_str[i] && p_str[i] < 0x80) {
+		i++;
+	}
+	return i;
+}
+
+static int decode_ascii_scalar(const uint8_t *p_src, CharType *p_dst, int p_len) {
+	int i = 0;
+	for (; i < p_len; i++) {
+		if (p_src[i] >= 0x80) {
+			break;
+		}
+		p_dst[i] = p_src[i];
+	}
+	return i;
+}
+
+static const StringKernels::Table scalar_table = {
+	StringKernels::LEVEL_SCALAR,
+	find_char_scalar,
+	find_scalar,
+	find_ascii_nocase_scalar,
+	equal_scalar,
+	skip_lower_scalar,
+	lower_ascii_scalar,
+	ascii_length_scalar,
+	encode_ascii_scalar,
+	ascii_length_utf8_scalar,
+	decode_ascii_scalar,
+};
+
+#ifdef STRING_KERNELS_X86
+
+static _FORCE_INLINE_ int _ctz(uint32_t p_mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, p_mask);
+	return int(index);
+#else
+	return __builtin_ctz(p_mask);
+#endif
+}
+
+/* SSE2, part of the x86_64 baseline */
+
+#define SSE2_CHARS (16 / CHAR_BYTES)
+
+static _FORCE_INLINE_ __m128i _sse2_set1(int p_value) {
+	return sizeof(CharType) == 4 ? _mm_set1_epi32(p_value) : _mm_set1_epi16(short(p_value));
+}
+
+static _FORCE_INLINE_ __m128i _sse2_cmpeq(__m128i p_a, __m128i p_b) {
+	return sizeof(CharType) == 4 ? _mm_cmpeq_epi32(p_a, p_b) : _mm_cmpeq_epi16(p_a, p_b);
+}
+
+static _FORCE_INLINE_ __m128i _sse2_cmpgt(__m128i p_a, __m128i p_b) {
+	return sizeof(CharType) == 4 ? _mm_cmpgt_epi32(p_a, p_b) : _mm_cmpgt_epi16(p_a, p_b);
+}
+
+static _FORCE_INLINE_ __m128i _sse2_load(const CharType *p_ptr) {
+	return _mm_loadu_si128((const __m128i *)p_ptr);
+}
+
+// All ones in the lanes that hold ASCII characters.
+static _FORCE_INLINE_ __m128i _sse2_ascii(__m128i p_chars) {
+	return _sse2_cmpeq(_mm_and_si128(p_chars, _sse2_set1(~0x7F)), _mm_setzero_si128());
+}
+
+// All ones in the lanes that hold 'A' to 'Z'; only meaningful for ASCII lanes.
+static _FORCE_INLINE_ __m128i _sse2_upper(__m128i p_chars) {
+	return _mm_and_si128(_sse2_cmpgt(p_chars, _sse2_set1('A' - 1)), _sse2_cmpgt(_sse2_set1('Z' + 1), p_chars));
+}
+
+static int find_char_sse2(const CharType *p_str, int p_len, CharType p_char) {
+	const __m128i needle = _sse2_set1(p_char);
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		const uint32_t mask = _mm_movemask_epi8(_sse2_cmpeq(_sse2_load(p_str + i), needle));
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return _offset(find_char_scalar(p_str + i, p_len - i, p_char), i);
+}
+
+// Compares the first and last key characters against SSE2_CHARS positions at
+// once and only verifies the rest of the key where both match.
+static int find_sse2(const CharType *p_str, int p_len, const CharType *p_key, int p_key_len) {
+	if (p_key_len == 1) {
+		return find_char_sse2(p_str, p_len, p_key[0]);
+	}
+	const int positions = p_len - p_key_len + 1;
+	const __m128i first = _sse2_set1(p_key[0]);
+	const __m128i last = _sse2_set1(p_key[p_key_len - 1]);
+	int i = 0;
+	for (; i + SSE2_CHARS <= positions; i += SSE2_CHARS) {
+		const __m128i match_first = _sse2_cmpeq(_sse2_load(p_str + i), first);
+		const __m128i match_last = _sse2_cmpeq(_sse2_load(p_str + i + p_key_len - 1), last);
+		uint32_t mask = _mm_movemask_epi8(_mm_and_si128(match_first, match_last));
+		while (mask) {
+			const int bit = _ctz(mask);
+			const int pos = i + bit / CHAR_BYTES;
+			if (memcmp(p_str + pos + 1, p_key + 1, (p_key_len - 2) * sizeof(CharType)) == 0) {
+				return pos;
+			}
+			mask &= ~(CHAR_BITS_MASK << bit);
+		}
+	}
+	if (positions <= i) {
+		return -1;
+	}
+	return _offset(find_scalar(p_str + i, p_len - i, p_key, p_key_len), i);
+}
+
+static int find_ascii_nocase_sse2(const CharType *p_str, int p_len, CharType p_lower) {
+	const CharType upper = (p_lower >= 'a' && p_lower <= 'z') ? p_lower - ('a' - 'A') : p_lower;
+	const __m128i lower_chars = _sse2_set1(p_lower);
+	const __m128i upper_chars = _sse2_set1(upper);
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		const __m128i chars = _sse2_load(p_str + i);
+		const __m128i match = _mm_or_si128(_sse2_cmpeq(chars, lower_chars), _sse2_cmpeq(chars, upper_chars));
+		const uint32_t mask = _mm_movemask_epi8(match) | (_mm_movemask_epi8(_sse2_ascii(chars)) ^ 0xFFFF);
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return _offset(find_ascii_nocase_scalar(p_str + i, p_len - i, p_lower), i);
+}
+
+static bool equal_sse2(const CharType *p_a, const CharType *p_b, int p_len) {
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		if (_mm_movemask_epi8(_sse2_cmpeq(_sse2_load(p_a + i), _sse2_load(p_b + i))) != 0xFFFF) {
+			return false;
+		}
+	}
+	return equal_scalar(p_a + i, p_b + i, p_len - i);
+}
+
+static int skip_lower_sse2(const CharType *p_str, int p_len) {
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		const __m128i chars = _sse2_load(p_str + i);
+		const uint32_t mask = _mm_movemask_epi8(_mm_andnot_si128(_sse2_upper(chars), _sse2_ascii(chars))) ^ 0xFFFF;
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return i + skip_lower_scalar(p_str + i, p_len - i);
+}
+
+static int lower_ascii_sse2(const CharType *p_src, CharType *p_dst, int p_len) {
+	const __m128i offset = _sse2_set1('a' - 'A');
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		const __m128i chars = _sse2_load(p_src + i);
+		if (_mm_movemask_epi8(_sse2_ascii(chars)) != 0xFFFF) {
+			break;
+		}
+		const __m128i add = _mm_and_si128(_sse2_upper(chars), offset);
+		const __m128i lowered = sizeof(CharType) == 4 ? _mm_add_epi32(chars, add) : _mm_add_epi16(chars, add);
+		_mm_storeu_si128((__m128i *)(p_dst + i), lowered);
+	}
+	return i + lower_ascii_scalar(p_src + i, p_dst + i, p_len - i);
+}
+
+static int ascii_length_sse2(const CharType *p_str, int p_len) {
+	int i = 0;
+	for (; i + SSE2_CHARS <= p_len; i += SSE2_CHARS) {
+		const uint32_t mask = _mm_movemask_epi8(_sse2_ascii(_sse2_load(p_str + i))) ^ 0xFFFF;
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return i + ascii_length_scalar(p_str + i, p_len - i);
+}
+
+// Packs 16 characters into 16 bytes per iteration.
+static int encode_ascii_sse2(const CharType *p_src, uint8_t *p_dst, int p_len) {
+	const __m128i high = _sse2_set1(~0x7F);
+	int i = 0;
+	for (; i + 16 <= p_len; i += 16) {
+		__m128i bytes;
+		if (sizeof(CharType) == 4) {
+			const __m128i c0 = _sse2_load(p_src + i);
+			const __m128i c1 = _sse2_load(p_src + i + 4);
+			const __m128i c2 = _sse2_load(p_src + i + 8);
+			const __m128i c3 = _sse2_load(p_src + i + 12);
+			const __m128i any = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+			if (_mm_movemask_epi8(_sse2_cmpeq(_mm_and_si128(any, high), _mm_setzero_si128())) != 0xFFFF) {
+				break;
+			}
+			bytes = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+		} else {
+			const __m128i c0 = _sse2_load(p_src + i);
+			const __m128i c1 = _sse2_load(p_src + i + 8);
+			const __m128i any = _mm_or_si128(c0, c1);
+			if (_mm_movemask_epi8(_sse2_cmpeq(_mm_and_si128(any, high), _mm_setzero_si128())) != 0xFFFF) {
+				break;
+			}
+			bytes = _mm_packus_epi16(c0, c1);
+		}
+		_mm_storeu_si128((__m128i *)(p_dst + i), bytes);
+	}
+	return i + encode_ascii_scalar(p_src + i, p_dst + i, p_len - i);
+}
+
+static int ascii_length_utf8_sse2(const uint8_t *p_str, int p_len) {
+	int i = 0;
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i bytes = _mm_loadu_si128((const __m128i *)(p_str + i));
+		const uint32_t mask = _mm_movemask_epi8(bytes) | _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128()));
+		if (mask) {
+			return i + _ctz(mask);
+		}
+	}
+	return i + ascii_length_utf8_scalar(p_str + i, p_len - i);
+}
+
+// Widens 16 bytes into 16 characters per iteration.
+static int decode_ascii_sse2(const uint8_t *p_src, CharType *p_dst, int p_len) {
+	const __m128i zero = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i bytes = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(bytes)) {
+			break;
+		}
+		const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+		const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+		__m128i *dst = (__m128i *)(p_dst + i);
+		if (sizeof(CharType) == 4) {
+			_mm_storeu_si128(dst, _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+		} else {
+			_mm_storeu_si128(dst, low);
+			_mm_storeu_si128(dst + 1, high);
+		}
+	}
+	return i + decode_ascii_scalar(p_src + i, p_dst + i, p_len - i);
+}
+
+static const StringKernels::Table sse2_table = {
+	StringKernels::LEVEL_SSE2,
+	find_char_sse2,
+	find_sse2,
+	find_ascii_nocase_sse2,
+	equal_sse2,
+	skip_lower_sse2,
+	lower_ascii_sse2,
+	ascii_length_sse2,
+	encode_ascii_sse2,
+	ascii_length_utf8_sse2,
+	decode_ascii_sse2,
+};
+
+/* AVX2, only called after checking the CPU supports it */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AVX2_FUNC __attribute__((target("avx2")))
+#else
+#define AVX2_FUNC
+#endif
+
+#define AVX2_CHARS (32 / CHAR_BYTES)
+
+static _FORCE_INLINE_ AVX2_FUNC __m256i _avx2_set1(int p_value) {
+	return sizeof(CharType) == 4 ? _mm256_set1_epi32(p_value) : _mm256_set1_epi16(short(p_value));
+}
+
+static _FORCE_INLINE_ AVX2_FUNC __m256i _avx2_cmpeq(__m256i p_a, __m256i p_b) {
+	return sizeof(CharType) == 4 ? _mm256_cmpeq_epi32(p_a, p_b) : _mm256_cmpeq_epi16(p_a, p_b);
+}
+
+static _FORCE_INLINE_ AVX2_FUNC __m256i _avx2_cmpgt(__m256i p_a, __m256i p_b) {
+	return sizeof(CharType) == 4 ? _mm256_cmpgt_epi32(p_a, p_b) : _mm256_cmpgt_epi16(p_a, p_b);
+}
+
+static _FORCE_INLINE_ AVX2_FUNC __m256i _avx2_load(const CharType *p_ptr) {
+	return _mm256_loadu_si256((const __m256i *)p_ptr);
+}
+
+static _FORCE_INLINE_ AVX2_FUNC __m256i _avx2_ascii(__m256i p_chars) {
+	return _avx2_cmpeq(_mm256_and_si256(p_chars, _avx2_set1(~0x7F)), _mm256_setzero_si256());
+}
+
+static AVX2_FUNC int find_char_avx2(const CharType *p_str, int p_len, CharType p_char) {
+	const __m256i needle = _avx2_set1(p_char);
+	int i = 0;
+	for (; i + AVX2_CHARS <= p_len; i += AVX2_CHARS) {
+		const uint32_t mask = _mm256_movemask_epi8(_avx2_cmpeq(_avx2_load(p_str + i), needle));
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return _offset(find_char_sse2(p_str + i, p_len - i, p_char), i);
+}
+
+static AVX2_FUNC int find_avx2(const CharType *p_str, int p_len, const CharType *p_key, int p_key_len) {
+	if (p_key_len == 1) {
+		return find_char_avx2(p_str, p_len, p_key[0]);
+	}
+	const int positions = p_len - p_key_len + 1;
+	const __m256i first = _avx2_set1(p_key[0]);
+	const __m256i last = _avx2_set1(p_key[p_key_len - 1]);
+	int i = 0;
+	for (; i + AVX2_CHARS <= positions; i += AVX2_CHARS) {
+		const __m256i match_first = _avx2_cmpeq(_avx2_load(p_str + i), first);
+		const __m256i match_last = _avx2_cmpeq(_avx2_load(p_str + i + p_key_len - 1), last);
+		uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(match_first, match_last));
+		while (mask) {
+			const int bit = _ctz(mask);
+			const int pos = i + bit / CHAR_BYTES;
+			if (memcmp(p_str + pos + 1, p_key + 1, (p_key_len - 2) * sizeof(CharType)) == 0) {
+				return pos;
+			}
+			mask &= ~(CHAR_BITS_MASK << bit);
+		}
+	}
+	if (positions <= i) {
+		return -1;
+	}
+	return _offset(find_sse2(p_str + i, p_len - i, p_key, p_key_len), i);
+}
+
+static AVX2_FUNC int find_ascii_nocase_avx2(const CharType *p_str, int p_len, CharType p_lower) {
+	const CharType upper = (p_lower >= 'a' && p_lower <= 'z') ? p_lower - ('a' - 'A') : p_lower;
+	const __m256i lower_chars = _avx2_set1(p_lower);
+	const __m256i upper_chars = _avx2_set1(upper);
+	int i = 0;
+	for (; i + AVX2_CHARS <= p_len; i += AVX2_CHARS) {
+		const __m256i chars = _avx2_load(p_str + i);
+		const __m256i match = _mm256_or_si256(_avx2_cmpeq(chars, lower_chars), _avx2_cmpeq(chars, upper_chars));
+		const uint32_t mask = uint32_t(_mm256_movemask_epi8(match)) | ~uint32_t(_mm256_movemask_epi8(_avx2_ascii(chars)));
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return _offset(find_ascii_nocase_sse2(p_str + i, p_len - i, p_lower), i);
+}
+
+static AVX2_FUNC bool equal_avx2(const CharType *p_a, const CharType *p_b, int p_len) {
+	int i = 0;
+	for (; i + AVX2_CHARS <= p_len; i += AVX2_CHARS) {
+		if (uint32_t(_mm256_movemask_epi8(_avx2_cmpeq(_avx2_load(p_a + i), _avx2_load(p_b + i)))) != 0xFFFFFFFF) {
+			return false;
+		}
+	}
+	return equal_sse2(p_a + i, p_b + i, p_len - i);
+}
+
+static AVX2_FUNC int skip_lower_avx2(const CharType *p_str, int p_len) {
+	const __m256i below = _avx2_set1('A' - 1);
+	const __m256i above = _avx2_set1('Z' + 1);
+	int i = 0;
+	for (; i + AVX2_CHARS <= p_len; i += AVX2_CHARS) {
+		const __m256i chars = _avx2_load(p_str + i);
+		const __m256i upper = _mm256_and_si256(_avx2_cmpgt(chars, below), _avx2_cmpgt(above, chars));
+		const uint32_t mask = ~uint32_t(_mm256_movemask_epi8(_mm256_andnot_si256(upper, _avx2_ascii(chars))));
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return i + skip_lower_sse2(p_str + i, p_len - i);
+}
+
+static AVX2_FUNC int ascii_length_avx2(const CharType *p_str, int p_len) {
+	int i = 0;
+	for (; i + AVX2_CHARS <= p_len; i += AVX2_CHARS) {
+		const uint32_t mask = ~uint32_t(_mm256_movemask_epi8(_avx2_ascii(_avx2_load(p_str + i))));
+		if (mask) {
+			return i + _ctz(mask) / CHAR_BYTES;
+		}
+	}
+	return i + ascii_length_sse2(p_str + i, p_len - i);
+}
+
+static AVX2_FUNC int ascii_length_utf8_avx2(const uint8_t *p_str, int p_len) {
+	int i = 0;
+	for (; i + 32 <= p_len; i += 32) {
+		const __m256i bytes = _mm256_loadu_si256((const __m256i *)(p_str + i));
+		const uint32_t mask = uint32_t(_mm256_movemask_epi8(bytes)) | uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256())));
+		if (mask) {
+			return i + _ctz(mask);
+		}
+	}
+	return i + ascii_length_utf8_sse2(p_str + i, p_len - i);
+}
+
+// The conversions are bound by stores, so they keep the SSE2 versions.
+static const StringKernels::Table avx2_table = {
+	StringKernels::LEVEL_AVX2,
+	find_char_avx2,
+	find_avx2,
+	find_ascii_nocase_avx2,
+	equal_avx2,
+	skip_lower_avx2,
+	lower_ascii_sse2,
+	ascii_length_avx2,
+	encode_ascii_sse2,
+	ascii_length_utf8_avx2,
+	decode_ascii_sse2,
+};
+
+#endif // STRING_KERNELS_X86
+
+std::atomic<const StringKernels::Table *> StringKernels::table(nullptr);
+
+static const StringKernels::Table *_get_level_table(StringKernels::Level p_level) {
+	switch (p_level) {
+#ifdef STRING_KERNELS_X86
+		case StringKernels::LEVEL_AVX2:
+			return &avx2_table;
+		case StringKernels::LEVEL_SSE2:
+			return &sse2_table;
+#endif
+		default:
+			return &scalar_table;
+	}
+}
+
+const StringKernels::Table *StringKernels::_resolve() {
+	// Several threads may get here at once; they all store the same table.
+	const Table *t = _get_level_table(get_supported_level());
+	table.store(t, std::memory_order_relaxed);
+	return t;
+}
+
+StringKernels::Level StringKernels::get_supported_level() {
+#ifdef STRING_KERNELS_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] >= 7) {
+		__cpuid(info, 1);
+		// The OS must save the AVX registers too (OSXSAVE, then XCR0).
+		const bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		if (avx && (info[1] & (1 << 5))) {
+			return LEVEL_AVX2;
+		}
+	}
+	return LEVEL_SSE2;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? LEVEL_AVX2 : LEVEL_SSE2;
+#endif
+#else
+	return LEVEL_SCALAR;
+#endif
+}
+
+void StringKernels::set_level(Level p_level) {
+	const Level supported = get_supported_level();
+	table.store(_get_level_table(p_level > supported ? supported : p_level), std::memory_order_relaxed);
+}
@@ -0,0 +1,101 @@
+/*************************************************************************/
+/*  string_kernels.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include "core/ustring.h"
+
+#include <atomic>
+
+// Vectorized loops behind the hot String primitives. Every kernel has a
+// scalar version, an SSE2 version and, for the search kernels, an AVX2
+// version; the widest one the CPU supports is picked on first use.
+// Kernels take raw pointers and lengths and never read past p_len.
+class StringKernels {
+public:
+	enum Level {
+		LEVEL_SCALAR,
+		LEVEL_SSE2,
+		LEVEL_AVX2,
+	};
+
+	struct Table {
+		Level level;
+		int (*find_char)(const CharType *p_str, int p_len, CharType p_char);
+		int (*find)(const CharType *p_str, int p_len, const CharType *p_key, int p_key_len);
+		int (*find_ascii_nocase)(const CharType *p_str, int p_len, CharType p_lower);
+		bool (*equal)(const CharType *p_a, const CharType *p_b, int p_len);
+		int (*skip_lower)(const CharType *p_str, int p_len);
+		int (*lower_ascii)(const CharType *p_src, CharType *p_dst, int p_len);
+		int (*ascii_length)(const CharType *p_str, int p_len);
+		int (*encode_ascii)(const CharType *p_src, uint8_t *p_dst, int p_len);
+		int (*ascii_length_utf8)(const uint8_t *p_str, int p_len);
+		int (*decode_ascii)(const uint8_t *p_src, CharType *p_dst, int p_len);
+	};
+
+private:
+	static std::atomic<const Table *> table;
+
+	static const Table *_resolve();
+
+	_FORCE_INLINE_ static const Table *_get_table() {
+		const Table *t = table.load(std::memory_order_relaxed);
+		return likely(t) ? t : _resolve();
+	}
+
+public:
+	// Index of the first p_char, or -1.
+	_FORCE_INLINE_ static int find_char(const CharType *p_str, int p_len, CharType p_char) { return _get_table()->find_char(p_str, p_len, p_char); }
+	// Index of the first occurrence of p_key (p_key_len > 0), or -1.
+	_FORCE_INLINE_ static int find(const CharType *p_str, int p_len, const CharType *p_key, int p_key_len) { return _get_table()->find(p_str, p_len, p_key, p_key_len); }
+	// Index of the first character that is p_lower, its uppercase ASCII form, or not ASCII: the candidates for a caseless match of p_lower.
+	_FORCE_INLINE_ static int find_ascii_nocase(const CharType *p_str, int p_len, CharType p_lower) { return _get_table()->find_ascii_nocase(p_str, p_len, p_lower); }
+	_FORCE_INLINE_ static bool equal(const CharType *p_a, const CharType *p_b, int p_len) { return _get_table()->equal(p_a, p_b, p_len); }
+	// Number of leading characters that are ASCII and not uppercase, i.e. that to_lower() leaves alone.
+	_FORCE_INLINE_ static int skip_lower(const CharType *p_str, int p_len) { return _get_table()->skip_lower(p_str, p_len); }
+	// Lowercases the leading ASCII run of p_src into p_dst and returns its length.
+	_FORCE_INLINE_ static int lower_ascii(const CharType *p_src, CharType *p_dst, int p_len) { return _get_table()->lower_ascii(p_src, p_dst, p_len); }
+	// Number of leading ASCII characters.
+	_FORCE_INLINE_ static int ascii_length(const CharType *p_str, int p_len) { return _get_table()->ascii_length(p_str, p_len); }
+	// Narrows the leading ASCII run of p_src into p_dst and returns its length.
+	_FORCE_INLINE_ static int encode_ascii(const CharType *p_src, uint8_t *p_dst, int p_len) { return _get_table()->encode_ascii(p_src, p_dst, p_len); }
+	// Number of leading bytes that are ASCII and not zero.
+	_FORCE_INLINE_ static int ascii_length_utf8(const uint8_t *p_str, int p_len) { return _get_table()->ascii_length_utf8(p_str, p_len); }
+	// Widens the leading ASCII run of p_src into p_dst and returns its length.
+	_FORCE_INLINE_ static int decode_ascii(const uint8_t *p_src, CharType *p_dst, int p_len) { return _get_table()->decode_ascii(p_src, p_dst, p_len); }
+
+	static Level get_supported_level();
+	static Level get_level() { return _get_table()->level; }
+	// Forces a level, clamped to what the CPU supports. Meant for tests and benchmarks.
+	static void set_level(Level p_level);
+};
+
+#endif // STRING_KERNELS_H
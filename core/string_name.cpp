@@ -33,13 +33,21 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 
+#include <string.h>
+
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+std::atomic<StringName::_Table *> StringName::_table(nullptr);
+uint32_t StringName::_count = 0;
+std::atomic<uint32_t> StringName::_resize_version(0);
+std::atomic<uint32_t> StringName::_reader_epoch(0);
+std::atomic<uint32_t> StringName::_readers[2];
+StringName::_Data *StringName::_retired[2] = { nullptr, nullptr };
+StringName::_Table *StringName::_retired_tables[2] = { nullptr, nullptr };
 
 StringName _scs_create(const char *p_chr) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr)) : StringName());
@@ -48,11 +56,188 @@ StringName _scs_create(const char *p_chr) {
 bool StringName::configured = false;
 Mutex StringName::lock;
 
+static _FORCE_INLINE_ bool _name_matches(const char *p_cname, const String &p_name, const char *p_other) {
+	return p_cname ? strcmp(p_cname, p_other) == 0 : p_name == p_other;
+}
+
+static _FORCE_INLINE_ bool _name_matches(const char *p_cname, const String &p_name, const CharType *p_other) {
+	if (!p_cname) {
+		return p_name == p_other;
+	}
+	while (*p_cname && (CharType)(uint8_t)*p_cname == *p_other) {
+		p_cname++;
+		p_other++;
+	}
+	return (CharType)(uint8_t)*p_cname == *p_other;
+}
+
+static _FORCE_INLINE_ bool _name_matches(const char *p_cname, const String &p_name, const String &p_other) {
+	return p_cname ? p_other == p_cname : p_name == p_other;
+}
+
+StringName::_Table *StringName::_create_table(uint32_t p_size) {
+	_Table *table = memnew(_Table);
+	table->mask = p_size - 1;
+	table->buckets = memnew_arr(std::atomic<_Data *>, p_size);
+	for (uint32_t i = 0; i < p_size; i++) {
+		table->buckets[i].store(nullptr, std::memory_order_relaxed);
+	}
+	table->retired_next = nullptr;
+	return table;
+}
+
+// Entries and tables retired while a reader is registered in an epoch aren't freed until
+// all the readers of that epoch have left, see _reclaim().
+uint32_t StringName::_reader_enter() {
+	while (true) {
+		uint32_t epoch = _reader_epoch.load();
+		_readers[epoch].fetch_add(1);
+		if (_reader_epoch.load() == epoch) {
+			return epoch;
+		}
+		_readers[epoch].fetch_sub(1);
+	}
+}
+
+void StringName::_reader_exit(uint32_t p_epoch) {
+	_readers[p_epoch].fetch_sub(1);
+}
+
+// Returns the referenced entry, or null. A miss is only certain if no resize moved entries meanwhile.
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash, bool &r_certain) {
+	uint32_t epoch = _reader_enter();
+	uint32_t version = _resize_version.load();
+
+	_Table *table = _table.load(std::memory_order_acquire);
+	_Data *data = table->buckets[p_hash & table->mask].load(std::memory_order_acquire);
+
+	while (data) {
+		// compare hash first
+		if (data->hash == p_hash && _name_matches(data->cname, data->name, p_name) && data->refcount.ref()) {
+			break;
+		}
+		data = data->next.load(std::memory_order_acquire);
+	}
+
+	r_certain = data || ((version & 1) == 0 && _resize_version.load() == version);
+
+	_reader_exit(epoch);
+	return data;
+}
+
+// Keeps ASCII names as owned chars, and anything else as a String.
+template <class C>
+void StringName::_set_name(_Data *p_data, const C *p_name, int p_length) {
+	for (int i = 0; i < p_length; i++) {
+		if ((uint32_t)p_name[i] > 127) {
+			p_data->name = String(p_name);
+			return;
+		}
+	}
+
+	char *cname = (char *)memalloc(p_length + 1);
+	for (int i = 0; i < p_length; i++) {
+		cname[i] = (char)p_name[i];
+	}
+	cname[p_length] = 0;
+	p_data->cname = cname;
+	p_data->cname_owned = true;
+}
+
+String StringName::_widen(const _Data *p_data) {
+	// Whichever thread converts the name first stores it, the others just widen their own copy meanwhile.
+	uint8_t expected = WIDEN_NONE;
+	if (!p_data->widened.compare_exchange_strong(expected, WIDEN_BUSY, std::memory_order_acquire)) {
+		return String(p_data->cname);
+	}
+
+	p_data->name = String(p_data->cname);
+	p_data->widened.store(WIDEN_DONE, std::memory_order_release);
+	return p_data->name;
+}
+
+void StringName::_insert(_Data *p_data) {
+	_count++;
+	_Table *table = _table.load(std::memory_order_relaxed);
+	if (_count > table->mask + 1) {
+		_grow();
+		_reclaim();
+		table = _table.load(std::memory_order_relaxed);
+	}
+
+	std::atomic<_Data *> &bucket = table->buckets[p_data->hash & table->mask];
+	_Data *head = bucket.load(std::memory_order_relaxed);
+	p_data->prev = nullptr;
+	p_data->next.store(head, std::memory_order_relaxed);
+	if (head) {
+		head->prev = p_data;
+	}
+	bucket.store(p_data, std::memory_order_release);
+}
+
+void StringName::_grow() {
+	_Table *old_table = _table.load(std::memory_order_relaxed);
+	_Table *new_table = _create_table((old_table->mask + 1) * 2);
+
+	// Lookups running meanwhile may miss entries, they check _resize_version before trusting a miss.
+	_resize_version.fetch_add(1);
+
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		_Data *data = old_table->buckets[i].load(std::memory_order_relaxed);
+		while (data) {
+			_Data *next = data->next.load(std::memory_order_relaxed);
+
+			std::atomic<_Data *> &bucket = new_table->buckets[data->hash & new_table->mask];
+			_Data *head = bucket.load(std::memory_order_relaxed);
+			data->prev = nullptr;
+			data->next.store(head, std::memory_order_release);
+			if (head) {
+				head->prev = data;
+			}
+			bucket.store(data, std::memory_order_release);
+
+			data = next;
+		}
+	}
+
+	_table.store(new_table, std::memory_order_release);
+	_resize_version.fetch_add(1);
+
+	uint32_t epoch = _reader_epoch.load();
+	old_table->retired_next = _retired_tables[epoch];
+	_retired_tables[epoch] = old_table;
+}
+
+void StringName::_reclaim() {
+	uint32_t epoch = _reader_epoch.load();
+	uint32_t previous = epoch ^ 1;
+	if (_readers[previous].load() != 0) {
+		return;
+	}
+
+	// Nobody is reading since before the last epoch change, so nobody can reach what was retired before it.
+	while (_retired[previous]) {
+		_Data *data = _retired[previous];
+		_retired[previous] = data->retired_next;
+		memdelete(data);
+	}
+	while (_retired_tables[previous]) {
+		_Table *table = _retired_tables[previous];
+		_retired_tables[previous] = table->retired_next;
+		memdelete_arr(table->buckets);
+		memdelete(table);
+	}
+
+	if (_retired[epoch] || _retired_tables[epoch]) {
+		_reader_epoch.store(previous);
+	}
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
-	}
+	_table.store(_create_table(STRING_TABLE_LEN));
+	_count = 0;
 	configured = true;
 }
 
@@ -60,9 +245,10 @@ void StringName::cleanup() {
 	lock.lock();
 
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+	_Table *table = _table.load();
+	for (uint32_t i = 0; i <= table->mask; i++) {
+		_Data *d = table->buckets[i].load();
+		while (d) {
 			lost_strings++;
 			if (OS::get_singleton()->is_stdout_verbose()) {
 				if (d->cname) {
@@ -72,10 +258,29 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_Data *next = d->next.load();
 			memdelete(d);
+			d = next;
 		}
 	}
+	memdelete_arr(table->buckets);
+	memdelete(table);
+	_table.store(nullptr);
+
+	for (int i = 0; i < 2; i++) {
+		while (_retired[i]) {
+			_Data *data = _retired[i];
+			_retired[i] = data->retired_next;
+			memdelete(data);
+		}
+		while (_retired_tables[i]) {
+			_Table *retired_table = _retired_tables[i];
+			_retired_tables[i] = retired_table->retired_next;
+			memdelete_arr(retired_table->buckets);
+			memdelete(retired_table);
+		}
+	}
+
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
@@ -88,19 +293,29 @@ void StringName::unref() {
 	if (_data && _data->refcount.unref()) {
 		lock.lock();
 
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			_Table *table = _table.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = table->buckets[_data->hash & table->mask];
+			if (bucket.load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			bucket.store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+		_count--;
+
+		// Lookups may still be walking through it, keep its next pointer valid until they are done.
+		uint32_t epoch = _reader_epoch.load();
+		_data->retired_next = _retired[epoch];
+		_retired[epoch] = _data;
+		_reclaim();
+
 		lock.unlock();
 	}
 
@@ -112,7 +327,7 @@ bool StringName::operator==(const String &p_name) const {
 		return (p_name.length() == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->cname ? p_name == _data->cname : _data->name == p_name;
 }
 
 bool StringName::operator==(const char *p_name) const {
@@ -120,7 +335,7 @@ bool StringName::operator==(const char *p_name) const {
 		return (p_name[0] == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->cname ? strcmp(_data->cname, p_name) == 0 : _data->name == p_name;
 }
 
 bool StringName::operator!=(const String &p_name) const {
@@ -164,44 +379,27 @@ StringName::StringName(const char *p_name) {
 		return; //empty, ignore
 	}
 
-	lock.lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
+	bool certain;
+	_data = _find(p_name, hash, certain);
+	if (_data) {
+		return;
 	}
 
+	MutexLock mlock(lock);
+
+	_data = _find(p_name, hash, certain);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock.unlock();
-			return;
-		}
+		// added meanwhile
+		return;
 	}
 
 	_data = memnew(_Data);
-	_data->name = p_name;
+	_set_name(_data, p_name, strlen(p_name));
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
-
-	lock.unlock();
+	_insert(_data);
 }
 
 StringName::StringName(const StaticCString &p_static_string) {
@@ -211,44 +409,28 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	lock.lock();
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
+	bool certain;
+	_data = _find(p_static_string.ptr, hash, certain);
+	if (_data) {
+		return;
 	}
 
+	MutexLock mlock(lock);
+
+	_data = _find(p_static_string.ptr, hash, certain);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock.unlock();
-			return;
-		}
+		// added meanwhile
+		return;
 	}
 
 	_data = memnew(_Data);
 
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
-
-	lock.unlock();
+	_insert(_data);
 }
 
 StringName::StringName(const String &p_name) {
@@ -260,43 +442,27 @@ StringName::StringName(const String &p_name) {
 		return;
 	}
 
-	lock.lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
+	bool certain;
+	_data = _find(p_name, hash, certain);
+	if (_data) {
+		return;
 	}
 
+	MutexLock mlock(lock);
+
+	_data = _find(p_name, hash, certain);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock.unlock();
-			return;
-		}
+		// added meanwhile
+		return;
 	}
 
 	_data = memnew(_Data);
-	_data->name = p_name;
+	_set_name(_data, p_name.ptr(), p_name.length());
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
-
-	lock.unlock();
+	_insert(_data);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -307,30 +473,16 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	lock.lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock.unlock();
-
-		return StringName(_data);
+	bool certain;
+	_Data *data = _find(p_name, hash, certain);
+	if (!certain) {
+		MutexLock mlock(lock);
+		data = _find(p_name, hash, certain);
 	}
 
-	lock.unlock();
-	return StringName(); //does not exist
+	return data ? StringName(data) : StringName();
 }
 
 StringName StringName::search(const CharType *p_name) {
@@ -341,56 +493,59 @@ StringName StringName::search(const CharType *p_name) {
 		return StringName();
 	}
 
-	lock.lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
+	bool certain;
+	_Data *data = _find(p_name, hash, certain);
+	if (!certain) {
+		MutexLock mlock(lock);
+		data = _find(p_name, hash, certain);
 	}
 
-	if (_data && _data->refcount.ref()) {
-		lock.unlock();
-		return StringName(_data);
-	}
-
-	lock.unlock();
-	return StringName(); //does not exist
+	return data ? StringName(data) : StringName();
 }
+
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	lock.lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	bool certain;
+	_Data *data = _find(p_name, hash, certain);
+	if (!certain) {
+		MutexLock mlock(lock);
+		data = _find(p_name, hash, certain);
+	}
 
-	_Data *_data = _table[idx];
+	return data ? StringName(data) : StringName();
+}
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
+StringName::TableStats StringName::get_table_stats() {
+	TableStats stats;
+	stats.names = 0;
+	stats.buckets = 0;
+	stats.used_buckets = 0;
+	stats.max_chain_length = 0;
 
-	if (_data && _data->refcount.ref()) {
-		lock.unlock();
-		return StringName(_data);
+	ERR_FAIL_COND_V(!configured, stats);
+
+	MutexLock mlock(lock);
+
+	_Table *table = _table.load(std::memory_order_relaxed);
+	stats.names = _count;
+	stats.buckets = table->mask + 1;
+	for (uint32_t i = 0; i <= table->mask; i++) {
+		uint32_t length = 0;
+		for (_Data *data = table->buckets[i].load(std::memory_order_relaxed); data; data = data->next.load(std::memory_order_relaxed)) {
+			length++;
+		}
+		if (length) {
+			stats.used_buckets++;
+			stats.max_chain_length = MAX(stats.max_chain_length, length);
+		}
 	}
 
-	lock.unlock();
-	return StringName(); //does not exist
+	return stats;
 }
 
 StringName::StringName() {
@@ -35,6 +35,8 @@
 #include "core/safe_refcount.h"
 #include "core/ustring.h"
 
+#include <atomic>
+
 struct StaticCString {
 	const char *ptr;
 	static StaticCString create(const char *p_ptr);
@@ -43,30 +45,62 @@ struct StaticCString {
 class StringName {
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_BITS = 12, // Initial size, the table doubles whenever there are more names than buckets.
+		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS
+	};
+
+	enum {
+		WIDEN_NONE,
+		WIDEN_BUSY,
+		WIDEN_DONE
 	};
 
+	// Lookups walk the table without locking. Changes to it are serialized by the lock,
+	// and unlinked entries (or replaced tables) are only freed once no lookup can be using them.
+	// ASCII names are kept as chars in cname, either static or owned (a quarter of the size of
+	// a String). The first conversion to String widens them into name, where later conversions
+	// share it from. Other names are only kept in name.
 	struct _Data {
 		SafeRefCount refcount;
 		const char *cname;
-		String name;
+		mutable String name;
+		mutable std::atomic<uint8_t> widened; // WIDEN_* state of name when cname is set.
 
-		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
+		String get_name() const { return (!cname || widened.load(std::memory_order_acquire) == WIDEN_DONE) ? name : _widen(this); }
 		uint32_t hash;
-		_Data *prev;
-		_Data *next;
-		_Data() {
+		bool cname_owned;
+		_Data *prev; // Only used with the lock held.
+		std::atomic<_Data *> next;
+		_Data *retired_next;
+		_Data() :
+				widened(WIDEN_NONE),
+				next(nullptr) {
 			cname = nullptr;
-			next = prev = nullptr;
-			idx = 0;
+			cname_owned = false;
+			prev = nullptr;
+			retired_next = nullptr;
 			hash = 0;
 		}
+		~_Data() {
+			if (cname_owned) {
+				memfree((void *)cname);
+			}
+		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Table {
+		uint32_t mask;
+		std::atomic<_Data *> *buckets;
+		_Table *retired_next;
+	};
+
+	static std::atomic<_Table *> _table;
+	static uint32_t _count;
+	static std::atomic<uint32_t> _resize_version; // Odd while the table is being resized.
+	static std::atomic<uint32_t> _reader_epoch;
+	static std::atomic<uint32_t> _readers[2];
+	static _Data *_retired[2];
+	static _Table *_retired_tables[2];
 
 	_Data *_data;
 
@@ -84,6 +118,18 @@ class StringName {
 	static void cleanup();
 	static bool configured;
 
+	static _Table *_create_table(uint32_t p_size);
+	static uint32_t _reader_enter();
+	static void _reader_exit(uint32_t p_epoch);
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash, bool &r_certain);
+	template <class C>
+	static void _set_name(_Data *p_data, const C *p_name, int p_length);
+	static String _widen(const _Data *p_data);
+	static void _insert(_Data *p_data);
+	static void _grow();
+	static void _reclaim();
+
 	StringName(_Data *p_data) { _data = p_data; }
 
 public:
@@ -114,11 +160,7 @@ public:
 
 	_FORCE_INLINE_ operator String() const {
 		if (_data) {
-			if (_data->cname) {
-				return String(_data->cname);
-			} else {
-				return _data->name;
-			}
+			return _data->get_name();
 		}
 
 		return String();
@@ -128,6 +170,14 @@ public:
 	static StringName search(const CharType *p_name);
 	static StringName search(const String &p_name);
 
+	struct TableStats {
+		uint32_t names;
+		uint32_t buckets;
+		uint32_t used_buckets;
+		uint32_t max_chain_length;
+	};
+	static TableStats get_table_stats();
+
 	struct AlphCompare {
 		_FORCE_INLINE_ bool operator()(const StringName &l, const StringName &r) const {
 			const char *l_cname = l._data ? l._data->cname : "";
@@ -39,6 +39,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/print_string.h"
+#include "core/string_kernels.h"
 #include "core/translation.h"
 #include "core/ucaps.h"
 #include "core/variant.h"
@@ -289,17 +290,7 @@ bool String::operator==(const String &p_str) const {
 
 	int l = length();
 
-	const CharType *src = c_str();
-	const CharType *dst = p_str.c_str();
-
-	/* Compare char by char */
-	for (int i = 0; i < l; i++) {
-		if (src[i] != dst[i]) {
-			return false;
-		}
-	}
-
-	return true;
+	return StringKernels::equal(c_str(), p_str.c_str(), l);
 }
 
 bool String::operator!=(const String &p_str) const {
@@ -1050,13 +1041,30 @@ String String::to_upper() const {
 }
 
 String String::to_lower() const {
-	String lower = *this;
+	const int len = length();
+	const CharType *src = c_str();
 
-	for (int i = 0; i < lower.size(); i++) {
-		const CharType s = lower[i];
-		const CharType t = _find_lower(s);
-		if (s != t) { // avoid copy on write
-			lower[i] = t;
+	// Find the first character that changes, so unchanged strings are shared instead of copied.
+	int i = StringKernels::skip_lower(src, len);
+	while (i < len && uint32_t(src[i]) >= 0x80 && _find_lower(src[i]) == src[i]) {
+		i++;
+		i += StringKernels::skip_lower(src + i, len - i);
+	}
+	if (i == len) {
+		return *this;
+	}
+
+	String lower;
+	lower.resize(len + 1);
+	CharType *dst = lower.ptrw();
+	memcpy(dst, src, i * sizeof(CharType));
+	dst[len] = 0;
+
+	while (i < len) {
+		i += StringKernels::lower_ascii(src + i, dst + i, len - i);
+		if (i < len) {
+			dst[i] = _find_lower(src[i]);
+			i++;
 		}
 	}
 
@@ -1465,12 +1473,25 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 		}
 	}
 
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	}
+
 	{
 		const char *ptrtmp = p_utf8;
 		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
 			if (skip == 0) {
+				// Count runs of ASCII in one go.
+				const int ascii = StringKernels::ascii_length_utf8((const uint8_t *)ptrtmp, ptrtmp_limit - ptrtmp);
+				if (ascii) {
+					str_size += ascii;
+					cstr_size += ascii;
+					ptrtmp += ascii;
+					continue;
+				}
+
 				uint8_t c = *ptrtmp >= 0 ? *ptrtmp : uint8_t(256 + *ptrtmp);
 
 				/* Determine the number of characters in sequence */
@@ -1523,6 +1544,14 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	dst[str_size] = 0;
 
 	while (cstr_size) {
+		const int ascii = StringKernels::decode_ascii((const uint8_t *)p_utf8, dst, cstr_size);
+		if (ascii) {
+			dst += ascii;
+			p_utf8 += ascii;
+			cstr_size -= ascii;
+			continue;
+		}
+
 		int len = 0;
 
 		/* Determine the number of characters in sequence */
@@ -1599,6 +1628,14 @@ CharString String::utf8() const {
 	const CharType *d = &operator[](0);
 	int fl = 0;
 	for (int i = 0; i < l; i++) {
+		// Runs of ASCII take one byte per character.
+		const int ascii = StringKernels::ascii_length(d + i, l - i);
+		fl += ascii;
+		i += ascii;
+		if (i == l) {
+			break;
+		}
+
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
 			fl += 1;
@@ -1627,6 +1664,13 @@ CharString String::utf8() const {
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
 	for (int i = 0; i < l; i++) {
+		const int ascii = StringKernels::encode_ascii(d + i, cdst, l - i);
+		cdst += ascii;
+		i += ascii;
+		if (i == l) {
+			break;
+		}
+
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
@@ -2434,35 +2478,13 @@ int String::find(const String &p_str, int p_from) const {
 
 	const int len = length();
 
-	if (src_len == 0 || len == 0) {
+	if (src_len == 0 || len == 0 || p_from > len - src_len) {
 		return -1; // won't find anything!
 	}
 
-	const CharType *src = c_str();
-	const CharType *str = p_str.c_str();
-
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			};
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
-		}
+	const int pos = StringKernels::find(c_str() + p_from, len - p_from, p_str.c_str(), src_len);
 
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return pos < 0 ? -1 : pos + p_from;
 }
 
 int String::find(const char *p_str, int p_from) const {
@@ -2483,43 +2505,43 @@ int String::find(const char *p_str, int p_from) const {
 		src_len++;
 	}
 
-	if (src_len == 1) {
-		const char needle = p_str[0];
+	if (src_len == 0) {
+		return p_from <= len ? p_from : -1;
+	}
 
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
+	// Let the kernel skip to each occurrence of the first character, then check the rest.
+	const CharType first = p_str[0];
+	const int last_pos = len - src_len;
+	int i = p_from;
+	while (i <= last_pos) {
+		const int pos = StringKernels::find_char(src + i, last_pos - i + 1, first);
+		if (pos < 0) {
+			return -1;
 		}
+		i += pos;
 
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				};
-
-				if (src[read_pos] != p_str[j]) {
-					found = false;
-					break;
-				}
-			}
-
-			if (found) {
-				return i;
-			}
+		int j = 1;
+		while (j < src_len && src[i + j] == p_str[j]) {
+			j++;
 		}
+		if (j == src_len) {
+			return i;
+		}
+		i++;
 	}
 
 	return -1;
 }
 
 int String::find_char(const CharType &p_char, int p_from) const {
-	return _cowdata.find(p_char, p_from);
+	// Like CowData::find(), this also covers the terminating zero.
+	if (p_from < 0 || p_from >= size()) {
+		return -1;
+	}
+
+	const int pos = StringKernels::find_char(ptr() + p_from, size() - p_from, p_char);
+
+	return pos < 0 ? -1 : pos + p_from;
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -2583,14 +2605,27 @@ int String::findn(const String &p_str, int p_from) const {
 	}
 
 	int src_len = p_str.length();
+	const int len = length();
 
-	if (src_len == 0 || length() == 0) {
+	if (src_len == 0 || len == 0) {
 		return -1; // won't find anything!
 	}
 
 	const CharType *srcd = c_str();
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
+	// Any non-ASCII character might lower to an ASCII one, so the kernel stops at those as well.
+	const CharType first = _find_lower(p_str[0]);
+	const bool skip_ahead = uint32_t(first) < 0x80;
+
+	for (int i = p_from; i <= (len - src_len); i++) {
+		if (skip_ahead) {
+			const int pos = StringKernels::find_ascii_nocase(srcd + i, len - src_len - i + 1, first);
+			if (pos < 0) {
+				return -1;
+			}
+			i += pos;
+		}
+
 		bool found = true;
 		for (int j = 0; j < src_len; j++) {
 			int read_pos = i + j;
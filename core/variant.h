@@ -133,6 +133,7 @@ public:
 
 private:
 	friend struct _VariantCall;
+	friend struct _VariantValidated;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
 	// it only allocates extra memory for aabb/matrix.
 
@@ -358,6 +359,17 @@ public:
 		return res;
 	}
 
+	// Validated evaluators skip the type dispatch when the operand types are known in advance, e.g. by a compiler.
+	// They return false when they can't produce the result (such as on division by zero), so the caller must fall back to the generic path.
+	// r_ret may alias any of the operands.
+	typedef bool (*ValidatedOperatorEvaluator)(const Variant &p_a, const Variant &p_b, Variant *r_ret);
+	typedef void (*ValidatedGetter)(const Variant &p_base, Variant *r_ret);
+	typedef bool (*ValidatedIndexedGetter)(const Variant &p_base, int64_t p_index, Variant *r_ret);
+	// Unary operators are looked up with p_type_b set to NIL. Returns null if no fast path exists.
+	static ValidatedOperatorEvaluator get_validated_operator_evaluator(Operator p_op, Type p_type_a, Type p_type_b);
+	static ValidatedGetter get_validated_member_getter(Type p_type, const StringName &p_member);
+	static ValidatedIndexedGetter get_validated_indexed_getter(Type p_type);
+
 	void zero();
 	Variant duplicate(bool deep = false) const;
 	static void blend(const Variant &a, const Variant &b, float c, Variant &r_dst);
@@ -381,6 +393,12 @@ public:
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
+	// Handle to a method of a built-in type, so callers such as scripts can resolve it once and skip the name lookup on every call.
+	typedef const void *BuiltInMethod;
+	static BuiltInMethod get_builtin_method(Variant::Type p_type, const StringName &p_method);
+	// Fails with CALL_ERROR_INVALID_METHOD if p_method is null or belongs to another type.
+	void call_builtin(BuiltInMethod p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+
 	static String get_call_error_text(Object *p_base, const StringName &p_method, const Variant **p_argptrs, int p_argcount, const Variant::CallError &ce);
 
 	static Variant construct(const Variant::Type, const Variant **p_args, int p_argcount, CallError &r_error, bool p_strict = true);
@@ -33,6 +33,7 @@
 #include "core/color_names.inc"
 #include "core/core_string_names.h"
 #include "core/crypto/crypto_core.h"
+#include "core/hash_map.h"
 #include "core/io/compression.h"
 #include "core/object.h"
 #include "core/object_rc.h"
@@ -53,13 +54,14 @@ struct _VariantCall {
 		Vector<Variant::Type> arg_types;
 		Vector<StringName> arg_names;
 		Variant::Type return_type;
+		Variant::Type type;
 
 		bool _const;
 		bool returns;
 
 		VariantFunc func;
 
-		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) {
+		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) const {
 			if (arg_count == 0) {
 				return true;
 			}
@@ -80,7 +82,7 @@ struct _VariantCall {
 			return true;
 		}
 
-		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) const {
 #ifdef DEBUG_ENABLED
 			if (p_argcount > arg_count) {
 				r_error.error = Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
@@ -126,7 +128,9 @@ struct _VariantCall {
 	};
 
 	struct TypeFunc {
-		Map<StringName, FuncData> functions;
+		// Looked up on every call, so hashed on the precomputed StringName hash rather than kept in a tree.
+		// Elements are never removed, so pointers to them stay valid and can be handed out as Variant::BuiltInMethod.
+		HashMap<StringName, FuncData> functions;
 	};
 
 	static TypeFunc *type_funcs;
@@ -156,6 +160,7 @@ struct _VariantCall {
 		funcdata._const = p_const;
 		funcdata.returns = p_has_return;
 		funcdata.return_type = p_return;
+		funcdata.type = p_type;
 
 		if (p_argtype1.name) {
 			funcdata.arg_types.push_back(p_argtype1.type);
@@ -1180,15 +1185,14 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 	} else {
 		r_error.error = Variant::CallError::CALL_OK;
 
-		Map<StringName, _VariantCall::FuncData>::Element *E = _VariantCall::type_funcs[type].functions.find(p_method);
+		const _VariantCall::FuncData *funcdata = _VariantCall::type_funcs[type].functions.getptr(p_method);
 #ifdef DEBUG_ENABLED
-		if (!E) {
+		if (!funcdata) {
 			r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
 			return;
 		}
 #endif
-		_VariantCall::FuncData &funcdata = E->get();
-		funcdata.call(ret, *this, p_args, p_argcount, r_error);
+		funcdata->call(ret, *this, p_args, p_argcount, r_error);
 	}
 
 	if (r_error.error == Variant::CallError::CALL_OK && r_ret) {
@@ -1196,6 +1200,28 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 	}
 }
 
+Variant::BuiltInMethod Variant::get_builtin_method(Variant::Type p_type, const StringName &p_method) {
+	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, nullptr);
+	return _VariantCall::type_funcs[p_type].functions.getptr(p_method);
+}
+
+void Variant::call_builtin(BuiltInMethod p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error) {
+	const _VariantCall::FuncData *funcdata = (const _VariantCall::FuncData *)p_method;
+	if (unlikely(!funcdata || funcdata->type != type)) {
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+		return;
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	Variant ret;
+	funcdata->call(ret, *this, p_args, p_argcount, r_error);
+
+	if (r_error.error == Variant::CallError::CALL_OK && r_ret) {
+		*r_ret = ret;
+	}
+}
+
 #define VCALL(m_type, m_method) _VariantCall::_call_##m_type##_##m_method
 
 Variant Variant::construct(const Variant::Type p_type, const Variant **p_args, int p_argcount, CallError &r_error, bool p_strict) {
@@ -1393,69 +1419,74 @@ bool Variant::has_method(const StringName &p_method) const {
 Vector<Variant::Type> Variant::get_method_argument_types(Variant::Type p_type, const StringName &p_method) {
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E) {
+	const _VariantCall::FuncData *fd = tf.functions.getptr(p_method);
+	if (!fd) {
 		return Vector<Variant::Type>();
 	}
 
-	return E->get().arg_types;
+	return fd->arg_types;
 }
 
 bool Variant::is_method_const(Variant::Type p_type, const StringName &p_method) {
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E) {
+	const _VariantCall::FuncData *fd = tf.functions.getptr(p_method);
+	if (!fd) {
 		return false;
 	}
 
-	return E->get()._const;
+	return fd->_const;
 }
 
 Vector<StringName> Variant::get_method_argument_names(Variant::Type p_type, const StringName &p_method) {
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E) {
+	const _VariantCall::FuncData *fd = tf.functions.getptr(p_method);
+	if (!fd) {
 		return Vector<StringName>();
 	}
 
-	return E->get().arg_names;
+	return fd->arg_names;
 }
 
 Variant::Type Variant::get_method_return_type(Variant::Type p_type, const StringName &p_method, bool *r_has_return) {
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E) {
+	const _VariantCall::FuncData *fd = tf.functions.getptr(p_method);
+	if (!fd) {
 		return Variant::NIL;
 	}
 
 	if (r_has_return) {
-		*r_has_return = E->get().returns;
+		*r_has_return = fd->returns;
 	}
 
-	return E->get().return_type;
+	return fd->return_type;
 }
 
 Vector<Variant> Variant::get_method_default_arguments(Variant::Type p_type, const StringName &p_method) {
 	ERR_FAIL_INDEX_V(p_type, Variant::VARIANT_MAX, Vector<Variant>());
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	ERR_FAIL_COND_V(!E, Vector<Variant>());
+	const _VariantCall::FuncData *fd = tf.functions.getptr(p_method);
+	ERR_FAIL_COND_V(!fd, Vector<Variant>());
 
-	return E->get().default_args;
+	return fd->default_args;
 }
 
 void Variant::get_method_list(List<MethodInfo> *p_list) const {
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
 
-	for (const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.front(); E; E = E->next()) {
-		const _VariantCall::FuncData &fd = E->get();
+	// The hash map has no meaningful order, so sort by name for documentation and code completion.
+	List<StringName> names;
+	tf.functions.get_key_list(&names);
+	names.sort_custom<StringName::AlphCompare>();
+
+	for (List<StringName>::Element *E = names.front(); E; E = E->next()) {
+		const _VariantCall::FuncData &fd = tf.functions[E->get()];
 
 		MethodInfo mi;
-		mi.name = E->key();
+		mi.name = E->get();
 
 		if (fd._const) {
 			mi.flags |= METHOD_FLAG_CONST;
@@ -3755,3 +3755,387 @@ String Variant::get_operator_name(Operator p_op) {
 	ERR_FAIL_INDEX_V(p_op, OP_MAX, "");
 	return _op_names[p_op];
 }
+
+struct _VariantValidated {
+	template <class T>
+	static T get(const Variant &p_value);
+
+	template <class T>
+	_FORCE_INLINE_ static void set_mem(Variant *r_ret, const T &p_value, Variant::Type p_type) {
+		if (r_ret->type == p_type) {
+			*reinterpret_cast<T *>(r_ret->_data._mem) = p_value;
+		} else {
+			*r_ret = p_value;
+		}
+	}
+
+	_FORCE_INLINE_ static void set(Variant *r_ret, bool p_value) {
+		if (r_ret->type == Variant::BOOL) {
+			r_ret->_data._bool = p_value;
+		} else {
+			*r_ret = p_value;
+		}
+	}
+	_FORCE_INLINE_ static void set(Variant *r_ret, int64_t p_value) {
+		if (r_ret->type == Variant::INT) {
+			r_ret->_data._int = p_value;
+		} else {
+			*r_ret = p_value;
+		}
+	}
+	_FORCE_INLINE_ static void set(Variant *r_ret, double p_value) {
+		if (r_ret->type == Variant::REAL) {
+			r_ret->_data._real = p_value;
+		} else {
+			*r_ret = p_value;
+		}
+	}
+	_FORCE_INLINE_ static void set(Variant *r_ret, const Vector2 &p_value) { set_mem(r_ret, p_value, Variant::VECTOR2); }
+	_FORCE_INLINE_ static void set(Variant *r_ret, const Vector3 &p_value) { set_mem(r_ret, p_value, Variant::VECTOR3); }
+	_FORCE_INLINE_ static void set(Variant *r_ret, const Color &p_value) { set_mem(r_ret, p_value, Variant::COLOR); }
+
+	// Mirrors evaluate(), which only checks scalar divisors.
+	_FORCE_INLINE_ static bool is_zero(int64_t p_value) { return p_value == 0; }
+	_FORCE_INLINE_ static bool is_zero(double p_value) { return p_value == 0; }
+	template <class T>
+	_FORCE_INLINE_ static bool is_zero(const T &p_value) { return false; }
+
+	/* OPERATORS */
+
+#define VALIDATED_BINARY_OP(m_name, m_op)                                        \
+	template <class A, class B>                                                  \
+	static bool m_name(const Variant &p_a, const Variant &p_b, Variant *r_ret) { \
+		set(r_ret, get<A>(p_a) m_op get<B>(p_b));                                \
+		return true;                                                             \
+	}
+
+	VALIDATED_BINARY_OP(add, +)
+	VALIDATED_BINARY_OP(subtract, -)
+	VALIDATED_BINARY_OP(multiply, *)
+	VALIDATED_BINARY_OP(equal, ==)
+	VALIDATED_BINARY_OP(not_equal, !=)
+	VALIDATED_BINARY_OP(less, <)
+	VALIDATED_BINARY_OP(less_equal, <=)
+	VALIDATED_BINARY_OP(greater, >)
+	VALIDATED_BINARY_OP(greater_equal, >=)
+
+#undef VALIDATED_BINARY_OP
+
+	template <class A, class B>
+	static bool divide(const Variant &p_a, const Variant &p_b, Variant *r_ret) {
+		const B divisor = get<B>(p_b);
+		if (is_zero(divisor)) {
+			return false;
+		}
+		set(r_ret, get<A>(p_a) / divisor);
+		return true;
+	}
+
+	static bool module(const Variant &p_a, const Variant &p_b, Variant *r_ret) {
+		if (p_b._data._int == 0) {
+			return false;
+		}
+		set(r_ret, p_a._data._int % p_b._data._int);
+		return true;
+	}
+
+	template <class A>
+	static bool negate(const Variant &p_a, const Variant &p_b, Variant *r_ret) {
+		set(r_ret, -get<A>(p_a));
+		return true;
+	}
+
+	static bool logic_not(const Variant &p_a, const Variant &p_b, Variant *r_ret) {
+		set(r_ret, !p_a._data._bool);
+		return true;
+	}
+
+	/* MEMBERS */
+
+#define VALIDATED_MEMBER(m_name, m_type, m_expr)                                \
+	static void m_name(const Variant &p_base, Variant *r_ret) {                 \
+		const m_type &v = *reinterpret_cast<const m_type *>(p_base._data._mem); \
+		set(r_ret, m_expr);                                                     \
+	}
+
+	VALIDATED_MEMBER(vector2_x, Vector2, (double)v.x)
+	VALIDATED_MEMBER(vector2_y, Vector2, (double)v.y)
+	VALIDATED_MEMBER(rect2_position, Rect2, v.position)
+	VALIDATED_MEMBER(rect2_size, Rect2, v.size)
+	VALIDATED_MEMBER(rect2_end, Rect2, v.position + v.size)
+	VALIDATED_MEMBER(vector3_x, Vector3, (double)v.x)
+	VALIDATED_MEMBER(vector3_y, Vector3, (double)v.y)
+	VALIDATED_MEMBER(vector3_z, Vector3, (double)v.z)
+	VALIDATED_MEMBER(color_r, Color, (double)v.r)
+	VALIDATED_MEMBER(color_g, Color, (double)v.g)
+	VALIDATED_MEMBER(color_b, Color, (double)v.b)
+	VALIDATED_MEMBER(color_a, Color, (double)v.a)
+
+#undef VALIDATED_MEMBER
+
+	static void transform2d_origin(const Variant &p_base, Variant *r_ret) {
+		set(r_ret, p_base._data._transform2d->elements[2]);
+	}
+
+	static void transform_origin(const Variant &p_base, Variant *r_ret) {
+		set(r_ret, p_base._data._transform->origin);
+	}
+
+	/* INDEXED */
+
+	static bool array_get(const Variant &p_base, int64_t p_index, Variant *r_ret) {
+		const Array *arr = reinterpret_cast<const Array *>(p_base._data._mem);
+		int index = p_index;
+		if (index < 0) {
+			index += arr->size();
+		}
+		if (index < 0 || index >= arr->size()) {
+			return false;
+		}
+		if (r_ret == &p_base) {
+			// Assigning would free the array before the element is copied.
+			Variant ret = (*arr)[index];
+			*r_ret = ret;
+		} else {
+			*r_ret = (*arr)[index];
+		}
+		return true;
+	}
+
+	template <class T, class R>
+	static bool pool_array_get(const Variant &p_base, int64_t p_index, Variant *r_ret) {
+		const PoolVector<T> *arr = reinterpret_cast<const PoolVector<T> *>(p_base._data._mem);
+		int index = p_index;
+		if (index < 0) {
+			index += arr->size();
+		}
+		if (index < 0 || index >= arr->size()) {
+			return false;
+		}
+		set(r_ret, R(arr->get(index)));
+		return true;
+	}
+
+	static bool pool_string_array_get(const Variant &p_base, int64_t p_index, Variant *r_ret) {
+		const PoolVector<String> *arr = reinterpret_cast<const PoolVector<String> *>(p_base._data._mem);
+		int index = p_index;
+		if (index < 0) {
+			index += arr->size();
+		}
+		if (index < 0 || index >= arr->size()) {
+			return false;
+		}
+		*r_ret = arr->get(index);
+		return true;
+	}
+};
+
+template <>
+_FORCE_INLINE_ bool _VariantValidated::get<bool>(const Variant &p_value) {
+	return p_value._data._bool;
+}
+template <>
+_FORCE_INLINE_ int64_t _VariantValidated::get<int64_t>(const Variant &p_value) {
+	return p_value._data._int;
+}
+template <>
+_FORCE_INLINE_ double _VariantValidated::get<double>(const Variant &p_value) {
+	return p_value._data._real;
+}
+template <>
+_FORCE_INLINE_ Vector2 _VariantValidated::get<Vector2>(const Variant &p_value) {
+	return *reinterpret_cast<const Vector2 *>(p_value._data._mem);
+}
+template <>
+_FORCE_INLINE_ Vector3 _VariantValidated::get<Vector3>(const Variant &p_value) {
+	return *reinterpret_cast<const Vector3 *>(p_value._data._mem);
+}
+template <>
+_FORCE_INLINE_ Color _VariantValidated::get<Color>(const Variant &p_value) {
+	return *reinterpret_cast<const Color *>(p_value._data._mem);
+}
+
+#define VALIDATED_OP(m_func, m_type_a, m_ctype_a, m_type_b, m_ctype_b) \
+	if (p_type_a == m_type_a && p_type_b == m_type_b) {                \
+		return &_VariantValidated::m_func<m_ctype_a, m_ctype_b>;       \
+	}
+
+#define VALIDATED_OP_NUM(m_func)                     \
+	VALIDATED_OP(m_func, INT, int64_t, INT, int64_t) \
+	VALIDATED_OP(m_func, INT, int64_t, REAL, double) \
+	VALIDATED_OP(m_func, REAL, double, INT, int64_t) \
+	VALIDATED_OP(m_func, REAL, double, REAL, double)
+
+#define VALIDATED_OP_LOCALMEM(m_func)                        \
+	VALIDATED_OP(m_func, VECTOR2, Vector2, VECTOR2, Vector2) \
+	VALIDATED_OP(m_func, VECTOR3, Vector3, VECTOR3, Vector3) \
+	VALIDATED_OP(m_func, COLOR, Color, COLOR, Color)
+
+#define VALIDATED_OP_LOCALMEM_NUM(m_func)                \
+	VALIDATED_OP(m_func, VECTOR2, Vector2, INT, int64_t) \
+	VALIDATED_OP(m_func, VECTOR2, Vector2, REAL, double) \
+	VALIDATED_OP(m_func, VECTOR3, Vector3, INT, int64_t) \
+	VALIDATED_OP(m_func, VECTOR3, Vector3, REAL, double) \
+	VALIDATED_OP(m_func, COLOR, Color, INT, int64_t)     \
+	VALIDATED_OP(m_func, COLOR, Color, REAL, double)
+
+#define VALIDATED_OP_UNARY(m_func, m_type, m_ctype) \
+	if (p_type_a == m_type && p_type_b == NIL) {    \
+		return &_VariantValidated::m_func<m_ctype>; \
+	}
+
+Variant::ValidatedOperatorEvaluator Variant::get_validated_operator_evaluator(Operator p_op, Type p_type_a, Type p_type_b) {
+	switch (p_op) {
+		case OP_ADD: {
+			VALIDATED_OP_NUM(add)
+			VALIDATED_OP_LOCALMEM(add)
+		} break;
+		case OP_SUBTRACT: {
+			VALIDATED_OP_NUM(subtract)
+			VALIDATED_OP_LOCALMEM(subtract)
+		} break;
+		case OP_MULTIPLY: {
+			VALIDATED_OP_NUM(multiply)
+			VALIDATED_OP_LOCALMEM(multiply)
+			VALIDATED_OP_LOCALMEM_NUM(multiply)
+			VALIDATED_OP(multiply, INT, int64_t, VECTOR2, Vector2)
+			VALIDATED_OP(multiply, REAL, double, VECTOR2, Vector2)
+			VALIDATED_OP(multiply, INT, int64_t, VECTOR3, Vector3)
+			VALIDATED_OP(multiply, REAL, double, VECTOR3, Vector3)
+		} break;
+		case OP_DIVIDE: {
+			VALIDATED_OP_NUM(divide)
+			VALIDATED_OP_LOCALMEM(divide)
+			VALIDATED_OP_LOCALMEM_NUM(divide)
+		} break;
+		case OP_MODULE: {
+			if (p_type_a == INT && p_type_b == INT) {
+				return &_VariantValidated::module;
+			}
+		} break;
+		case OP_EQUAL: {
+			VALIDATED_OP_NUM(equal)
+			VALIDATED_OP_LOCALMEM(equal)
+			VALIDATED_OP(equal, BOOL, bool, BOOL, bool)
+		} break;
+		case OP_NOT_EQUAL: {
+			VALIDATED_OP_NUM(not_equal)
+			VALIDATED_OP_LOCALMEM(not_equal)
+			VALIDATED_OP(not_equal, BOOL, bool, BOOL, bool)
+		} break;
+		case OP_LESS: {
+			VALIDATED_OP_NUM(less)
+		} break;
+		case OP_LESS_EQUAL: {
+			VALIDATED_OP_NUM(less_equal)
+		} break;
+		case OP_GREATER: {
+			VALIDATED_OP_NUM(greater)
+		} break;
+		case OP_GREATER_EQUAL: {
+			VALIDATED_OP_NUM(greater_equal)
+		} break;
+		case OP_NEGATE: {
+			VALIDATED_OP_UNARY(negate, INT, int64_t)
+			VALIDATED_OP_UNARY(negate, REAL, double)
+			VALIDATED_OP_UNARY(negate, VECTOR2, Vector2)
+			VALIDATED_OP_UNARY(negate, VECTOR3, Vector3)
+			VALIDATED_OP_UNARY(negate, COLOR, Color)
+		} break;
+		case OP_NOT: {
+			if (p_type_a == BOOL && p_type_b == NIL) {
+				return &_VariantValidated::logic_not;
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return nullptr;
+}
+
+#undef VALIDATED_OP
+#undef VALIDATED_OP_NUM
+#undef VALIDATED_OP_LOCALMEM
+#undef VALIDATED_OP_LOCALMEM_NUM
+#undef VALIDATED_OP_UNARY
+
+Variant::ValidatedGetter Variant::get_validated_member_getter(Type p_type, const StringName &p_member) {
+	const CoreStringNames *names = CoreStringNames::get_singleton();
+
+	switch (p_type) {
+		case VECTOR2: {
+			if (p_member == names->x) {
+				return &_VariantValidated::vector2_x;
+			} else if (p_member == names->y) {
+				return &_VariantValidated::vector2_y;
+			}
+		} break;
+		case RECT2: {
+			if (p_member == names->position) {
+				return &_VariantValidated::rect2_position;
+			} else if (p_member == names->size) {
+				return &_VariantValidated::rect2_size;
+			} else if (p_member == names->end) {
+				return &_VariantValidated::rect2_end;
+			}
+		} break;
+		case TRANSFORM2D: {
+			if (p_member == names->origin) {
+				return &_VariantValidated::transform2d_origin;
+			}
+		} break;
+		case VECTOR3: {
+			if (p_member == names->x) {
+				return &_VariantValidated::vector3_x;
+			} else if (p_member == names->y) {
+				return &_VariantValidated::vector3_y;
+			} else if (p_member == names->z) {
+				return &_VariantValidated::vector3_z;
+			}
+		} break;
+		case TRANSFORM: {
+			if (p_member == names->origin) {
+				return &_VariantValidated::transform_origin;
+			}
+		} break;
+		case COLOR: {
+			if (p_member == names->r) {
+				return &_VariantValidated::color_r;
+			} else if (p_member == names->g) {
+				return &_VariantValidated::color_g;
+			} else if (p_member == names->b) {
+				return &_VariantValidated::color_b;
+			} else if (p_member == names->a) {
+				return &_VariantValidated::color_a;
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return nullptr;
+}
+
+Variant::ValidatedIndexedGetter Variant::get_validated_indexed_getter(Type p_type) {
+	switch (p_type) {
+		case ARRAY:
+			return &_VariantValidated::array_get;
+		case POOL_BYTE_ARRAY:
+			return &_VariantValidated::pool_array_get<uint8_t, int64_t>;
+		case POOL_INT_ARRAY:
+			return &_VariantValidated::pool_array_get<int, int64_t>;
+		case POOL_REAL_ARRAY:
+			return &_VariantValidated::pool_array_get<real_t, double>;
+		case POOL_STRING_ARRAY:
+			return &_VariantValidated::pool_string_array_get;
+		case POOL_VECTOR2_ARRAY:
+			return &_VariantValidated::pool_array_get<Vector2, Vector2>;
+		case POOL_VECTOR3_ARRAY:
+			return &_VariantValidated::pool_array_get<Vector3, Vector3>;
+		case POOL_COLOR_ARRAY:
+			return &_VariantValidated::pool_array_get<Color, Color>;
+		default:
+			return nullptr;
+	}
+}
@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "shader_cache_gles3.h"
 
 RasterizerStorage *RasterizerGLES3::get_storage() {
 	return storage;
@@ -186,6 +187,11 @@ void RasterizerGLES3::initialize() {
 	*/
 
 	print_line("OpenGL ES 3.0 Renderer: " + VisualServer::get_singleton()->get_video_adapter_name());
+
+	if (GLOBAL_GET("rendering/gles3/shaders/shader_cache_enabled")) {
+		ShaderGLES3::shader_cache = ShaderCacheGLES3::create();
+	}
+
 	storage->initialize();
 	canvas->initialize();
 	scene->initialize();
@@ -420,6 +426,11 @@ void RasterizerGLES3::end_frame(bool p_swap_buffers) {
 void RasterizerGLES3::finalize() {
 	storage->finalize();
 	canvas->finalize();
+
+	if (ShaderGLES3::shader_cache) {
+		memdelete(ShaderGLES3::shader_cache);
+		ShaderGLES3::shader_cache = nullptr;
+	}
 }
 
 Rasterizer *RasterizerGLES3::_create_current() {
@@ -0,0 +1,174 @@
+/*************************************************************************/
+/*  shader_cache_gles3.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "shader_cache_gles3.h"
+
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "core/version.h"
+
+#define SHADER_CACHE_MAGIC "GLPB"
+#define SHADER_CACHE_DRIVER_FILE "driver.txt"
+
+bool ShaderCacheGLES3::_is_supported() {
+#ifdef JAVASCRIPT_ENABLED
+	// WebGL doesn't expose program binaries.
+	return false;
+#else
+#ifdef GLAD_ENABLED
+	if (!GLAD_GL_ARB_get_program_binary) {
+		return false;
+	}
+#endif
+	GLint format_count = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+	return format_count > 0;
+#endif
+}
+
+void ShaderCacheGLES3::_clear() {
+	DirAccessRef da = DirAccess::open(storage_path);
+	if (!da) {
+		return;
+	}
+
+	da->erase_contents_recursive();
+}
+
+void ShaderCacheGLES3::set_retrievable(GLuint p_program) const {
+#ifndef JAVASCRIPT_ENABLED
+	glProgramParameteri(p_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+bool ShaderCacheGLES3::load_program(GLuint p_program, const String &p_key) const {
+#ifdef JAVASCRIPT_ENABLED
+	return false;
+#else
+	FileAccessRef f = FileAccess::open(storage_path.plus_file(p_key), FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) != 4 || memcmp(magic, SHADER_CACHE_MAGIC, 4) != 0) {
+		return false;
+	}
+
+	GLenum format = f->get_32();
+	uint32_t length = f->get_32();
+	if (length == 0 || length > f->get_len() - f->get_position()) {
+		return false;
+	}
+
+	Vector<uint8_t> binary;
+	binary.resize(length);
+	if (f->get_buffer(binary.ptrw(), length) != length) {
+		return false;
+	}
+
+	glProgramBinary(p_program, format, binary.ptr(), length);
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(p_program, GL_LINK_STATUS, &status);
+	if (status == GL_FALSE) {
+		print_verbose("Shader cache: the driver rejected the binary for " + p_key + ", compiling it again.");
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+void ShaderCacheGLES3::save_program(GLuint p_program, const String &p_key) const {
+#ifndef JAVASCRIPT_ENABLED
+	GLint length = 0;
+	glGetProgramiv(p_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	Vector<uint8_t> binary;
+	binary.resize(length);
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(p_program, length, &written, &format, binary.ptrw());
+	if (written <= 0) {
+		return;
+	}
+
+	FileAccessRef f = FileAccess::open(storage_path.plus_file(p_key), FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write to the shader cache at: " + storage_path + ".");
+
+	f->store_buffer((const uint8_t *)SHADER_CACHE_MAGIC, 4);
+	f->store_32(format);
+	f->store_32(written);
+	f->store_buffer(binary.ptr(), written);
+#endif
+}
+
+ShaderCacheGLES3 *ShaderCacheGLES3::create() {
+	if (!_is_supported()) {
+		print_verbose("Shader cache: program binaries are not supported by the driver.");
+		return nullptr;
+	}
+
+	String driver = String((const char *)glGetString(GL_VENDOR)) + "\n";
+	driver += String((const char *)glGetString(GL_RENDERER)) + "\n";
+	driver += String((const char *)glGetString(GL_VERSION)) + "\n";
+	driver += VERSION_FULL_BUILD;
+
+	return memnew(ShaderCacheGLES3(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"), driver));
+}
+
+ShaderCacheGLES3::ShaderCacheGLES3(const String &p_storage_path, const String &p_driver_string) {
+	storage_path = p_storage_path;
+	driver_string = p_driver_string;
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->make_dir_recursive(storage_path) != OK) {
+		ERR_PRINT("Can't create the shader cache directory: " + storage_path + ".");
+		return;
+	}
+
+	// Binaries from another driver or engine version can't be loaded anymore, so drop them instead of letting them pile up.
+	String driver_file = storage_path.plus_file(SHADER_CACHE_DRIVER_FILE);
+	Error err;
+	if (FileAccess::get_file_as_string(driver_file, &err) != driver_string) {
+		_clear();
+
+		FileAccessRef f = FileAccess::open(driver_file, FileAccess::WRITE);
+		if (f) {
+			f->store_string(driver_string);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+/*************************************************************************/
+/*  shader_cache_gles3.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SHADER_CACHE_GLES3_H
+#define SHADER_CACHE_GLES3_H
+
+#include "core/ustring.h"
+
+#include "platform_config.h"
+#ifndef GLES3_INCLUDE_H
+#include <GLES3/gl3.h>
+#else
+#include GLES3_INCLUDE_H
+#endif
+
+// Keeps linked program binaries in the user data directory, so shader variants
+// linked on a previous run can be loaded instead of compiled again.
+class ShaderCacheGLES3 {
+	String storage_path;
+	String driver_string;
+
+	static bool _is_supported();
+	void _clear();
+
+public:
+	// Entries are only valid for the driver they were created with, so it has to be part of their key.
+	_FORCE_INLINE_ const String &get_driver_string() const { return driver_string; }
+
+	// Must be called before linking a program that will be saved.
+	void set_retrievable(GLuint p_program) const;
+	// Returns false if nothing is stored for p_key or the driver rejected the binary, in which case p_program must be compiled and linked as usual.
+	bool load_program(GLuint p_program, const String &p_key) const;
+	void save_program(GLuint p_program, const String &p_key) const;
+
+	// Returns nullptr when the driver can't provide program binaries.
+	static ShaderCacheGLES3 *create();
+
+	ShaderCacheGLES3(const String &p_storage_path, const String &p_driver_string);
+};
+
+#endif // SHADER_CACHE_GLES3_H
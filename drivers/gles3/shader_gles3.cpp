@@ -30,7 +30,9 @@
 
 #include "shader_gles3.h"
 
+#include "core/crypto/crypto_core.h"
 #include "core/print_string.h"
+#include "shader_cache_gles3.h"
 
 //#define DEBUG_OPENGL
 
@@ -50,6 +52,7 @@
 #endif
 
 ShaderGLES3 *ShaderGLES3::active = nullptr;
+ShaderCacheGLES3 *ShaderGLES3::shader_cache = nullptr;
 
 //#define DEBUG_SHADER
 
@@ -220,6 +223,8 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	}
 
 	//keep them around during the function
+	CharString vertex_code_string;
+	CharString vertex_globals;
 	CharString code_string;
 	CharString code_string2;
 	CharString code_globals;
@@ -235,14 +240,6 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		v.code_version = cc->version;
 	}
 
-	/* CREATE PROGRAM */
-
-	v.id = glCreateProgram();
-
-	ERR_FAIL_COND_V(v.id == 0, nullptr);
-
-	/* VERTEX SHADER */
-
 	if (cc) {
 		for (int i = 0; i < cc->custom_defines.size(); i++) {
 			strings.push_back(cc->custom_defines[i].get_data());
@@ -250,7 +247,13 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		}
 	}
 
-	int strings_base_size = strings.size();
+	if (cc) {
+		material_string = cc->uniforms.ascii();
+	}
+
+	Vector<const char *> fragment_strings = strings;
+
+	/* VERTEX SHADER */
 
 	//vertex precision is high
 	strings.push_back("precision highp float;\n");
@@ -264,33 +267,104 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	strings.push_back(vertex_code0.get_data());
 
 	if (cc) {
-		material_string = cc->uniforms.ascii();
 		strings.push_back(material_string.get_data());
 	}
 
 	strings.push_back(vertex_code1.get_data());
 
 	if (cc) {
-		code_globals = cc->vertex_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		vertex_globals = cc->vertex_globals.ascii();
+		strings.push_back(vertex_globals.get_data());
 	}
 
 	strings.push_back(vertex_code2.get_data());
 
 	if (cc) {
-		code_string = cc->vertex.ascii();
-		strings.push_back(code_string.get_data());
+		vertex_code_string = cc->vertex.ascii();
+		strings.push_back(vertex_code_string.get_data());
 	}
 
 	strings.push_back(vertex_code3.get_data());
 #ifdef DEBUG_SHADER
 
-	DEBUG_PRINT("\nVertex Code:\n\n" + String(code_string.get_data()));
+	DEBUG_PRINT("\nVertex Code:\n\n" + String(vertex_code_string.get_data()));
 	for (int i = 0; i < strings.size(); i++) {
 		//print_line("vert strings "+itos(i)+":"+String(strings[i]));
 	}
 #endif
 
+	/* FRAGMENT SHADER */
+
+	//fragment precision is medium
+	fragment_strings.push_back("precision highp float;\n");
+	fragment_strings.push_back("precision highp int;\n");
+#ifndef GLES_OVER_GL
+	fragment_strings.push_back("precision highp sampler2D;\n");
+	fragment_strings.push_back("precision highp samplerCube;\n");
+	fragment_strings.push_back("precision highp sampler2DArray;\n");
+#endif
+
+	fragment_strings.push_back(fragment_code0.get_data());
+	if (cc) {
+		fragment_strings.push_back(material_string.get_data());
+	}
+
+	fragment_strings.push_back(fragment_code1.get_data());
+
+	if (cc) {
+		code_globals = cc->fragment_globals.ascii();
+		fragment_strings.push_back(code_globals.get_data());
+	}
+
+	fragment_strings.push_back(fragment_code2.get_data());
+
+	if (cc) {
+		code_string = cc->light.ascii();
+		fragment_strings.push_back(code_string.get_data());
+	}
+
+	fragment_strings.push_back(fragment_code3.get_data());
+
+	if (cc) {
+		code_string2 = cc->fragment.ascii();
+		fragment_strings.push_back(code_string2.get_data());
+	}
+
+	fragment_strings.push_back(fragment_code4.get_data());
+
+#ifdef DEBUG_SHADER
+	DEBUG_PRINT("\nFragment Globals:\n\n" + String(code_globals.get_data()));
+	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string2.get_data()));
+	for (int i = 0; i < fragment_strings.size(); i++) {
+		//print_line("frag strings "+itos(i)+":"+String(fragment_strings[i]));
+	}
+#endif
+
+	Vector<const char *> feedback;
+	for (int i = 0; i < feedback_count; i++) {
+		if (feedbacks[i].conditional == -1 || (1 << feedbacks[i].conditional) & conditional_version.version) {
+			//conditional for this feedback is enabled
+			feedback.push_back(feedbacks[i].name);
+		}
+	}
+
+	/* CREATE PROGRAM */
+
+	v.id = glCreateProgram();
+
+	ERR_FAIL_COND_V(v.id == 0, nullptr);
+
+	String cache_key;
+	if (shader_cache) {
+		cache_key = _get_program_cache_key(strings, fragment_strings, feedback);
+
+		if (shader_cache->load_program(v.id, cache_key)) {
+			v.vert_id = 0;
+			v.frag_id = 0;
+			return _setup_version(v, cc);
+		}
+	}
+
 	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
 	glShaderSource(v.vert_id, strings.size(), &strings[0], nullptr);
 	glCompileShader(v.vert_id);
@@ -333,57 +407,8 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	//_display_error_with_code("pepo", strings);
 
-	/* FRAGMENT SHADER */
-
-	strings.resize(strings_base_size);
-	//fragment precision is medium
-	strings.push_back("precision highp float;\n");
-	strings.push_back("precision highp int;\n");
-#ifndef GLES_OVER_GL
-	strings.push_back("precision highp sampler2D;\n");
-	strings.push_back("precision highp samplerCube;\n");
-	strings.push_back("precision highp sampler2DArray;\n");
-#endif
-
-	strings.push_back(fragment_code0.get_data());
-	if (cc) {
-		material_string = cc->uniforms.ascii();
-		strings.push_back(material_string.get_data());
-	}
-
-	strings.push_back(fragment_code1.get_data());
-
-	if (cc) {
-		code_globals = cc->fragment_globals.ascii();
-		strings.push_back(code_globals.get_data());
-	}
-
-	strings.push_back(fragment_code2.get_data());
-
-	if (cc) {
-		code_string = cc->light.ascii();
-		strings.push_back(code_string.get_data());
-	}
-
-	strings.push_back(fragment_code3.get_data());
-
-	if (cc) {
-		code_string2 = cc->fragment.ascii();
-		strings.push_back(code_string2.get_data());
-	}
-
-	strings.push_back(fragment_code4.get_data());
-
-#ifdef DEBUG_SHADER
-	DEBUG_PRINT("\nFragment Globals:\n\n" + String(code_globals.get_data()));
-	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string2.get_data()));
-	for (int i = 0; i < strings.size(); i++) {
-		//print_line("frag strings "+itos(i)+":"+String(strings[i]));
-	}
-#endif
-
 	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(v.frag_id, strings.size(), &strings[0], nullptr);
+	glShaderSource(v.frag_id, fragment_strings.size(), &fragment_strings[0], nullptr);
 	glCompileShader(v.frag_id);
 
 	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
@@ -410,7 +435,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 			String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
 
 			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
+			_display_error_with_code(err_string, fragment_strings);
 			ERR_PRINT(err_string.ascii().get_data());
 			memfree(ilogmem);
 			glDeleteShader(v.frag_id);
@@ -432,18 +457,12 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	//if feedback exists, set it up
 
-	if (feedback_count) {
-		Vector<const char *> feedback;
-		for (int i = 0; i < feedback_count; i++) {
-			if (feedbacks[i].conditional == -1 || (1 << feedbacks[i].conditional) & conditional_version.version) {
-				//conditional for this feedback is enabled
-				feedback.push_back(feedbacks[i].name);
-			}
-		}
+	if (feedback.size()) {
+		glTransformFeedbackVaryings(v.id, feedback.size(), feedback.ptr(), GL_INTERLEAVED_ATTRIBS);
+	}
 
-		if (feedback.size()) {
-			glTransformFeedbackVaryings(v.id, feedback.size(), feedback.ptr(), GL_INTERLEAVED_ATTRIBS);
-		}
+	if (shader_cache) {
+		shader_cache->set_retrievable(v.id);
 	}
 
 	glLinkProgram(v.id);
@@ -474,7 +493,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		String err_string = get_shader_name() + ": Program LINK FAILED:\n";
 
 		err_string += ilogmem;
-		_display_error_with_code(err_string, strings);
+		_display_error_with_code(err_string, fragment_strings);
 		ERR_PRINT(err_string.ascii().get_data());
 		Memory::free_static(ilogmem);
 		glDeleteShader(v.frag_id);
@@ -485,6 +504,46 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		ERR_FAIL_V(nullptr);
 	}
 
+	if (shader_cache) {
+		shader_cache->save_program(v.id, cache_key);
+	}
+
+	return _setup_version(v, cc);
+}
+
+String ShaderGLES3::_get_program_cache_key(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings, const Vector<const char *> &p_feedback) const {
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+
+	// Everything that changes the linked program has to be part of the key; a zero byte separates the parts.
+	CharString driver = shader_cache->get_driver_string().utf8();
+	ctx.update((const uint8_t *)driver.get_data(), driver.length() + 1);
+
+	for (int i = 0; i < p_vertex_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_vertex_strings[i], strlen(p_vertex_strings[i]));
+	}
+	ctx.update((const uint8_t *)"", 1);
+
+	for (int i = 0; i < p_fragment_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_fragment_strings[i], strlen(p_fragment_strings[i]));
+	}
+	ctx.update((const uint8_t *)"", 1);
+
+	for (int i = 0; i < attribute_pair_count; i++) {
+		ctx.update((const uint8_t *)attribute_pairs[i].name, strlen(attribute_pairs[i].name) + 1);
+		ctx.update((const uint8_t *)&attribute_pairs[i].index, sizeof(attribute_pairs[i].index));
+	}
+
+	for (int i = 0; i < p_feedback.size(); i++) {
+		ctx.update((const uint8_t *)p_feedback[i], strlen(p_feedback[i]) + 1);
+	}
+
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+ShaderGLES3::Version *ShaderGLES3::_setup_version(Version &v, CustomCode *cc) {
 	/* UNIFORMS */
 
 	glUseProgram(v.id);
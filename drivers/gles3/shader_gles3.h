@@ -45,6 +45,8 @@
 
 #include <stdio.h>
 
+class ShaderCacheGLES3;
+
 class ShaderGLES3 {
 protected:
 	struct Enum {
@@ -177,6 +179,8 @@ private:
 	int base_material_tex_index;
 
 	Version *get_current_version();
+	Version *_setup_version(Version &v, CustomCode *cc);
+	String _get_program_cache_key(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings, const Vector<const char *> &p_feedback) const;
 
 	static ShaderGLES3 *active;
 
@@ -287,6 +291,9 @@ public:
 		CUSTOM_SHADER_DISABLED = 0
 	};
 
+	// Shared by all shaders; nullptr when program binaries can't be cached.
+	static ShaderCacheGLES3 *shader_cache;
+
 	GLint get_uniform_location(const String &p_name) const;
 	GLint get_uniform_location(int p_index) const;
 
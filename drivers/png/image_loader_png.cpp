@@ -38,6 +38,15 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 	const uint64_t buffer_size = f->get_len();
+
+	// Decode in place when the file is already in memory (e.g. a memory mapped pack).
+	const uint8_t *borrowed = f->borrow_buffer(buffer_size);
+	if (borrowed) {
+		Error err = PNGDriverCommon::png_to_image(borrowed, buffer_size, p_force_linear, p_image);
+		f->close();
+		return err;
+	}
+
 	PoolVector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
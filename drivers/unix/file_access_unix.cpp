@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -70,8 +71,19 @@ void FileAccessUnix::check_errors() const {
 	}
 }
 
+void FileAccessUnix::_unmap() {
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+#endif
+}
+
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
 	if (f) {
+		_unmap();
 		fclose(f);
 	}
 	f = nullptr;
@@ -153,6 +165,8 @@ void FileAccessUnix::close() {
 		return;
 	}
 
+	_unmap();
+
 	fclose(f);
 	f = nullptr;
 
@@ -248,6 +262,35 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessUnix::map_read_only() {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		return (const uint8_t *)mapped;
+	}
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	uint64_t size = get_len();
+	if (size == 0 || size != (uint64_t)(size_t)size) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = ptr;
+	mapped_size = size;
+	return (const uint8_t *)mapped;
+#else
+	return nullptr;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -344,6 +387,8 @@ CloseNotificationFunc FileAccessUnix::close_notification_func = nullptr;
 FileAccessUnix::FileAccessUnix() :
 		f(nullptr),
 		flags(0),
+		mapped(nullptr),
+		mapped_size(0),
 		last_error(OK) {
 }
 
@@ -43,7 +43,10 @@ typedef void (*CloseNotificationFunc)(const String &p_file, int p_flags);
 class FileAccessUnix : public FileAccess {
 	FILE *f;
 	int flags;
+	void *mapped;
+	uint64_t mapped_size;
 	void check_errors() const;
+	void _unmap();
 	mutable Error last_error;
 	String save_path;
 	String path;
@@ -70,6 +73,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	virtual const uint8_t *map_read_only(); ///< map the file with mmap()
 
 	virtual Error get_error() const; ///< get last error
 
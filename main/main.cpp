@@ -41,6 +41,7 @@
 #include "core/message_queue.h"
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/project_settings.h"
 #include "core/register_core_types.h"
 #include "core/script_debugger_local.h"
@@ -100,6 +101,7 @@ static ZipArchive *zip_packed_data = nullptr;
 static FileAccessNetworkClient *file_access_network_client = nullptr;
 static ScriptDebugger *script_debugger = nullptr;
 static MessageQueue *message_queue = nullptr;
+static ThreadWorkPool *thread_work_pool = nullptr;
 
 // Initialized in setup2()
 static AudioServer *audio_server = nullptr;
@@ -183,6 +185,8 @@ void initialize_physics() {
 	GLOBAL_DEF("physics/3d/godot_physics/use_bvh", true);
 	GLOBAL_DEF("physics/3d/godot_physics/bvh_collision_margin", 0.1);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/godot_physics/bvh_collision_margin", PropertyInfo(Variant::REAL, "physics/3d/godot_physics/bvh_collision_margin", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"));
+	GLOBAL_DEF("physics/3d/godot_physics/solve_islands_in_parallel", false);
+	GLOBAL_DEF("physics/3d/godot_physics/narrow_phase_in_parallel", false);
 
 	/// 3D Physics Server
 	physics_server = PhysicsServerManager::new_server(ProjectSettings::get_singleton()->get(PhysicsServerManager::setting_property_name));
@@ -244,6 +248,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --path <directory>               Path to a project (<directory> must contain a 'project.godot' file).\n");
 	OS::get_singleton()->print("  -u, --upwards                    Scan folders upwards for project.godot file.\n");
 	OS::get_singleton()->print("  --main-pack <file>               Path to a pack (.pck) file to load.\n");
+	OS::get_singleton()->print("  --mmap-packs                     Memory map pack (.pck) files instead of reading them, sharing them between processes.\n");
 	OS::get_singleton()->print("  --render-thread <mode>           Render thread mode ('unsafe', 'safe', 'separate').\n");
 	OS::get_singleton()->print("  --remote-fs <address>            Remote filesystem (<host/IP>[:<port>] address).\n");
 	OS::get_singleton()->print("  --remote-fs-password <password>  Password for remote filesystem.\n");
@@ -804,6 +809,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			};
 
+		} else if (I->get() == "--mmap-packs") {
+			packed_data->set_use_mmap(true);
+
 		} else if (I->get() == "-d" || I->get() == "--debug") {
 			debug_mode = "local";
 			OS::get_singleton()->_debug_stdout = true;
@@ -1226,6 +1234,11 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	message_queue = memnew(MessageQueue);
 
+	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/worker_pool/max_threads", PropertyInfo(Variant::INT, "threading/worker_pool/max_threads", PROPERTY_HINT_RANGE, "-1,256,1,or_greater"));
+	thread_work_pool = memnew(ThreadWorkPool);
+	thread_work_pool->init(GLOBAL_GET("threading/worker_pool/max_threads"));
+
 	if (p_second_phase) {
 		return setup2();
 	}
@@ -2407,6 +2420,11 @@ void Main::cleanup(bool p_force) {
 	message_queue->flush();
 	memdelete(message_queue);
 
+	if (thread_work_pool) {
+		ResourceLoader::stop_threaded_loads();
+		memdelete(thread_work_pool);
+	}
+
 	if (visual_server_callbacks) {
 		memdelete(visual_server_callbacks);
 	}
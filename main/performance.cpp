@@ -30,6 +30,8 @@
 
 #include "performance.h"
 
+#include "core/command_queue_mt.h"
+#include "core/engine.h"
 #include "core/message_queue.h"
 #include "core/os/os.h"
 #include "scene/main/node.h"
@@ -75,6 +77,21 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(STRING_NAME_COUNT);
+	BIND_ENUM_CONSTANT(STRING_NAME_BUCKET_COUNT);
+	BIND_ENUM_CONSTANT(STRING_NAME_USED_BUCKET_COUNT);
+	BIND_ENUM_CONSTANT(STRING_NAME_MAX_CHAIN_LENGTH);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_USAGE);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_RESERVED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOC_CROSS_THREAD_FREES);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_MAX_DEPTH);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_STALLS);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_STALL_TIME);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_PENDING);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_USAGE);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_MEMORY);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSH_TIME);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -88,6 +105,15 @@ float Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+const StringName::TableStats &Performance::_get_string_name_stats() const {
+	uint64_t frame = Engine::get_singleton()->get_idle_frames();
+	if (_string_name_stats_frame != frame) {
+		_string_name_stats = StringName::get_table_stats();
+		_string_name_stats_frame = frame;
+	}
+	return _string_name_stats;
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -123,6 +149,21 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"string_name/names",
+		"string_name/buckets",
+		"string_name/used_buckets",
+		"string_name/max_chain_length",
+		"memory/small_alloc_usage",
+		"memory/small_alloc_reserved",
+		"memory/small_alloc_cross_thread_frees",
+		"command_queue/depth",
+		"command_queue/max_depth",
+		"command_queue/stalls",
+		"command_queue/stall_time",
+		"message_queue/pending",
+		"message_queue/usage",
+		"message_queue/memory",
+		"message_queue/flush_time",
 
 	};
 
@@ -140,11 +181,11 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case MEMORY_STATIC:
 			return Memory::get_mem_usage();
 		case MEMORY_DYNAMIC:
-			return MemoryPool::total_memory;
+			return MemoryPool::total_memory.get();
 		case MEMORY_STATIC_MAX:
 			return Memory::get_mem_max_usage();
 		case MEMORY_DYNAMIC_MAX:
-			return MemoryPool::max_memory;
+			return MemoryPool::max_memory.get();
 		case MEMORY_MESSAGE_BUFFER_MAX:
 			return MessageQueue::get_singleton()->get_max_buffer_usage();
 		case OBJECT_COUNT:
@@ -193,6 +234,36 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case STRING_NAME_COUNT:
+			return _get_string_name_stats().names;
+		case STRING_NAME_BUCKET_COUNT:
+			return _get_string_name_stats().buckets;
+		case STRING_NAME_USED_BUCKET_COUNT:
+			return _get_string_name_stats().used_buckets;
+		case STRING_NAME_MAX_CHAIN_LENGTH:
+			return _get_string_name_stats().max_chain_length;
+		case MEMORY_SMALL_ALLOC_USAGE:
+			return Memory::get_small_alloc_stats().bytes_in_use;
+		case MEMORY_SMALL_ALLOC_RESERVED:
+			return Memory::get_small_alloc_stats().bytes_reserved;
+		case MEMORY_SMALL_ALLOC_CROSS_THREAD_FREES:
+			return Memory::get_small_alloc_stats().cross_thread_frees;
+		case COMMAND_QUEUE_DEPTH:
+			return CommandQueueMT::get_global_stats().depth;
+		case COMMAND_QUEUE_MAX_DEPTH:
+			return CommandQueueMT::get_global_stats().max_depth;
+		case COMMAND_QUEUE_STALLS:
+			return CommandQueueMT::get_global_stats().stall_count;
+		case COMMAND_QUEUE_STALL_TIME:
+			return CommandQueueMT::get_global_stats().stall_usec / 1000000.0;
+		case MESSAGE_QUEUE_PENDING:
+			return MessageQueue::get_singleton()->get_stats().pending;
+		case MESSAGE_QUEUE_USAGE:
+			return MessageQueue::get_singleton()->get_stats().usage;
+		case MESSAGE_QUEUE_MEMORY:
+			return MessageQueue::get_singleton()->get_stats().memory_used;
+		case MESSAGE_QUEUE_FLUSH_TIME:
+			return MessageQueue::get_singleton()->get_stats().last_flush_usec / 1000000.0;
 
 		default: {
 		}
@@ -237,6 +308,21 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
 
 	};
 
@@ -254,5 +340,6 @@ void Performance::set_physics_process_time(float p_pt) {
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
+	_string_name_stats_frame = UINT64_MAX;
 	singleton = this;
 }
@@ -44,6 +44,11 @@ class Performance : public Object {
 
 	float _get_node_count() const;
 
+	// Counting the StringName table walks all of it, so it is done once per frame for all its monitors.
+	mutable StringName::TableStats _string_name_stats;
+	mutable uint64_t _string_name_stats_frame;
+	const StringName::TableStats &_get_string_name_stats() const;
+
 	float _process_time;
 	float _physics_process_time;
 
@@ -82,6 +87,21 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		STRING_NAME_COUNT,
+		STRING_NAME_BUCKET_COUNT,
+		STRING_NAME_USED_BUCKET_COUNT,
+		STRING_NAME_MAX_CHAIN_LENGTH,
+		MEMORY_SMALL_ALLOC_USAGE,
+		MEMORY_SMALL_ALLOC_RESERVED,
+		MEMORY_SMALL_ALLOC_CROSS_THREAD_FREES,
+		COMMAND_QUEUE_DEPTH,
+		COMMAND_QUEUE_MAX_DEPTH,
+		COMMAND_QUEUE_STALLS,
+		COMMAND_QUEUE_STALL_TIME,
+		MESSAGE_QUEUE_PENDING,
+		MESSAGE_QUEUE_USAGE,
+		MESSAGE_QUEUE_MEMORY,
+		MESSAGE_QUEUE_FLUSH_TIME,
 		MONITOR_MAX
 	};
 
@@ -0,0 +1,135 @@
+/*************************************************************************/
+/*  test_bvh.cpp                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_bvh.h"
+
+#include "core/math/bvh.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+
+#define ITEM_COUNT 2000
+
+namespace TestBVH {
+
+struct TestItem {
+	int id;
+};
+
+static TestItem items[ITEM_COUNT];
+static AABB bounds[ITEM_COUNT];
+
+static AABB random_bounds(real_t p_range) {
+	return AABB(Vector3(Math::random((real_t)0, p_range), Math::random((real_t)0, p_range), Math::random((real_t)0, p_range)), Vector3(1, 1, 1));
+}
+
+// Checks a cull finds every item it should. Leaf bounds are expanded for pairing, so it may find a few more.
+static bool cull_finds_all(BVH_Manager<TestItem, true, 128> &p_bvh, const AABB &p_aabb) {
+	TestItem *results[ITEM_COUNT];
+	int count = p_bvh.cull_aabb(p_aabb, results, ITEM_COUNT);
+
+	bool found[ITEM_COUNT] = {};
+	for (int i = 0; i < count; i++) {
+		found[results[i]->id] = true;
+	}
+	for (int i = 0; i < ITEM_COUNT; i++) {
+		if (!found[i] && bounds[i].intersects(p_aabb)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_deferred_refit() {
+	Math::seed(0);
+	BVH_Manager<TestItem, true, 128> bvh;
+	BVHHandle handles[ITEM_COUNT];
+	for (int i = 0; i < ITEM_COUNT; i++) {
+		items[i].id = i;
+		bounds[i] = random_bounds(100);
+		handles[i] = bvh.create(&items[i], true, bounds[i], 0, i & 1, 1, 1);
+	}
+	bvh.update();
+
+	bool ok = true;
+	for (int frame = 0; frame < 10; frame++) {
+		// Far enough that most items leave their leaves, alternately spreading out and gathering in.
+		uint32_t passes_before = bvh.get_deferred_refit_pass_count();
+		for (int i = 0; i < ITEM_COUNT; i++) {
+			bounds[i] = random_bounds(frame & 1 ? 20 : 200);
+			bvh.move(handles[i], bounds[i]);
+		}
+		ok = ok && bvh.get_deferred_refit_pass_count() == passes_before;
+
+		for (int i = 0; i < 20; i++) {
+			ok = cull_finds_all(bvh, AABB(Vector3(Math::random((real_t)0, (real_t)200), Math::random((real_t)0, (real_t)200), Math::random((real_t)0, (real_t)200)), Vector3(20, 20, 20))) && ok;
+		}
+		OS::get_singleton()->print("\t%i moves, %i refit passes\n", ITEM_COUNT, bvh.get_deferred_refit_pass_count() - passes_before);
+		ok = ok && bvh.get_deferred_refit_pass_count() == passes_before + 1;
+
+		if (frame & 1) {
+			bvh.update();
+		}
+	}
+
+	for (int i = 0; i < ITEM_COUNT; i++) {
+		bvh.erase(handles[i]);
+	}
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_deferred_refit,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestBVH
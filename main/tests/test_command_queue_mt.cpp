@@ -0,0 +1,220 @@
+/*************************************************************************/
+/*  test_command_queue_mt.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_command_queue_mt.h"
+
+#include "core/command_queue_mt.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/project_settings.h"
+#include "core/safe_refcount.h"
+
+#define PRODUCER_COUNT 4
+#define COMMANDS_PER_PRODUCER 200000
+
+namespace TestCommandQueueMT {
+
+// Runs on the consumer thread, like a server does.
+struct Receiver {
+	int last[PRODUCER_COUNT] = {};
+	int out_of_order = 0;
+	uint64_t received = 0;
+	SafeFlag exit;
+
+	void receive(int p_producer, int p_sequence) {
+		if (p_sequence != last[p_producer] + 1) {
+			out_of_order++;
+		}
+		last[p_producer] = p_sequence;
+		received++;
+	}
+
+	int twice(int p_value) {
+		return p_value * 2;
+	}
+
+	void quit() {
+		exit.set();
+	}
+};
+
+struct Context {
+	CommandQueueMT *queue;
+	Receiver receiver;
+	SafeNumeric<int> wrong_returns;
+	Semaphore pushed;
+	Semaphore resume;
+};
+
+static void _consume(void *p_data) {
+	Context *context = (Context *)p_data;
+	while (!context->receiver.exit.is_set()) {
+		context->queue->wait_and_flush_one();
+	}
+}
+
+struct Producer {
+	Context *context;
+	int id;
+};
+
+static void _produce(void *p_data) {
+	Producer *producer = (Producer *)p_data;
+	CommandQueueMT *queue = producer->context->queue;
+	for (int i = 1; i <= COMMANDS_PER_PRODUCER; i++) {
+		queue->push(&producer->context->receiver, &Receiver::receive, producer->id, i);
+		if ((i & 1023) == 0) {
+			int ret = 0;
+			queue->push_and_ret(&producer->context->receiver, &Receiver::twice, i, &ret);
+			if (ret != i * 2) {
+				producer->context->wrong_returns.increment();
+			}
+		}
+	}
+}
+
+bool test_stress() {
+	OS::get_singleton()->print("\n\nTest %d producers, %d commands each\n", PRODUCER_COUNT, COMMANDS_PER_PRODUCER);
+
+	Context context;
+	context.queue = memnew(CommandQueueMT(true));
+
+	Thread consumer;
+	consumer.start(_consume, &context);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Producer producers[PRODUCER_COUNT];
+	Thread threads[PRODUCER_COUNT];
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		producers[i].context = &context;
+		producers[i].id = i;
+		threads[i].start(_produce, &producers[i]);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+	context.queue->push_and_sync(&context.receiver, &Receiver::quit);
+	consumer.wait_to_finish();
+	OS::get_singleton()->print("\t%.1f msec\n", (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0);
+
+	CommandQueueMT::Stats stats = context.queue->get_stats();
+	memdelete(context.queue);
+
+	bool all_received = context.receiver.received == PRODUCER_COUNT * (uint64_t)COMMANDS_PER_PRODUCER;
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		all_received = all_received && context.receiver.last[i] == COMMANDS_PER_PRODUCER;
+	}
+	return all_received && context.receiver.out_of_order == 0 && context.wrong_returns.get() == 0 && stats.depth == 0;
+}
+
+#define IDLE_PRODUCER_COUNT 16
+
+static void _push_one_and_wait(void *p_data) {
+	Producer *producer = (Producer *)p_data;
+	producer->context->queue->push(&producer->context->receiver, &Receiver::receive, 0, producer->id + 1);
+	producer->context->pushed.post();
+	producer->context->resume.wait();
+}
+
+bool test_staging_budget() {
+	OS::get_singleton()->print("\n\nTest many producers keep to the memory budget\n");
+
+	// Every producer holds a partly written block until it exits, which the consumer can't free.
+	Context context;
+	context.queue = memnew(CommandQueueMT(false));
+	uint64_t budget = uint64_t(GLOBAL_GET("memory/limits/command_queue/multithreading_queue_size_kb")) * 1024;
+
+	Producer producers[IDLE_PRODUCER_COUNT];
+	Thread threads[IDLE_PRODUCER_COUNT];
+	for (int i = 0; i < IDLE_PRODUCER_COUNT; i++) {
+		// One at a time, so the receiver sees them in order.
+		producers[i].context = &context;
+		producers[i].id = i;
+		threads[i].start(_push_one_and_wait, &producers[i]);
+		// Run what was pushed meanwhile, so a producer waiting for room isn't stuck forever when the budget is exceeded.
+		while (!context.pushed.try_wait()) {
+			context.queue->flush_all();
+			OS::get_singleton()->delay_usec(100);
+		}
+	}
+
+	CommandQueueMT::Stats stats = context.queue->get_stats();
+	OS::get_singleton()->print("\t%d KiB staged for a budget of %d KiB\n", int(stats.memory_used / 1024), int(budget / 1024));
+
+	for (int i = 0; i < IDLE_PRODUCER_COUNT; i++) {
+		context.resume.post();
+	}
+	for (int i = 0; i < IDLE_PRODUCER_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+	context.queue->flush_all();
+	memdelete(context.queue);
+
+	return stats.memory_used <= budget && context.receiver.received == IDLE_PRODUCER_COUNT && context.receiver.out_of_order == 0;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_stress,
+	test_staging_budget,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestCommandQueueMT
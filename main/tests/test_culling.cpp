@@ -0,0 +1,250 @@
+/*************************************************************************/
+/*  test_culling.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_culling.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "servers/visual/visual_server_globals.h"
+#include "servers/visual/visual_server_scene.h"
+#include "servers/visual_server.h"
+
+#define INSTANCE_COUNT 50000
+#define LIGHT_COUNT 16
+#define LIGHT_RANGE 40
+#define FRAME_COUNT 20
+
+namespace TestCulling {
+
+template <class T>
+static bool _is_same_list(const Vector<T> &p_a, const Vector<T> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		if (p_a[i] != p_b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Measures how long VisualServerScene takes to cull and prepare a large scene for a camera, with serial and parallel culling,
+// and checks both cull the same instances in the same order, for the camera and for the shadow casters of each light.
+// Nothing is drawn, so it can run headless with the dummy rasterizer (e.g. the server platform), where lights have no effect.
+// The instance count can be passed as the last argument.
+class TestMainLoop : public MainLoop {
+	RID mesh;
+	RID scenario;
+	RID camera;
+	RID shadow_atlas;
+	List<RID> instances;
+	List<RID> lights;
+	Vector<Vector3> light_positions;
+
+	double _measure_frame_msec(bool p_parallel_culling) {
+		VSG::scene->set_parallel_culling(p_parallel_culling);
+
+		// The first frame pairs the lights with the geometry.
+		VSG::scene->render_camera(camera, scenario, Size2(1920, 1080), shadow_atlas);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < FRAME_COUNT; i++) {
+			VSG::scene->render_camera(camera, scenario, Size2(1920, 1080), shadow_atlas);
+		}
+		return (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0 / FRAME_COUNT;
+	}
+
+	void _cull_camera(bool p_parallel_culling, Vector<VisualServerScene::Instance *> &r_result, Vector<float> &r_depths) {
+		VSG::scene->set_parallel_culling(p_parallel_culling);
+		VSG::scene->render_camera(camera, scenario, Size2(1920, 1080), shadow_atlas);
+
+		for (int i = 0; i < VSG::scene->instance_cull_count; i++) {
+			r_result.push_back(VSG::scene->instance_cull_result[i]);
+			r_depths.push_back(VSG::scene->instance_cull_result[i]->depth);
+		}
+	}
+
+	// Culls the shadow casters in a box around the light, the way the light's shadow passes do.
+	void _cull_shadow_casters(bool p_parallel_culling, const Vector3 &p_light_position, Vector<VisualServerScene::Instance *> &r_result, Vector<float> &r_depths, bool &r_animated_material_found) {
+		VSG::scene->set_parallel_culling(p_parallel_culling);
+
+		Vector<Plane> planes;
+		for (int i = 0; i < 3; i++) {
+			Vector3 axis;
+			axis[i] = 1;
+			planes.push_back(Plane(axis, p_light_position[i] + LIGHT_RANGE));
+			planes.push_back(Plane(-axis, -p_light_position[i] + LIGHT_RANGE));
+		}
+
+		int32_t previous_room_id_hint = -1;
+		VisualServerScene::Scenario *scenario_data = VSG::scene->scenario_owner.getornull(scenario);
+		int cull_count = VSG::scene->_cull_convex_from_point(scenario_data, p_light_position, planes, VSG::scene->instance_shadow_cull_result, VisualServerScene::MAX_INSTANCE_CULL, previous_room_id_hint, VS::INSTANCE_GEOMETRY_MASK);
+		cull_count = VSG::scene->_cull_shadow_casters(cull_count, Plane(p_light_position, Vector3(0, 0, -1)), r_animated_material_found);
+
+		for (int i = 0; i < cull_count; i++) {
+			r_result.push_back(VSG::scene->instance_shadow_cull_result[i]);
+			r_depths.push_back(VSG::scene->instance_shadow_cull_result[i]->depth);
+		}
+	}
+
+	bool _compare_culling() {
+		Vector<VisualServerScene::Instance *> serial_result;
+		Vector<VisualServerScene::Instance *> parallel_result;
+		Vector<float> serial_depths;
+		Vector<float> parallel_depths;
+		_cull_camera(false, serial_result, serial_depths);
+		_cull_camera(true, parallel_result, parallel_depths);
+
+		bool match = serial_result.size() > 0 && _is_same_list(serial_result, parallel_result) && _is_same_list(serial_depths, parallel_depths);
+		if (!match) {
+			print_line("\tcamera: " + itos(serial_result.size()) + " instances culled serially, " + itos(parallel_result.size()) + " in parallel, order or depths differ");
+		}
+
+		for (int i = 0; i < light_positions.size(); i++) {
+			serial_result.clear();
+			parallel_result.clear();
+			serial_depths.clear();
+			parallel_depths.clear();
+			bool serial_animated = false;
+			bool parallel_animated = false;
+			_cull_shadow_casters(false, light_positions[i], serial_result, serial_depths, serial_animated);
+			_cull_shadow_casters(true, light_positions[i], parallel_result, parallel_depths, parallel_animated);
+
+			if (!_is_same_list(serial_result, parallel_result) || !_is_same_list(serial_depths, parallel_depths) || serial_animated != parallel_animated) {
+				print_line("\tlight " + itos(i) + ": " + itos(serial_result.size()) + " shadow casters culled serially, " + itos(parallel_result.size()) + " in parallel, order or depths differ");
+				match = false;
+			}
+		}
+
+		return match;
+	}
+
+public:
+	virtual void init() {
+		print_line("INITIALIZING TEST CULLING");
+
+		if (OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD) {
+			print_line("Culling test needs the visual server on the main thread, skipping.");
+			return;
+		}
+
+		VisualServer *vs = VisualServer::get_singleton();
+		scenario = vs->scenario_create();
+		mesh = vs->get_test_cube();
+
+		int instance_count = INSTANCE_COUNT;
+		List<String> cmdline = OS::get_singleton()->get_cmdline_args();
+		if (cmdline.size() > 0 && cmdline[cmdline.size() - 1].to_int()) {
+			instance_count = cmdline[cmdline.size() - 1].to_int();
+		}
+
+		for (int i = 0; i < instance_count; i++) {
+			RID instance = vs->instance_create2(mesh, scenario);
+			// The dummy rasterizer reports empty mesh AABBs.
+			vs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+			vs->instance_set_transform(instance, Transform(Basis(), Vector3(Math::random(-300, 300), Math::random(-100, 100), Math::random(-600, 50))));
+			// Some instances are dropped after the BVH query, so the results have gaps to compact.
+			if (i % 5 == 0) {
+				vs->instance_geometry_set_cast_shadows_setting(instance, VS::SHADOW_CASTING_SETTING_OFF);
+			}
+			if (i % 7 == 0) {
+				vs->instance_set_layer_mask(instance, 2);
+			}
+			instances.push_back(instance);
+		}
+
+		for (int i = 0; i < LIGHT_COUNT; i++) {
+			RID light = vs->omni_light_create();
+			vs->light_set_param(light, VS::LIGHT_PARAM_RANGE, LIGHT_RANGE);
+			vs->light_set_shadow(light, true);
+			RID instance = vs->instance_create2(light, scenario);
+			Vector3 position(Math::random(-100, 100), Math::random(-20, 20), Math::random(-300, -20));
+			vs->instance_set_transform(instance, Transform(Basis(), position));
+			light_positions.push_back(position);
+			lights.push_back(light);
+			instances.push_back(instance);
+		}
+
+		camera = vs->camera_create();
+		vs->camera_set_perspective(camera, 60, 0.1, 1000);
+		vs->camera_set_transform(camera, Transform(Basis(), Vector3(0, 0, 60)));
+		vs->camera_set_cull_mask(camera, 1);
+
+		shadow_atlas = VSG::scene_render->shadow_atlas_create();
+		VSG::scene_render->shadow_atlas_set_size(shadow_atlas, 4096);
+
+		VSG::scene->update_dirty_instances();
+
+		bool was_parallel = VSG::scene->is_parallel_culling_enabled();
+		double serial_msec = _measure_frame_msec(false);
+		double parallel_msec = _measure_frame_msec(true);
+		bool match = _compare_culling();
+		VSG::scene->set_parallel_culling(was_parallel);
+
+		print_line("Culling " + itos(instance_count) + " instances and " + itos(LIGHT_COUNT) + " lights, per frame:");
+		print_line("\tserial: " + rtos(serial_msec) + " msec");
+		print_line("\tparallel: " + rtos(parallel_msec) + " msec");
+		print_line(String("Serial and parallel results match: ") + (match ? "PASS" : "FAILED"));
+	}
+
+	virtual bool iteration(float p_time) {
+		return true;
+	}
+
+	virtual bool idle(float p_time) {
+		return true;
+	}
+
+	virtual void finish() {
+		VisualServer *vs = VisualServer::get_singleton();
+		for (List<RID>::Element *E = instances.front(); E; E = E->next()) {
+			vs->free(E->get());
+		}
+		for (List<RID>::Element *E = lights.front(); E; E = E->next()) {
+			vs->free(E->get());
+		}
+		if (shadow_atlas.is_valid()) {
+			VSG::scene_render->free(shadow_atlas);
+		}
+		if (camera.is_valid()) {
+			vs->free(camera);
+		}
+		if (scenario.is_valid()) {
+			vs->free(scenario);
+		}
+	}
+};
+
+MainLoop *test() {
+	return memnew(TestMainLoop);
+}
+} // namespace TestCulling
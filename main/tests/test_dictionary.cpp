@@ -0,0 +1,247 @@
+/*************************************************************************/
+/*  test_dictionary.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_dictionary.h"
+
+#include "core/dictionary.h"
+#include "core/ordered_hash_map.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+
+#define SMALL_COUNT 100000
+#define LARGE_COUNT 100000
+#define LOOKUP_COUNT 1000000
+
+namespace TestDictionary {
+
+typedef OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> VariantMap;
+
+// Compares Dictionary with OrderedHashMap<Variant, Variant>, which used to back it: memory and time spent
+// on many small dictionaries, like parsed JSON, and lookups in a large one. Also checks that insertion
+// order, iteration and pointers to values survive growing and erasing.
+
+bool test_semantics() {
+	OS::get_singleton()->print("\n\nTest insertion order, iteration and value pointers\n");
+
+	bool state = true;
+	Dictionary d;
+	Variant *first = &d["first"];
+	*first = 1;
+	for (int i = 0; i < 1000; i++) {
+		d[i] = i;
+	}
+	state = state && d.getptr("first") == first && int(*first) == 1;
+
+	for (int i = 0; i < 1000; i += 2) {
+		d.erase(i);
+	}
+	state = state && d.size() == 501;
+	state = state && String(d.get_key_at_index(0)) == "first" && int(d.get_key_at_index(1)) == 1 && int(d.get_key_at_index(500)) == 999;
+
+	int expected = -1;
+	bool in_order = true;
+	for (const Variant *key = d.next(); key; key = d.next(key)) {
+		if (key->get_type() == Variant::INT) {
+			in_order = in_order && int(*key) == expected + 2;
+			expected = *key;
+		}
+	}
+	state = state && in_order && expected == 999;
+
+	Variant copy_key = 501;
+	state = state && int(*d.next(&copy_key)) == 503;
+
+	Dictionary shared = d;
+	shared[-1] = -1;
+	state = state && d.has(-1) && d.id() == shared.id();
+	Dictionary duplicated = d.duplicate();
+	duplicated.erase(-1);
+	state = state && d.has(-1) && duplicated.size() == d.size() - 1 && duplicated.get_key_at_index(0) == d.get_key_at_index(0);
+
+	d.clear();
+	state = state && d.empty() && !d.next() && !shared.has(1);
+	d[1] = 2;
+	state = state && int(d[1]) == 2 && d.size() == 1;
+
+	return state;
+}
+
+bool test_small() {
+	OS::get_singleton()->print("\n\nTest %d small dictionaries\n", SMALL_COUNT);
+
+	const char *names[] = { "id", "name", "type", "position", "rotation", "health", "tags", "inventory" };
+	Vector<Variant> fields;
+	for (int i = 0; i < 8; i++) {
+		fields.push_back(String(names[i]));
+	}
+
+	uint64_t mem = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Vector<Dictionary> dictionaries;
+	dictionaries.resize(SMALL_COUNT);
+	for (int i = 0; i < SMALL_COUNT; i++) {
+		Dictionary &d = dictionaries.write[i];
+		for (int j = 0; j < fields.size(); j++) {
+			d[fields[j]] = i + j;
+		}
+	}
+	uint64_t dictionary_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t dictionary_mem = Memory::get_mem_usage() - mem;
+
+	int64_t total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < SMALL_COUNT; i++) {
+		total += int64_t(dictionaries[i][fields[i % fields.size()]]);
+	}
+	uint64_t dictionary_lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	dictionaries.clear();
+
+	mem = Memory::get_mem_usage();
+	begin = OS::get_singleton()->get_ticks_usec();
+	Vector<VariantMap *> maps;
+	maps.resize(SMALL_COUNT);
+	for (int i = 0; i < SMALL_COUNT; i++) {
+		VariantMap *map = memnew(VariantMap);
+		for (int j = 0; j < fields.size(); j++) {
+			(*map)[fields[j]] = i + j;
+		}
+		maps.write[i] = map;
+	}
+	uint64_t map_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t map_mem = Memory::get_mem_usage() - mem;
+
+	int64_t map_total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < SMALL_COUNT; i++) {
+		map_total += int64_t((*maps[i])[fields[i % fields.size()]]);
+	}
+	uint64_t map_lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	for (int i = 0; i < SMALL_COUNT; i++) {
+		memdelete(maps[i]);
+	}
+
+	OS::get_singleton()->print("\tDictionary: %.1f bytes each, %.2f msec to build, %.1f nsec per lookup\n", dictionary_mem / double(SMALL_COUNT), dictionary_usec / 1000.0, dictionary_lookup_usec * 1000.0 / SMALL_COUNT);
+	OS::get_singleton()->print("\tOrderedHashMap: %.1f bytes each, %.2f msec to build, %.1f nsec per lookup\n", map_mem / double(SMALL_COUNT), map_usec / 1000.0, map_lookup_usec * 1000.0 / SMALL_COUNT);
+
+	return total == map_total;
+}
+
+bool test_large() {
+	OS::get_singleton()->print("\n\nTest a dictionary of %d integer keys\n", LARGE_COUNT);
+
+	Dictionary dictionary;
+	VariantMap map;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LARGE_COUNT; i++) {
+		dictionary[i] = i;
+	}
+	uint64_t dictionary_insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LARGE_COUNT; i++) {
+		map[i] = i;
+	}
+	uint64_t map_insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int64_t total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOOKUP_COUNT; i++) {
+		total += int64_t(*dictionary.getptr(int((i * 7919LL) % LARGE_COUNT)));
+	}
+	uint64_t dictionary_lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int64_t map_total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOOKUP_COUNT; i++) {
+		map_total += int64_t(map.find(int((i * 7919LL) % LARGE_COUNT)).value());
+	}
+	uint64_t map_lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	bool state = total == map_total;
+
+	total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (const Variant *key = dictionary.next(); key; key = dictionary.next(key)) {
+		total += int64_t(*key);
+	}
+	uint64_t dictionary_iterate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	map_total = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (VariantMap::Element E = map.front(); E; E = E.next()) {
+		map_total += int64_t(E.key());
+	}
+	uint64_t map_iterate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	state = state && total == map_total;
+
+	OS::get_singleton()->print("\tDictionary: %.2f msec to build, %.1f nsec per lookup, %.2f msec to iterate\n", dictionary_insert_usec / 1000.0, dictionary_lookup_usec * 1000.0 / LOOKUP_COUNT, dictionary_iterate_usec / 1000.0);
+	OS::get_singleton()->print("\tOrderedHashMap: %.2f msec to build, %.1f nsec per lookup, %.2f msec to iterate\n", map_insert_usec / 1000.0, map_lookup_usec * 1000.0 / LOOKUP_COUNT, map_iterate_usec / 1000.0);
+
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_semantics,
+	test_small,
+	test_large,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestDictionary
@@ -0,0 +1,194 @@
+/*************************************************************************/
+/*  test_file_access.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_file_access.h"
+
+#include "core/io/file_access_memory.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+
+#define DATA_SIZE 100000
+
+namespace TestFileAccess {
+
+static String _get_test_dir() {
+	return OS::get_singleton()->get_user_data_dir().plus_file("file_access_test");
+}
+
+static Vector<uint8_t> _make_data() {
+	Vector<uint8_t> data;
+	data.resize(DATA_SIZE);
+	for (int i = 0; i < DATA_SIZE; i++) {
+		data.write[i] = (i * 7 + i / 251) & 0xFF;
+	}
+	return data;
+}
+
+static String _write_data_file(const Vector<uint8_t> &p_data) {
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->make_dir_recursive(_get_test_dir());
+
+	String path = _get_test_dir().plus_file("data.bin");
+	FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+	if (!f) {
+		return String();
+	}
+	f->store_buffer(p_data.ptr(), p_data.size());
+	f->close();
+	return path;
+}
+
+bool test_plain_file() {
+	OS::get_singleton()->print("\n\nTest borrowing buffers from plain files\n");
+
+	Vector<uint8_t> data = _make_data();
+	String path = _write_data_file(data);
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	if (!f) {
+		OS::get_singleton()->print("\tCan't write %s\n", path.utf8().get_data());
+		return false;
+	}
+
+	// Regular files don't lend buffers, nothing is read then.
+	bool state = f->borrow_buffer(16) == nullptr && f->get_position() == 0;
+
+	// Mapping is optional, but what is mapped must be the whole file.
+	const uint8_t *mapped = f->map_read_only();
+	if (mapped) {
+		state = state && memcmp(mapped, data.ptr(), DATA_SIZE) == 0;
+	} else {
+		OS::get_singleton()->print("\tMapping files is not supported\n");
+	}
+	memdelete(f);
+
+	// Memory files lend the bytes they were opened with.
+	FileAccessMemory *fm = memnew(FileAccessMemory);
+	state = state && fm->open_custom(data.ptr(), data.size()) == OK;
+	fm->seek(100);
+	const uint8_t *borrowed = fm->borrow_buffer(1000);
+	state = state && borrowed == data.ptr() + 100 && fm->get_position() == 1100;
+	state = state && fm->borrow_buffer(DATA_SIZE) == nullptr && fm->get_position() == 1100;
+	memdelete(fm);
+
+	return state;
+}
+
+bool test_mapped_pack() {
+	OS::get_singleton()->print("\n\nTest borrowing buffers from a memory mapped pack\n");
+
+	Vector<uint8_t> data = _make_data();
+	String data_path = _write_data_file(data);
+	String pack_path = _get_test_dir().plus_file("test.pck");
+
+	PCKPacker packer;
+	bool state = packer.pck_start(pack_path) == OK;
+	state = state && packer.add_file("res://file_access_test/data.bin", data_path) == OK;
+	state = state && packer.flush() == OK;
+	if (!state) {
+		OS::get_singleton()->print("\tCan't write %s\n", pack_path.utf8().get_data());
+		return false;
+	}
+
+	// PackedData frees its sources, files registered by this one stay valid until then.
+	PackedSourcePCKMapped *source = memnew(PackedSourcePCKMapped);
+	PackedData::get_singleton()->add_pack_source(source);
+	state = source->try_open_pack(pack_path, false, 0);
+
+	FileAccess *f = PackedData::get_singleton()->try_open_path("res://file_access_test/data.bin");
+	if (!state || !f) {
+		OS::get_singleton()->print("\tCan't open the pack\n");
+		return false;
+	}
+
+	state = f->get_len() == DATA_SIZE;
+	uint8_t first[4];
+	state = state && f->get_buffer(first, 4) == 4 && memcmp(first, data.ptr(), 4) == 0;
+
+	const uint8_t *borrowed = f->borrow_buffer(1000);
+	if (borrowed) {
+		state = state && memcmp(borrowed, data.ptr() + 4, 1000) == 0 && f->get_position() == 1004;
+	} else {
+		OS::get_singleton()->print("\tMapping files is not supported\n");
+	}
+
+	// Borrowing must not reach past the file's end in the pack.
+	f->seek(DATA_SIZE - 10);
+	state = state && f->borrow_buffer(11) == nullptr;
+	borrowed = f->borrow_buffer(10);
+	state = state && (!borrowed || memcmp(borrowed, data.ptr() + DATA_SIZE - 10, 10) == 0);
+	memdelete(f);
+
+	DirAccessRef da = DirAccess::open(_get_test_dir());
+	if (da) {
+		da->erase_contents_recursive();
+	}
+
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_plain_file,
+	test_mapped_pack,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestFileAccess
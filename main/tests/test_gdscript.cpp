@@ -543,6 +543,19 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += DADDR(3);
 					incr += 5;
 
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+					txt += " op_validated ";
+
+					String opname = Variant::get_operator_name(func.get_validated_operator(code[ip + 1]));
+
+					txt += DADDR(4);
+					txt += " = ";
+					txt += DADDR(2);
+					txt += " " + opname + " ";
+					txt += DADDR(3);
+					incr += 5;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET: {
 					txt += "set ";
@@ -564,6 +577,17 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "]";
 					incr += 4;
 
+				} break;
+				case GDScriptFunction::OPCODE_GET_VALIDATED: {
+					txt += " get_validated ";
+					txt += DADDR(4);
+					txt += "=";
+					txt += DADDR(1);
+					txt += "[";
+					txt += DADDR(2);
+					txt += "]";
+					incr += 5;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET_NAMED: {
 					txt += " set_named ";
@@ -585,6 +609,17 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "\"]";
 					incr += 4;
 
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+					txt += " get_named_validated ";
+					txt += DADDR(4);
+					txt += "=";
+					txt += DADDR(1);
+					txt += "[\"";
+					txt += func.get_global_name(code[ip + 2]);
+					txt += "\"]";
+					incr += 5;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET_MEMBER: {
 					txt += " set_member ";
@@ -748,6 +783,36 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					incr = 5 + argc;
 
+				} break;
+				case GDScriptFunction::OPCODE_CALL_VALIDATED:
+				case GDScriptFunction::OPCODE_CALL_RETURN_VALIDATED: {
+					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_RETURN_VALIDATED;
+
+					if (ret) {
+						txt += " call-ret-validated ";
+					} else {
+						txt += " call-validated ";
+					}
+
+					int argc = code[ip + 1];
+					if (ret) {
+						txt += DADDR(5 + argc) + "=";
+					}
+
+					txt += DADDR(2) + ".";
+					txt += String(func.get_global_name(code[ip + 3]));
+					txt += "(";
+
+					for (int i = 0; i < argc; i++) {
+						if (i > 0) {
+							txt += ", ";
+						}
+						txt += DADDR(5 + i);
+					}
+					txt += ")";
+
+					incr = 6 + argc;
+
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
 					txt += " call-built-in ";
@@ -883,7 +948,206 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 	}
 }
 
+// Validated instructions are only emitted when the compiler knows the types, so each script below computes the same
+// results twice: in typed_result() with static types, and in untyped_result() without them, on the generic path.
+static bool _validated_matches_generic(const String &p_code) {
+	Ref<GDScript> gds;
+	gds.instance();
+	gds->set_source_code(p_code);
+	if (gds->reload() != OK) {
+		OS::get_singleton()->print("\tScript failed to compile.\n");
+		return false;
+	}
+
+	Variant script = gds;
+	Variant typed = script.call("typed_result");
+	Variant untyped = script.call("untyped_result");
+	if (!typed.hash_compare(untyped)) {
+		OS::get_singleton()->print("\tTyped: %s\n\tUntyped: %s\n", String(typed).utf8().get_data(), String(untyped).utf8().get_data());
+		return false;
+	}
+	return true;
+}
+
+static bool test_validated_operators() {
+	OS::get_singleton()->print("\n\nTest validated operators\n");
+
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar a: int = 7\n"
+			"\tvar b: int = -2\n"
+			"\tvar f: float = 2.5\n"
+			"\tvar v := Vector2(1, 2)\n"
+			"\tvar w := Vector3(1, 2, 3)\n"
+			"\tvar c := Color(1, 0.5, 0.25, 1)\n"
+			"\treturn [a + b, a - b, a * b, a / b, a % b, -a, a * f, a / f, f - a, -f, a < b, a >= f, a == 7, f != 2.5, not (a < b), v * 2, v / f, v + v, -v, v == Vector2(1, 2), w * w, w - w, c * 0.5, c + c]\n"
+			"static func untyped_result():\n"
+			"\tvar a = 7\n"
+			"\tvar b = -2\n"
+			"\tvar f = 2.5\n"
+			"\tvar v = Vector2(1, 2)\n"
+			"\tvar w = Vector3(1, 2, 3)\n"
+			"\tvar c = Color(1, 0.5, 0.25, 1)\n"
+			"\treturn [a + b, a - b, a * b, a / b, a % b, -a, a * f, a / f, f - a, -f, a < b, a >= f, a == 7, f != 2.5, not (a < b), v * 2, v / f, v + v, -v, v == Vector2(1, 2), w * w, w - w, c * 0.5, c + c]\n");
+}
+
+static bool test_validated_getters() {
+	OS::get_singleton()->print("\n\nTest validated member and index getters\n");
+
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar v := Vector2(1, 2)\n"
+			"\tvar w := Vector3(1, 2, 3)\n"
+			"\tvar c := Color(1, 0.5, 0.25, 1)\n"
+			"\tvar r := Rect2(1, 2, 3, 4)\n"
+			"\tvar t := Transform(Basis(), Vector3(4, 5, 6))\n"
+			"\tvar a: Array = [10, \"x\", 30]\n"
+			"\tvar pi := PoolIntArray([4, 5, 6])\n"
+			"\tvar ps := PoolStringArray([\"a\", \"b\"])\n"
+			"\tvar i: int = 1\n"
+			"\treturn [v.x, v.y, w.z, c.g, c.a, r.position, r.size, r.end, t.origin, a[i], a[-1], pi[2], pi[-3], ps[i]]\n"
+			"static func untyped_result():\n"
+			"\tvar v = Vector2(1, 2)\n"
+			"\tvar w = Vector3(1, 2, 3)\n"
+			"\tvar c = Color(1, 0.5, 0.25, 1)\n"
+			"\tvar r = Rect2(1, 2, 3, 4)\n"
+			"\tvar t = Transform(Basis(), Vector3(4, 5, 6))\n"
+			"\tvar a = [10, \"x\", 30]\n"
+			"\tvar pi = PoolIntArray([4, 5, 6])\n"
+			"\tvar ps = PoolStringArray([\"a\", \"b\"])\n"
+			"\tvar i = 1\n"
+			"\treturn [v.x, v.y, w.z, c.g, c.a, r.position, r.size, r.end, t.origin, a[i], a[-1], pi[2], pi[-3], ps[i]]\n");
+}
+
+static bool test_validated_division_by_zero() {
+	OS::get_singleton()->print("\n\nTest validated operators falling back on division by zero\n");
+
+	// Both report the error and return null.
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar a: int = 7\n"
+			"\tvar b: int = 0\n"
+			"\treturn [a % 2, a / b]\n"
+			"static func untyped_result():\n"
+			"\tvar a = 7\n"
+			"\tvar b = 0\n"
+			"\treturn [a % 2, a / b]\n") &&
+			_validated_matches_generic(
+					"static func typed_result():\n"
+					"\tvar a: int = 7\n"
+					"\tvar b: int = 0\n"
+					"\treturn a % b\n"
+					"static func untyped_result():\n"
+					"\tvar a = 7\n"
+					"\tvar b = 0\n"
+					"\treturn a % b\n");
+}
+
+static bool test_validated_index_out_of_bounds() {
+	OS::get_singleton()->print("\n\nTest validated index getters falling back out of bounds\n");
+
+	// Both report the error and return null.
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar a: Array = [1, 2, 3]\n"
+			"\tvar i: int = 3\n"
+			"\treturn a[i]\n"
+			"static func untyped_result():\n"
+			"\tvar a = [1, 2, 3]\n"
+			"\tvar i = 3\n"
+			"\treturn a[i]\n") &&
+			_validated_matches_generic(
+					"static func typed_result():\n"
+					"\tvar a := PoolIntArray([1, 2, 3])\n"
+					"\tvar i: int = -4\n"
+					"\treturn a[i]\n"
+					"static func untyped_result():\n"
+					"\tvar a = PoolIntArray([1, 2, 3])\n"
+					"\tvar i = -4\n"
+					"\treturn a[i]\n");
+}
+
+static bool test_validated_builtin_calls() {
+	OS::get_singleton()->print("\n\nTest validated built-in method calls\n");
+
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar v := Vector3(1, 2, 3)\n"
+			"\tvar w := Vector3(4, 5, 6)\n"
+			"\tvar a: Array = [3, 1, 2]\n"
+			"\tvar s: String = \"Hello\"\n"
+			"\ta.push_back(9)\n"
+			"\ta.sort()\n"
+			"\treturn [v.dot(w), v.cross(w), v.normalized(), s.to_upper(), s.find(\"l\"), a, a.size(), Color(1, 0.5, 0).inverted()]\n"
+			"static func untyped_result():\n"
+			"\tvar v = Vector3(1, 2, 3)\n"
+			"\tvar w = Vector3(4, 5, 6)\n"
+			"\tvar a = [3, 1, 2]\n"
+			"\tvar s = \"Hello\"\n"
+			"\ta.push_back(9)\n"
+			"\ta.sort()\n"
+			"\treturn [v.dot(w), v.cross(w), v.normalized(), s.to_upper(), s.find(\"l\"), a, a.size(), Color(1, 0.5, 0).inverted()]\n");
+}
+
+static bool test_validated_builtin_call_errors() {
+	OS::get_singleton()->print("\n\nTest validated built-in method calls with invalid arguments\n");
+
+	// Both report the error and return null.
+	return _validated_matches_generic(
+			"static func typed_result():\n"
+			"\tvar v := Vector3(1, 2, 3)\n"
+			"\tvar x = \"x\"\n"
+			"\treturn v.dot(x)\n"
+			"static func untyped_result():\n"
+			"\tvar v = Vector3(1, 2, 3)\n"
+			"\tvar x = \"x\"\n"
+			"\treturn v.dot(x)\n");
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_validated_funcs[] = {
+	test_validated_operators,
+	test_validated_getters,
+	test_validated_division_by_zero,
+	test_validated_index_out_of_bounds,
+	test_validated_builtin_calls,
+	test_validated_builtin_call_errors,
+	nullptr
+};
+
+static MainLoop *_test_validated() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_validated_funcs[count]) {
+			break;
+		}
+		bool pass = test_validated_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
 MainLoop *test(TestType p_type) {
+	if (p_type == TEST_VALIDATED) {
+		return _test_validated();
+	}
+
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
 	if (cmdlargs.empty()) {
@@ -0,0 +1,220 @@
+/*************************************************************************/
+/*  test_groups.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_groups.h"
+
+#include "core/os/os.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+#define GROUP_SIZE 10000
+#define CHURN_PERCENT 10
+#define FRAME_COUNT 20
+
+namespace TestGroups {
+
+// Measures SceneTree group operations on a large group: joining and leaving it, calling it in scene order
+// and unordered, and getting its nodes, including frames where part of the group leaves and joins again.
+// The group size can be passed as the last argument.
+static int _get_group_size() {
+	List<String> cmdline = OS::get_singleton()->get_cmdline_args();
+	if (cmdline.size() > 0 && cmdline[cmdline.size() - 1].to_int()) {
+		return cmdline[cmdline.size() - 1].to_int();
+	}
+	return GROUP_SIZE;
+}
+
+static double _msec_since(uint64_t p_begin) {
+	return (OS::get_singleton()->get_ticks_usec() - p_begin) / 1000.0;
+}
+
+// A tree with a container of nodes that all joined the "enemies" group, in scene order.
+struct GroupScene {
+	SceneTree *tree;
+	Vector<Node *> nodes;
+	double join_msec;
+
+	GroupScene() {
+		tree = memnew(SceneTree);
+		tree->init();
+
+		int group_size = _get_group_size();
+		Node *container = memnew(Node);
+		tree->get_root()->add_child(container);
+		for (int i = 0; i < group_size; i++) {
+			Node *node = memnew(Node);
+			container->add_child(node);
+			nodes.push_back(node);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < group_size; i++) {
+			nodes[i]->add_to_group("enemies");
+		}
+		join_msec = _msec_since(begin);
+	}
+
+	~GroupScene() {
+		tree->finish();
+		memdelete(tree);
+	}
+
+	bool in_scene_order() const {
+		List<Node *> list;
+		tree->get_nodes_in_group("enemies", &list);
+		if (list.size() != nodes.size()) {
+			return false;
+		}
+		int index = 0;
+		for (List<Node *>::Element *E = list.front(); E; E = E->next()) {
+			if (E->get() != nodes[index++]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+static double _measure_call_group(SceneTree *p_tree, uint32_t p_flags) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FRAME_COUNT; i++) {
+		p_tree->call_group_flags(SceneTree::GROUP_CALL_REALTIME | p_flags, "enemies", "get_index");
+	}
+	return _msec_since(begin) / FRAME_COUNT;
+}
+
+// Removes and adds back a slice of the group, as happens when enemies die and spawn.
+static double _measure_churn(GroupScene &p_scene, uint32_t p_flags) {
+	const Vector<Node *> &nodes = p_scene.nodes;
+	int churn = nodes.size() * CHURN_PERCENT / 100;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FRAME_COUNT; i++) {
+		for (int j = 0; j < churn; j++) {
+			nodes[(i * churn + j) % nodes.size()]->remove_from_group("enemies");
+		}
+		for (int j = 0; j < churn; j++) {
+			nodes[(i * churn + j) % nodes.size()]->add_to_group("enemies");
+		}
+		p_scene.tree->call_group_flags(SceneTree::GROUP_CALL_REALTIME | p_flags, "enemies", "get_index");
+	}
+	return _msec_since(begin) / FRAME_COUNT;
+}
+
+bool test_call_group() {
+	OS::get_singleton()->print("\n\nTest calling a group of %d nodes\n", _get_group_size());
+
+	GroupScene scene;
+	double ordered_msec = _measure_call_group(scene.tree, SceneTree::GROUP_CALL_DEFAULT);
+	double unordered_msec = _measure_call_group(scene.tree, SceneTree::GROUP_CALL_UNORDERED);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FRAME_COUNT; i++) {
+		List<Node *> list;
+		scene.tree->get_nodes_in_group("enemies", &list);
+	}
+	double get_nodes_msec = _msec_since(begin) / FRAME_COUNT;
+
+	OS::get_singleton()->print("\tadd_to_group (all): %.3f msec\n", scene.join_msec);
+	OS::get_singleton()->print("\tcall_group: %.3f msec\n", ordered_msec);
+	OS::get_singleton()->print("\tcall_group unordered: %.3f msec\n", unordered_msec);
+	OS::get_singleton()->print("\tget_nodes_in_group: %.3f msec\n", get_nodes_msec);
+
+	return scene.in_scene_order();
+}
+
+bool test_churn() {
+	OS::get_singleton()->print("\n\nTest frames where %d%% of the group leaves and joins again\n", CHURN_PERCENT);
+
+	GroupScene scene;
+	double ordered_msec = _measure_churn(scene, SceneTree::GROUP_CALL_DEFAULT);
+	double unordered_msec = _measure_churn(scene, SceneTree::GROUP_CALL_UNORDERED);
+
+	OS::get_singleton()->print("\tcall_group: %.3f msec per frame\n", ordered_msec);
+	OS::get_singleton()->print("\tcall_group unordered: %.3f msec per frame\n", unordered_msec);
+
+	// After any churn, the group must still come back in scene order.
+	return scene.in_scene_order();
+}
+
+bool test_leave() {
+	OS::get_singleton()->print("\n\nTest leaving a group of %d nodes\n", _get_group_size());
+
+	GroupScene scene;
+	int group_size = scene.nodes.size();
+
+	// Leave from the middle, the worst case for a linear removal.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < group_size; i++) {
+		scene.nodes[(i + group_size / 2) % group_size]->remove_from_group("enemies");
+	}
+	OS::get_singleton()->print("\tremove_from_group (all): %.3f msec\n", _msec_since(begin));
+
+	return !scene.tree->has_group("enemies");
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_call_group,
+	test_churn,
+	test_leave,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestGroups
@@ -36,18 +36,32 @@
 
 #include "test_astar.h"
 #include "test_basis.h"
+#include "test_bvh.h"
+#include "test_command_queue_mt.h"
 #include "test_crypto.h"
+#include "test_culling.h"
+#include "test_dictionary.h"
+#include "test_file_access.h"
 #include "test_gdscript.h"
+#include "test_groups.h"
 #include "test_gui.h"
 #include "test_math.h"
+#include "test_memory.h"
+#include "test_message_queue.h"
+#include "test_node_path.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
+#include "test_physics_queries.h"
 #include "test_render.h"
+#include "test_resource_loader.h"
 #include "test_shader_lang.h"
+#include "test_signals.h"
+#include "test_spatial_transforms.h"
 #include "test_string.h"
 #include "test_transform.h"
+#include "test_variant.h"
 #include "test_xml_parser.h"
 
 const char **tests_get_names() {
@@ -59,6 +73,8 @@ const char **tests_get_names() {
 		"physics",
 		"physics_2d",
 		"render",
+		"culling",
+		"groups",
 		"oa_hash_map",
 		"gui",
 		"shaderlang",
@@ -66,9 +82,22 @@ const char **tests_get_names() {
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_validated",
 		"ordered_hash_map",
 		"astar",
 		"xml_parser",
+		"variant",
+		"memory",
+		"node_path",
+		"signals",
+		"dictionary",
+		"bvh",
+		"command_queue_mt",
+		"message_queue",
+		"physics_queries",
+		"spatial_transforms",
+		"resource_loader",
+		"file_access",
 		nullptr
 	};
 
@@ -104,6 +133,30 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestRender::test();
 	}
 
+	if (p_test == "culling") {
+		return TestCulling::test();
+	}
+
+	if (p_test == "groups") {
+		return TestGroups::test();
+	}
+
+	if (p_test == "memory") {
+		return TestMemory::test();
+	}
+
+	if (p_test == "node_path") {
+		return TestNodePath::test();
+	}
+
+	if (p_test == "signals") {
+		return TestSignals::test();
+	}
+
+	if (p_test == "dictionary") {
+		return TestDictionary::test();
+	}
+
 	if (p_test == "oa_hash_map") {
 		return TestOAHashMap::test();
 	}
@@ -138,6 +191,10 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_validated") {
+		return TestGDScript::test(TestGDScript::TEST_VALIDATED);
+	}
+
 	if (p_test == "ordered_hash_map") {
 		return TestOrderedHashMap::test();
 	}
@@ -150,6 +207,38 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestXMLParser::test();
 	}
 
+	if (p_test == "variant") {
+		return TestVariant::test();
+	}
+
+	if (p_test == "bvh") {
+		return TestBVH::test();
+	}
+
+	if (p_test == "command_queue_mt") {
+		return TestCommandQueueMT::test();
+	}
+
+	if (p_test == "message_queue") {
+		return TestMessageQueue::test();
+	}
+
+	if (p_test == "physics_queries") {
+		return TestPhysicsQueries::test();
+	}
+
+	if (p_test == "spatial_transforms") {
+		return TestSpatialTransforms::test();
+	}
+
+	if (p_test == "resource_loader") {
+		return TestResourceLoader::test();
+	}
+
+	if (p_test == "file_access") {
+		return TestFileAccess::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return nullptr;
 }
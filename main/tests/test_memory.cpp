@@ -0,0 +1,375 @@
+/*************************************************************************/
+/*  test_memory.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_memory.h"
+
+#include "core/array.h"
+#include "core/dictionary.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/reference.h"
+
+#include <stdlib.h>
+
+#define SLOT_COUNT 4096
+#define ITERATION_COUNT 2000000
+#define THREAD_COUNT 4
+#define CROSS_THREAD_COUNT 200000
+
+namespace TestMemory {
+
+// Measures allocation churn: a fixed number of live blocks of random small sizes,
+// where each iteration frees one of them and allocates a replacement.
+// Sizes are picked up front, so the same sequence is run through malloc and Memory.
+
+static uint32_t sizes[ITERATION_COUNT];
+
+struct ChurnData {
+	bool use_malloc;
+	uint64_t usec;
+};
+
+static void _churn(bool p_use_malloc) {
+	void *slots[SLOT_COUNT] = {};
+
+	for (int i = 0; i < ITERATION_COUNT; i++) {
+		int slot = i & (SLOT_COUNT - 1);
+		if (p_use_malloc) {
+			free(slots[slot]);
+			slots[slot] = malloc(sizes[i]);
+		} else {
+			if (slots[slot]) {
+				memfree(slots[slot]);
+			}
+			slots[slot] = memalloc(sizes[i]);
+		}
+		*(uint8_t *)slots[slot] = i;
+	}
+
+	for (int i = 0; i < SLOT_COUNT; i++) {
+		if (p_use_malloc) {
+			free(slots[i]);
+		} else {
+			memfree(slots[i]);
+		}
+	}
+}
+
+static void _churn_thread(void *p_data) {
+	ChurnData *data = (ChurnData *)p_data;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	_churn(data->use_malloc);
+	data->usec = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static double _measure_churn_msec(bool p_use_malloc, int p_threads) {
+	ChurnData data[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_threads; i++) {
+		data[i].use_malloc = p_use_malloc;
+		threads[i].start(_churn_thread, &data[i]);
+	}
+	for (int i = 0; i < p_threads; i++) {
+		threads[i].wait_to_finish();
+	}
+	return (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+}
+
+// One thread allocates, another one frees, as when a worker thread produces data for the main thread.
+static void *cross_thread_blocks[CROSS_THREAD_COUNT];
+
+static void _cross_thread_free(void *p_data) {
+	bool use_malloc = *(bool *)p_data;
+	for (int i = 0; i < CROSS_THREAD_COUNT; i++) {
+		if (use_malloc) {
+			free(cross_thread_blocks[i]);
+		} else {
+			memfree(cross_thread_blocks[i]);
+		}
+	}
+}
+
+static double _measure_cross_thread_msec(bool p_use_malloc) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < CROSS_THREAD_COUNT; i++) {
+			cross_thread_blocks[i] = p_use_malloc ? malloc(sizes[i]) : memalloc(sizes[i]);
+		}
+		Thread thread;
+		thread.start(_cross_thread_free, &p_use_malloc);
+		thread.wait_to_finish();
+	}
+	return (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+}
+
+static double _measure_variant_churn_msec() {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ITERATION_COUNT / 20; i++) {
+		Ref<Reference> ref;
+		ref.instance();
+		Dictionary dict;
+		dict["ref"] = ref;
+		dict[i] = i;
+		Array arr;
+		arr.push_back(dict);
+		arr.push_back(ref);
+	}
+	return (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+}
+
+// Correctness of the allocator, whether the small allocator is enabled or not.
+
+static void _fill(uint8_t *p_mem, size_t p_size, uint8_t p_seed) {
+	for (size_t i = 0; i < p_size; i++) {
+		p_mem[i] = p_seed + i * 7;
+	}
+}
+
+static bool _check(const uint8_t *p_mem, size_t p_size, uint8_t p_seed) {
+	for (size_t i = 0; i < p_size; i++) {
+		if (p_mem[i] != (uint8_t)(p_seed + i * 7)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_realloc_across_size_classes() {
+	OS::get_singleton()->print("\n\nTest realloc across size classes\n");
+
+	// Grows through every small class and beyond, then shrinks back, keeping the common bytes each time.
+	static const size_t steps[] = { 1, 15, 16, 17, 48, 100, 500, 1000, 1024, 1025, 4000, 1024, 700, 64, 8 };
+	size_t count = sizeof(steps) / sizeof(steps[0]);
+
+	uint8_t *mem = (uint8_t *)memalloc(steps[0]);
+	_fill(mem, steps[0], 42);
+	for (size_t i = 1; i < count; i++) {
+		mem = (uint8_t *)memrealloc(mem, steps[i]);
+		if (!mem || !_check(mem, MIN(steps[i - 1], steps[i]), 42)) {
+			OS::get_singleton()->print("\tContents lost going from %d to %d bytes.\n", (int)steps[i - 1], (int)steps[i]);
+			return false;
+		}
+		_fill(mem, steps[i], 42);
+	}
+	memfree(mem);
+	return true;
+}
+
+bool test_alignment() {
+	OS::get_singleton()->print("\n\nTest alignment\n");
+
+	void *blocks[2048];
+	bool aligned = true;
+	for (int i = 0; i < 2048; i++) {
+		blocks[i] = memalloc(i + 1);
+		if ((uintptr_t)blocks[i] & (PAD_ALIGN - 1)) {
+			OS::get_singleton()->print("\t%d byte block not aligned to %d bytes.\n", i + 1, PAD_ALIGN);
+			aligned = false;
+		}
+	}
+	for (int i = 0; i < 2048; i++) {
+		memfree(blocks[i]);
+	}
+	return aligned;
+}
+
+#define HANDOFF_COUNT 20000
+
+static uint8_t *handoff_blocks[HANDOFF_COUNT];
+
+static size_t _handoff_size(int p_index) {
+	return 1 + (p_index * 37) % 1100;
+}
+
+static void _handoff_check_and_free(void *p_data) {
+	bool *intact = (bool *)p_data;
+	for (int i = 0; i < HANDOFF_COUNT; i++) {
+		if (!_check(handoff_blocks[i], _handoff_size(i), i)) {
+			*intact = false;
+		}
+		memfree(handoff_blocks[i]);
+	}
+}
+
+bool test_cross_thread_free() {
+	OS::get_singleton()->print("\n\nTest cross-thread free\n");
+
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < HANDOFF_COUNT; i++) {
+			handoff_blocks[i] = (uint8_t *)memalloc(_handoff_size(i));
+			_fill(handoff_blocks[i], _handoff_size(i), i);
+		}
+
+		bool intact = true;
+		Thread thread;
+		thread.start(_handoff_check_and_free, &intact);
+		thread.wait_to_finish();
+		if (!intact) {
+			OS::get_singleton()->print("\tBlock contents changed before the other thread freed them.\n");
+			return false;
+		}
+	}
+
+	// The blocks freed by the other thread must be handed out again, intact, rather than reserving more memory.
+	uint64_t reserved = Memory::get_small_alloc_stats().bytes_reserved;
+	for (int i = 0; i < HANDOFF_COUNT; i++) {
+		handoff_blocks[i] = (uint8_t *)memalloc(_handoff_size(i));
+		_fill(handoff_blocks[i], _handoff_size(i), i + 1);
+	}
+	bool intact = true;
+	for (int i = 0; i < HANDOFF_COUNT; i++) {
+		intact = intact && _check(handoff_blocks[i], _handoff_size(i), i + 1);
+		memfree(handoff_blocks[i]);
+	}
+	uint64_t grown = Memory::get_small_alloc_stats().bytes_reserved - reserved;
+	if (grown) {
+		OS::get_singleton()->print("\tReserved %s more bytes instead of reusing freed ones.\n", itos(grown).utf8().get_data());
+	}
+	return intact && grown == 0;
+}
+
+static void _churn_and_exit(void *p_data) {
+	bool release_early = *(bool *)p_data;
+	void *blocks[4096];
+	for (int i = 0; i < 4096; i++) {
+		blocks[i] = memalloc(64);
+	}
+	for (int i = 0; i < 4096; i++) {
+		memfree(blocks[i]);
+	}
+	if (release_early) {
+		// Allocating after the release must not leave a heap behind.
+		Memory::release_thread_cache();
+		for (int i = 0; i < 4096; i++) {
+			blocks[i] = memalloc(64);
+		}
+		for (int i = 0; i < 4096; i++) {
+			memfree(blocks[i]);
+		}
+	}
+}
+
+bool test_thread_exit_releases_cache() {
+	OS::get_singleton()->print("\n\nTest thread exit releases the thread cache\n");
+
+	// Each thread fills a few spans. If they weren't released on exit, every thread would reserve new ones.
+	for (int pass = 0; pass < 2; pass++) {
+		bool release_early = pass == 1;
+		uint64_t reserved = 0;
+		for (int i = 0; i < 20; i++) {
+			if (i == 2) {
+				reserved = Memory::get_small_alloc_stats().bytes_reserved;
+			}
+			Thread thread;
+			thread.start(_churn_and_exit, &release_early);
+			thread.wait_to_finish();
+		}
+		uint64_t grown = Memory::get_small_alloc_stats().bytes_reserved - reserved;
+		if (grown) {
+			OS::get_singleton()->print("\tReserved %s more bytes for threads that exited.\n", itos(grown).utf8().get_data());
+			return false;
+		}
+	}
+	return true;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_realloc_across_size_classes,
+	test_alignment,
+	test_cross_thread_free,
+	test_thread_exit_releases_cache,
+	nullptr
+
+};
+
+static void _print_stats() {
+	Memory::SmallAllocStats stats = Memory::get_small_alloc_stats();
+	OS::get_singleton()->print("Small allocator: %s KiB in use, %s KiB reserved, %s cross-thread frees.\n",
+			itos(stats.bytes_in_use / 1024).utf8().get_data(),
+			itos(stats.bytes_reserved / 1024).utf8().get_data(),
+			itos(stats.cross_thread_frees).utf8().get_data());
+	for (int i = 0; i < Memory::SMALL_ALLOC_CLASS_COUNT; i++) {
+		OS::get_singleton()->print("\t%4d bytes: %s allocations\n", stats.class_sizes[i], itos(stats.class_allocations[i]).utf8().get_data());
+	}
+}
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n\n", passed, count);
+
+	RandomPCG rng(1234);
+	for (int i = 0; i < ITERATION_COUNT; i++) {
+		// Mostly tiny blocks, like the ones of references, dictionaries and strings.
+		sizes[i] = rng.rand() & 1 ? 8 + rng.rand() % 120 : 8 + rng.rand() % 1000;
+	}
+
+	if (!Memory::is_small_allocator_enabled()) {
+		OS::get_singleton()->print("Small allocator disabled, build with small_allocator=yes to enable it.\n");
+	}
+
+	for (int threads = 1; threads <= THREAD_COUNT; threads *= 2) {
+		OS::get_singleton()->print("Churn, %d thread(s): malloc %.1f msec, Memory %.1f msec\n", threads, _measure_churn_msec(true, threads), _measure_churn_msec(false, threads));
+	}
+	OS::get_singleton()->print("Cross-thread frees: malloc %.1f msec, Memory %.1f msec\n", _measure_cross_thread_msec(true), _measure_cross_thread_msec(false));
+	OS::get_singleton()->print("Reference, Dictionary and Array churn: %.1f msec\n", _measure_variant_churn_msec());
+
+	if (Memory::is_small_allocator_enabled()) {
+		_print_stats();
+	}
+
+	return nullptr;
+}
+} // namespace TestMemory
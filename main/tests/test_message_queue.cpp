@@ -0,0 +1,252 @@
+/*************************************************************************/
+/*  test_message_queue.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_message_queue.h"
+
+#include "core/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/project_settings.h"
+
+#define PRODUCER_COUNT 4
+#define MESSAGES_PER_PRODUCER 50000
+
+namespace TestMessageQueue {
+
+// Records the values set on it, which encode who pushed them.
+class Receiver : public Object {
+	GDCLASS(Receiver, Object);
+
+public:
+	Vector<int64_t> received;
+	int push_again = 0;
+	bool fan_out = false;
+	bool push_failed = false;
+	uint64_t memory_at_failure = 0;
+
+	bool _set(const StringName &p_name, const Variant &p_value) {
+		received.push_back(p_value);
+
+		if (push_again > 0) {
+			push_again--;
+			MessageQueue::get_singleton()->push_set(get_instance_id(), "value", -1);
+		}
+
+		if (fan_out && !push_failed) {
+			// Every call defers two more, so the queue only stops growing at its limit.
+			for (int i = 0; i < 2; i++) {
+				if (MessageQueue::get_singleton()->push_set(get_instance_id(), "value", 0) != OK) {
+					push_failed = true;
+					memory_at_failure = MessageQueue::get_singleton()->get_stats().memory_used;
+					break;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+static bool _check_order(const Vector<int64_t> &p_received, int p_producers, int p_count) {
+	int64_t last[PRODUCER_COUNT + 1];
+	for (int i = 0; i <= p_producers; i++) {
+		last[i] = -1;
+	}
+
+	for (int i = 0; i < p_received.size(); i++) {
+		int producer = p_received[i] / 1000000;
+		int64_t sequence = p_received[i] % 1000000;
+		if (producer > p_producers || sequence != last[producer] + 1) {
+			OS::get_singleton()->print("\tMessage %d out of order\n", i);
+			return false;
+		}
+		last[producer] = sequence;
+	}
+
+	for (int i = 0; i < p_producers; i++) {
+		if (last[i + 1] != p_count - 1) {
+			return false;
+		}
+	}
+	return p_received.size() == p_producers * p_count;
+}
+
+bool test_past_old_limit() {
+	OS::get_singleton()->print("\n\nTest queueing past the old size limit\n");
+
+	MessageQueue *queue = MessageQueue::get_singleton();
+	queue->flush();
+
+	// The queue used to be a fixed buffer of this size, which dropped calls when full.
+	uint64_t old_limit = uint64_t(GLOBAL_GET("memory/limits/message_queue/max_size_kb")) * 1024;
+	Receiver *receiver = memnew(Receiver);
+	int count = 0;
+	bool pushed = true;
+	while (queue->get_stats().usage <= old_limit * 2) {
+		for (int i = 0; i < 1000; i++) {
+			pushed = pushed && queue->push_set(receiver->get_instance_id(), "value", 1000000 + count) == OK;
+			count++;
+		}
+	}
+	OS::get_singleton()->print("\t%d messages, %d KiB\n", count, int(queue->get_stats().usage / 1024));
+
+	queue->flush();
+	MessageQueue::Stats stats = queue->get_stats();
+	OS::get_singleton()->print("\t%d KiB kept after flushing\n", int(stats.memory_used / 1024));
+
+	bool ok = pushed && _check_order(receiver->received, 1, count) && stats.pending == 0;
+	// Only the pages kept for reuse remain, plus the one being written.
+	ok = ok && stats.memory_used <= old_limit + old_limit / 16 + 2 * 16 * 1024;
+	memdelete(receiver);
+	return ok;
+}
+
+struct Producer {
+	Receiver *receiver;
+	int id;
+};
+
+static void _produce(void *p_data) {
+	Producer *producer = (Producer *)p_data;
+	for (int i = 0; i < MESSAGES_PER_PRODUCER; i++) {
+		MessageQueue::get_singleton()->push_set(producer->receiver->get_instance_id(), "value", producer->id * 1000000 + i);
+	}
+}
+
+bool test_thread_order() {
+	OS::get_singleton()->print("\n\nTest %d threads keep their order, then free their pages\n", PRODUCER_COUNT);
+
+	MessageQueue *queue = MessageQueue::get_singleton();
+	queue->flush();
+	uint64_t memory_before = queue->get_stats().memory_used;
+
+	Receiver *receiver = memnew(Receiver);
+	Producer producers[PRODUCER_COUNT];
+	Thread threads[PRODUCER_COUNT];
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		producers[i].receiver = receiver;
+		producers[i].id = i + 1;
+		threads[i].start(_produce, &producers[i]);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	uint64_t memory_pending = queue->get_stats().memory_used;
+	queue->flush();
+	MessageQueue::Stats stats = queue->get_stats();
+	OS::get_singleton()->print("\t%d KiB before flushing, %d KiB after\n", int(memory_pending / 1024), int(stats.memory_used / 1024));
+
+	// The threads have exited, so flushing must free their pages instead of keeping them.
+	bool ok = _check_order(receiver->received, PRODUCER_COUNT, MESSAGES_PER_PRODUCER) && stats.memory_used == memory_before;
+	memdelete(receiver);
+	return ok;
+}
+
+bool test_push_while_flushing() {
+	OS::get_singleton()->print("\n\nTest messages pushed while flushing run in the same flush\n");
+
+	MessageQueue *queue = MessageQueue::get_singleton();
+	queue->flush();
+
+	Receiver *receiver = memnew(Receiver);
+	receiver->push_again = 3;
+	queue->push_set(receiver->get_instance_id(), "value", 7);
+	queue->push_set(receiver->get_instance_id(), "value", 8);
+	queue->flush();
+
+	// Each message runs after the ones already queued when it was pushed.
+	bool ok = receiver->received.size() == 5 && receiver->received[0] == 7 && receiver->received[1] == 8;
+	for (int i = 2; i < receiver->received.size(); i++) {
+		ok = ok && receiver->received[i] == -1;
+	}
+	ok = ok && queue->get_stats().pending == 0;
+	memdelete(receiver);
+	return ok;
+}
+
+bool test_deferring_itself() {
+	OS::get_singleton()->print("\n\nTest a call deferring more calls stops at the limit\n");
+
+	MessageQueue *queue = MessageQueue::get_singleton();
+	queue->flush();
+
+	uint64_t limit = uint64_t(GLOBAL_GET("memory/limits/message_queue/max_pending_kb")) * 1024;
+	Receiver *receiver = memnew(Receiver);
+	receiver->fan_out = true;
+	queue->push_set(receiver->get_instance_id(), "value", 0);
+	queue->flush();
+	OS::get_singleton()->print("\t%d calls, %d KiB used when pushing failed\n", receiver->received.size(), int(receiver->memory_at_failure / 1024));
+
+	// The pages kept for reuse don't count against the limit.
+	uint64_t retained = uint64_t(GLOBAL_GET("memory/limits/message_queue/max_size_kb")) * 1024;
+	bool ok = receiver->push_failed && receiver->memory_at_failure <= limit + retained + 16 * 1024 && queue->get_stats().pending == 0;
+	memdelete(receiver);
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_past_old_limit,
+	test_thread_order,
+	test_push_while_flushing,
+	test_deferring_itself,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestMessageQueue
@@ -0,0 +1,281 @@
+/*************************************************************************/
+/*  test_node_path.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_node_path.h"
+
+#include "core/os/os.h"
+#include "scene/main/node.h"
+
+#define CHILD_COUNT 10000
+#define DEPTH 64
+#define LOOKUP_COUNT 100000
+
+namespace TestNodePath {
+
+// Measures how long Node::get_node() takes to resolve paths in a node with many children and in a deep branch,
+// with and without the child name index, for paths looked up once (uncached) and over and over (cached),
+// and while unrelated nodes are freed. The child count can be passed as the last argument.
+static int _get_child_count() {
+	List<String> cmdline = OS::get_singleton()->get_cmdline_args();
+	if (cmdline.size() > 0 && cmdline[cmdline.size() - 1].to_int()) {
+		return cmdline[cmdline.size() - 1].to_int();
+	}
+	return CHILD_COUNT;
+}
+
+static bool _measure_wide(int p_child_count, bool p_index) {
+	bool state = true;
+
+	Node *parent = memnew(Node);
+	parent->set_child_name_index_enabled(p_index);
+
+	Vector<NodePath> paths;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_child_count; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		parent->add_child(child);
+		paths.push_back(NodePath(child->get_name()));
+	}
+	uint64_t add_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Every path once; there are far more than the cache holds.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_child_count; i++) {
+		state = state && parent->get_node_or_null(paths[i]) == parent->get_child(i);
+	}
+	uint64_t uncached_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// The same path over and over, like $Path in _process().
+	const NodePath &last = paths[p_child_count - 1];
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOOKUP_COUNT; i++) {
+		parent->get_node_or_null(last);
+	}
+	uint64_t cached_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Cached lookups must follow renames, removals and frees.
+	Node *child = parent->get_child(p_child_count - 1);
+	child->set_name("Renamed");
+	state = state && parent->get_node_or_null(last) == nullptr;
+	state = state && parent->get_node_or_null(NodePath("Renamed")) == child;
+	child->set_name(last.get_name(0));
+	state = state && parent->get_node_or_null(last) == child;
+	parent->remove_child(child);
+	state = state && parent->get_node_or_null(last) == nullptr;
+	memdelete(child);
+	state = state && parent->get_node_or_null(last) == nullptr;
+
+	memdelete(parent);
+
+	OS::get_singleton()->print("\tadd_child: %.2f msec\n", add_usec / 1000.0);
+	OS::get_singleton()->print("\tuncached get_node: %.3f usec\n", uncached_usec / double(p_child_count));
+	OS::get_singleton()->print("\tcached get_node: %.3f usec\n", cached_usec / double(LOOKUP_COUNT));
+
+	return state;
+}
+
+bool test_wide() {
+	OS::get_singleton()->print("\n\nTest get_node among %d children\n", _get_child_count());
+	return _measure_wide(_get_child_count(), false);
+}
+
+bool test_wide_index() {
+	OS::get_singleton()->print("\n\nTest get_node among %d children with the child name index\n", _get_child_count());
+	return _measure_wide(_get_child_count(), true);
+}
+
+bool test_deep() {
+	OS::get_singleton()->print("\n\nTest get_node in a branch %d levels deep\n", DEPTH);
+
+	int child_count = _get_child_count();
+	bool state = true;
+
+	// A chain of nodes, each with many siblings as well.
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	Node *parent = root;
+	String path;
+	for (int i = 0; i < DEPTH; i++) {
+		for (int j = 0; j < child_count / DEPTH; j++) {
+			Node *sibling = memnew(Node);
+			sibling->set_name("Sibling" + itos(j));
+			parent->add_child(sibling);
+		}
+		Node *child = memnew(Node);
+		child->set_name("Level" + itos(i));
+		parent->add_child(child);
+		if (i > 0) {
+			path += "/";
+		}
+		path += child->get_name();
+		parent = child;
+	}
+	Node *leaf = parent;
+	NodePath down = path;
+
+	String up_path = "..";
+	for (int i = 1; i < DEPTH; i++) {
+		up_path += "/..";
+	}
+	NodePath up = up_path + "/" + path;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOOKUP_COUNT; i++) {
+		root->get_node_or_null(down);
+	}
+	uint64_t down_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOOKUP_COUNT; i++) {
+		leaf->get_node_or_null(up);
+	}
+	uint64_t up_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	state = state && root->get_node_or_null(down) == leaf;
+	state = state && leaf->get_node_or_null(up) == leaf;
+
+	// Moving a node in the middle of the branch must invalidate both.
+	Node *middle = root->get_node_or_null(NodePath("Level0/Level1"));
+	Node *middle_parent = middle->get_parent();
+	middle_parent->remove_child(middle);
+	state = state && root->get_node_or_null(down) == nullptr;
+	state = state && leaf->get_node_or_null(up) == nullptr;
+	middle_parent->add_child(middle);
+	state = state && root->get_node_or_null(down) == leaf;
+
+	memdelete(root);
+
+	OS::get_singleton()->print("\tcached get_node down: %.3f usec\n", down_usec / double(LOOKUP_COUNT));
+	OS::get_singleton()->print("\tcached get_node up and down: %.3f usec\n", up_usec / double(LOOKUP_COUNT));
+
+	return state;
+}
+
+bool test_churn() {
+	OS::get_singleton()->print("\n\nTest cached get_node while other nodes are freed\n");
+
+	bool state = true;
+
+	// A player whose weapon is looked up every frame, next to bullets that are spawned and freed every frame.
+	Node *root = memnew(Node);
+	Node *player = memnew(Node);
+	player->set_name("Player");
+	root->add_child(player);
+	Node *weapon = memnew(Node);
+	weapon->set_name("Weapon");
+	player->add_child(weapon);
+	Node *muzzle = memnew(Node);
+	muzzle->set_name("Muzzle");
+	weapon->add_child(muzzle);
+	Node *bullets = memnew(Node);
+	bullets->set_name("Bullets");
+	root->add_child(bullets);
+	for (int i = 0; i < 100; i++) {
+		bullets->add_child(memnew(Node));
+	}
+
+	// Freeing a bullet only invalidates lookups that start from one of its ancestors.
+	NodePath from_player("Weapon/Muzzle");
+	NodePath from_root("Player/Weapon/Muzzle");
+	uint64_t player_usec = 0;
+	uint64_t root_usec = 0;
+	for (int i = 0; i < LOOKUP_COUNT / 10; i++) {
+		memdelete(bullets->get_child(0));
+		bullets->add_child(memnew(Node));
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < 10; j++) {
+			state = state && player->get_node_or_null(from_player) == muzzle;
+		}
+		player_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < 10; j++) {
+			state = state && root->get_node_or_null(from_root) == muzzle;
+		}
+		root_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	// Freeing the cached node itself must not leave it reachable, even if another node takes its address and name.
+	memdelete(muzzle);
+	state = state && player->get_node_or_null(from_player) == nullptr && root->get_node_or_null(from_root) == nullptr;
+	muzzle = memnew(Node);
+	muzzle->set_name("Muzzle");
+	weapon->add_child(muzzle);
+	state = state && player->get_node_or_null(from_player) == muzzle && root->get_node_or_null(from_root) == muzzle;
+
+	memdelete(root);
+
+	OS::get_singleton()->print("\tget_node from the player: %.3f usec\n", player_usec / double(LOOKUP_COUNT));
+	OS::get_singleton()->print("\tget_node from the root: %.3f usec\n", root_usec / double(LOOKUP_COUNT));
+
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_wide,
+	test_wide_index,
+	test_deep,
+	test_churn,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestNodePath
@@ -0,0 +1,301 @@
+/*************************************************************************/
+/*  test_physics_queries.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_physics_queries.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "servers/physics/physics_server_sw.h"
+#include "servers/physics/physics_server_wrap_mt.h"
+#include "servers/physics_2d_server.h"
+#include "servers/physics_server.h"
+
+#define RAY_COUNT 2000
+
+namespace TestPhysicsQueries {
+
+static bool _compare_3d(const Vector3 *p_from, const Vector3 *p_to, PhysicsDirectSpaceState *p_state, const Set<RID> &p_exclude) {
+	Vector<PhysicsDirectSpaceState::RayResult> results;
+	Vector<bool> hits;
+	results.resize(RAY_COUNT);
+	hits.resize(RAY_COUNT);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int hit_count = p_state->intersect_rays(p_from, p_to, RAY_COUNT, results.ptrw(), hits.ptrw(), p_exclude);
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int expected_hits = 0;
+	bool ok = true;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < RAY_COUNT; i++) {
+		PhysicsDirectSpaceState::RayResult result;
+		bool hit = p_state->intersect_ray(p_from[i], p_to[i], result, p_exclude);
+		if (hit) {
+			expected_hits++;
+		}
+
+		if (hit != hits[i]) {
+			OS::get_singleton()->print("\tRay %d: hit %d, expected %d\n", i, hits[i], hit);
+			ok = false;
+		} else if (hit && (result.rid != results[i].rid || result.shape != results[i].shape || !result.position.is_equal_approx(results[i].position) || !result.normal.is_equal_approx(results[i].normal))) {
+			OS::get_singleton()->print("\tRay %d: hit a different shape\n", i);
+			ok = false;
+		}
+	}
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\t%d of %d rays hit, batch %.2f msec, one by one %.2f msec\n", hit_count, RAY_COUNT, batch_usec / 1000.0, single_usec / 1000.0);
+	return ok && hit_count == expected_hits && expected_hits > 0;
+}
+
+bool test_ray_batch_3d() {
+	OS::get_singleton()->print("\n\nTest 3D ray batches match single rays\n");
+
+	PhysicsServer *ps = PhysicsServer::get_singleton();
+	RID space = ps->space_create();
+
+	RID box = ps->shape_create(PhysicsServer::SHAPE_BOX);
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID sphere = ps->shape_create(PhysicsServer::SHAPE_SPHERE);
+	ps->shape_set_data(sphere, 0.7);
+
+	Math::seed(1);
+	Vector<RID> bodies;
+	for (int i = 0; i < 400; i++) {
+		RID body = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, (i & 1) ? box : sphere);
+		Basis rotation(Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized(), Math::random(0.0, Math_PI));
+		Vector3 origin((i % 10) * 3.0, ((i / 10) % 10) * 3.0, (i / 100) * 3.0);
+		ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, Transform(rotation, origin));
+		bodies.push_back(body);
+	}
+
+	PhysicsDirectSpaceState *state = ps->space_get_direct_state(space);
+	Set<RID> exclude;
+	exclude.insert(bodies[55]);
+
+	// Rays close together share one broadphase query, rays across the whole space are culled one by one.
+	Vector<Vector3> from;
+	Vector<Vector3> to;
+	from.resize(RAY_COUNT);
+	to.resize(RAY_COUNT);
+	for (int i = 0; i < RAY_COUNT; i++) {
+		from.write[i] = Vector3(13.5, 13.5, -5.0);
+		to.write[i] = Vector3(Math::random(9.0, 18.0), Math::random(9.0, 18.0), 15.0);
+	}
+	bool ok = _compare_3d(from.ptr(), to.ptr(), state, exclude);
+
+	for (int i = 0; i < RAY_COUNT; i++) {
+		from.write[i] = Vector3(Math::random(-2.0, 30.0), Math::random(-2.0, 30.0), -5.0);
+		to.write[i] = Vector3(Math::random(-2.0, 30.0), Math::random(-2.0, 30.0), 15.0);
+	}
+	ok = _compare_3d(from.ptr(), to.ptr(), state, exclude) && ok;
+
+	for (int i = 0; i < bodies.size(); i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(box);
+	ps->free(sphere);
+	ps->free(space);
+	return ok;
+}
+
+static bool _compare_2d(const Vector2 *p_from, const Vector2 *p_to, Physics2DDirectSpaceState *p_state, const Set<RID> &p_exclude) {
+	Vector<Physics2DDirectSpaceState::RayResult> results;
+	Vector<bool> hits;
+	results.resize(RAY_COUNT);
+	hits.resize(RAY_COUNT);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int hit_count = p_state->intersect_rays(p_from, p_to, RAY_COUNT, results.ptrw(), hits.ptrw(), p_exclude);
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int expected_hits = 0;
+	bool ok = true;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < RAY_COUNT; i++) {
+		Physics2DDirectSpaceState::RayResult result;
+		bool hit = p_state->intersect_ray(p_from[i], p_to[i], result, p_exclude);
+		if (hit) {
+			expected_hits++;
+		}
+
+		if (hit != hits[i]) {
+			OS::get_singleton()->print("\tRay %d: hit %d, expected %d\n", i, hits[i], hit);
+			ok = false;
+		} else if (hit && (result.rid != results[i].rid || result.shape != results[i].shape || !result.position.is_equal_approx(results[i].position) || !result.normal.is_equal_approx(results[i].normal))) {
+			OS::get_singleton()->print("\tRay %d: hit a different shape\n", i);
+			ok = false;
+		}
+	}
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\t%d of %d rays hit, batch %.2f msec, one by one %.2f msec\n", hit_count, RAY_COUNT, batch_usec / 1000.0, single_usec / 1000.0);
+	return ok && hit_count == expected_hits && expected_hits > 0;
+}
+
+bool test_ray_batch_2d() {
+	OS::get_singleton()->print("\n\nTest 2D ray batches match single rays\n");
+
+	Physics2DServer *ps = Physics2DServer::get_singleton();
+	RID space = ps->space_create();
+
+	RID rectangle = ps->rectangle_shape_create();
+	ps->shape_set_data(rectangle, Vector2(10, 10));
+	RID circle = ps->circle_shape_create();
+	ps->shape_set_data(circle, 14.0);
+
+	Math::seed(2);
+	Vector<RID> bodies;
+	for (int i = 0; i < 400; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, Physics2DServer::BODY_MODE_STATIC);
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, (i & 1) ? rectangle : circle);
+		Transform2D transform(Math::random(0.0, Math_PI), Vector2((i % 20) * 50.0, (i / 20) * 50.0));
+		ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, transform);
+		bodies.push_back(body);
+	}
+
+	Physics2DDirectSpaceState *state = ps->space_get_direct_state(space);
+	Set<RID> exclude;
+	exclude.insert(bodies[210]);
+
+	Vector<Vector2> from;
+	Vector<Vector2> to;
+	from.resize(RAY_COUNT);
+	to.resize(RAY_COUNT);
+	for (int i = 0; i < RAY_COUNT; i++) {
+		from.write[i] = Vector2(475, 475);
+		to.write[i] = from[i] + Vector2(100, 0).rotated(Math::random(0.0, Math_PI * 2.0));
+	}
+	bool ok = _compare_2d(from.ptr(), to.ptr(), state, exclude);
+
+	for (int i = 0; i < RAY_COUNT; i++) {
+		from.write[i] = Vector2(Math::random(-50.0, 1000.0), Math::random(-50.0, 1000.0));
+		to.write[i] = Vector2(Math::random(-50.0, 1000.0), Math::random(-50.0, 1000.0));
+	}
+	ok = _compare_2d(from.ptr(), to.ptr(), state, exclude) && ok;
+
+	for (int i = 0; i < bodies.size(); i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(rectangle);
+	ps->free(circle);
+	ps->free(space);
+	return ok;
+}
+
+bool test_wrap_mt_direct_state() {
+	OS::get_singleton()->print("\n\nTest the 3D physics thread refuses direct state while it steps\n");
+
+	// The temporary servers take over the singletons. The one the engine's server relies on internally is put back,
+	// PhysicsServer's is left cleared, so this runs last.
+	PhysicsServerSW *engine_server = PhysicsServerSW::singleton;
+	PhysicsServer *ps = memnew(PhysicsServerWrapMT(memnew(PhysicsServerSW), true));
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID sphere = ps->shape_create(PhysicsServer::SHAPE_SPHERE);
+	ps->shape_set_data(sphere, 0.5);
+	Vector<RID> bodies;
+	for (int i = 0; i < 200; i++) {
+		RID body = ps->body_create(PhysicsServer::BODY_MODE_RIGID);
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, sphere);
+		ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3((i % 10) * 0.8, (i / 10) * 0.8, 0.0)));
+		bodies.push_back(body);
+	}
+
+	bool ok = true;
+	for (int i = 0; i < 10; i++) {
+		ps->flush_queries();
+		ok = ok && ps->space_get_direct_state(space) != nullptr;
+		ok = ok && ps->body_get_direct_state(bodies[0]) != nullptr;
+
+		// The step is queued on the physics thread, which may still be running it.
+		ps->step(1.0 / 60.0);
+		ok = ok && ps->space_get_direct_state(space) == nullptr;
+		ok = ok && ps->body_get_direct_state(bodies[0]) == nullptr;
+	}
+	ps->flush_queries();
+	ok = ok && ps->space_get_direct_state(space) != nullptr;
+
+	for (int i = 0; i < bodies.size(); i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(sphere);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+	PhysicsServerSW::singleton = engine_server;
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_ray_batch_3d,
+	test_ray_batch_2d,
+	test_wrap_mt_direct_state,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestPhysicsQueries
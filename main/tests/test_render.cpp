@@ -32,6 +32,7 @@
 
 #include "core/math/convex_hull.h"
 #include "core/math/math_funcs.h"
+#include "core/os/dir_access.h"
 #include "core/os/keyboard.h"
 #include "core/os/main_loop.h"
 #include "core/os/os.h"
@@ -39,6 +40,7 @@
 #include "servers/visual_server.h"
 
 #define OBJECT_COUNT 50
+#define SHADER_COUNT 32
 
 namespace TestRender {
 
@@ -61,6 +63,14 @@ class TestMainLoop : public MainLoop {
 	float ofs;
 	bool quit;
 
+	// Measures how long the first frame takes when it has to build SHADER_COUNT new shaders.
+	// Pass "shader_cache_cold" to empty the GLES3 shader cache first and compare with a warm run.
+	// With a software GL, e.g. LIBGL_ALWAYS_SOFTWARE=1 MESA_SHADER_CACHE_DISABLE=true, so Mesa's own cache doesn't hide the difference.
+	uint64_t first_frame_start;
+	int frames;
+	List<RID> shaders;
+	List<RID> materials;
+
 protected:
 public:
 	virtual void input_event(const Ref<InputEvent> &p_event) {
@@ -134,6 +144,13 @@ public:
 		*/
 
 		List<String> cmdline = OS::get_singleton()->get_cmdline_args();
+		if (cmdline.find("shader_cache_cold")) {
+			DirAccessRef da = DirAccess::open(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"));
+			if (da) {
+				da->erase_contents_recursive();
+			}
+		}
+
 		int object_count = OBJECT_COUNT;
 		if (cmdline.size() > 0 && cmdline[cmdline.size() - 1].to_int()) {
 			object_count = cmdline[cmdline.size() - 1].to_int();
@@ -151,6 +168,17 @@ public:
 
 			ii.rot_axis = Vector3(Math::random(-1, 1), Math::random(-1, 1), Math::random(-1, 1)).normalized();
 
+			if (i < SHADER_COUNT) {
+				// Each shader differs in a constant, so each needs its own program.
+				RID shader = vs->shader_create();
+				vs->shader_set_code(shader, "shader_type spatial; void fragment() { ALBEDO = vec3(" + rtos((i + 1) / float(SHADER_COUNT)) + ", 0.5, 0.5); }");
+				RID material = vs->material_create();
+				vs->material_set_shader(material, shader);
+				vs->instance_geometry_set_material_override(ii.instance, material);
+				shaders.push_back(shader);
+				materials.push_back(material);
+			}
+
 			instances.push_back(ii);
 		}
 
@@ -198,6 +226,8 @@ public:
 
 		ofs = 0;
 		quit = false;
+		frames = 0;
+		first_frame_start = OS::get_singleton()->get_ticks_usec();
 	}
 	virtual bool iteration(float p_time) {
 		VisualServer *vs = VisualServer::get_singleton();
@@ -225,10 +255,23 @@ public:
 	}
 
 	virtual bool idle(float p_time) {
+		// The first frame has been drawn once the second one starts.
+		if (frames == 1) {
+			print_line("First frame with " + itos(SHADER_COUNT) + " new shaders: " + rtos((OS::get_singleton()->get_ticks_usec() - first_frame_start) / 1000.0) + " msec");
+		}
+		frames++;
+
 		return quit;
 	}
 
 	virtual void finish() {
+		VisualServer *vs = VisualServer::get_singleton();
+		for (List<RID>::Element *E = materials.front(); E; E = E->next()) {
+			vs->free(E->get());
+		}
+		for (List<RID>::Element *E = shaders.front(); E; E = E->next()) {
+			vs->free(E->get());
+		}
 	}
 };
 
@@ -0,0 +1,205 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_loader.h"
+
+#include "core/bind/core_bind.h"
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+
+namespace TestResourceLoader {
+
+// Loads a new Resource for any .testres path and counts how often it was asked to. The cycle_a and cycle_b
+// resources depend on each other, through a threaded request in one direction and a plain load in the other.
+class ResourceFormatLoaderTest : public ResourceFormatLoader {
+	GDCLASS(ResourceFormatLoaderTest, ResourceFormatLoader);
+
+public:
+	SafeNumeric<uint32_t> load_count;
+	SafeNumeric<uint32_t> cyclic_errors;
+
+	virtual RES load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr) {
+		load_count.increment();
+
+		String name = p_path.get_file().get_basename();
+		Error err = OK;
+		if (name == "cycle_a") {
+			ResourceLoader::load_threaded_request("res://cycle_b.testres");
+			ResourceLoader::load_threaded_get("res://cycle_b.testres", &err);
+		} else if (name == "cycle_b") {
+			ResourceLoader::load("res://cycle_a.testres", "", false, &err);
+		}
+		if (err == ERR_CYCLIC_LINK) {
+			cyclic_errors.increment();
+		}
+
+		if (r_error) {
+			*r_error = OK;
+		}
+		Ref<Resource> resource;
+		resource.instance();
+		return resource;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const {
+		p_extensions->push_back("testres");
+	}
+
+	virtual bool handles_type(const String &p_type) const {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const {
+		return p_path.get_extension() == "testres" ? "Resource" : "";
+	}
+};
+
+static Ref<ResourceFormatLoaderTest> test_loader;
+
+bool test_shared_request() {
+	OS::get_singleton()->print("\n\nTest two threaded requests for the same path\n");
+
+	const String path = "res://shared.testres";
+	uint32_t loads = test_loader->load_count.get();
+
+	// Both requests share one load, whether it has finished by the second one or not.
+	bool state = ResourceLoader::load_threaded_request(path) == OK && ResourceLoader::load_threaded_request(path) == OK;
+	Error err = FAILED;
+	RES first = ResourceLoader::load_threaded_get(path, &err);
+	state = state && first.is_valid() && err == OK;
+	RES second = ResourceLoader::load_threaded_get(path, &err);
+	state = state && second == first && err == OK;
+	state = state && test_loader->load_count.get() == loads + 1;
+
+	// Each get consumed one request, so the task is released and a third get has nothing to retrieve.
+	state = state && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	RES third = ResourceLoader::load_threaded_get(path, &err);
+	state = state && third.is_null() && err == ERR_INVALID_PARAMETER;
+
+	return state;
+}
+
+bool test_progress() {
+	OS::get_singleton()->print("\n\nTest the progress of a threaded request\n");
+
+	const String path = "res://progress.testres";
+	bool state = ResourceLoader::load_threaded_request(path) == OK;
+
+	float progress = -1;
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(path, &progress);
+	uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS && OS::get_singleton()->get_ticks_msec() - begin < 10000) {
+		state = state && progress >= 0 && progress <= 1;
+		OS::get_singleton()->delay_usec(1000);
+		status = ResourceLoader::load_threaded_get_status(path, &progress);
+	}
+	state = state && status == ResourceLoader::THREAD_LOAD_LOADED && progress == 1.0;
+
+	// The bound method fills an array it is passed, and leaves its default argument alone otherwise.
+	Array progress_array;
+	state = state && _ResourceLoader::get_singleton()->call("load_threaded_get_status", path, progress_array).operator int() == ResourceLoader::THREAD_LOAD_LOADED;
+	state = state && progress_array.size() == 1 && float(progress_array[0]) == 1.0;
+	_ResourceLoader::get_singleton()->call("load_threaded_get_status", path);
+	MethodBind *method = ClassDB::get_method("_ResourceLoader", "load_threaded_get_status");
+	state = state && method && method->get_default_argument(1).get_type() == Variant::NIL;
+
+	RES resource = ResourceLoader::load_threaded_get(path);
+	state = state && resource.is_valid();
+	state = state && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+	return state;
+}
+
+bool test_cyclic_dependency() {
+	OS::get_singleton()->print("\n\nTest threaded loads that depend on each other\n");
+
+	// One of the two loads must notice it waits for the other and fail its dependency, instead of both waiting forever.
+	uint32_t errors = test_loader->cyclic_errors.get();
+	bool state = ResourceLoader::load_threaded_request("res://cycle_a.testres") == OK;
+	RES resource = ResourceLoader::load_threaded_get("res://cycle_a.testres");
+	state = state && resource.is_valid();
+	state = state && test_loader->cyclic_errors.get() == errors + 1;
+
+	// Both tasks are released, but only once neither is still waited for by the other one's thread.
+	uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while ((ResourceLoader::load_threaded_get_status("res://cycle_a.testres") != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE || ResourceLoader::load_threaded_get_status("res://cycle_b.testres") != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE) && OS::get_singleton()->get_ticks_msec() - begin < 10000) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	state = state && ResourceLoader::load_threaded_get_status("res://cycle_a.testres") == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	state = state && ResourceLoader::load_threaded_get_status("res://cycle_b.testres") == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_shared_request,
+	test_progress,
+	test_cyclic_dependency,
+	nullptr
+
+};
+
+MainLoop *test() {
+	test_loader.instance();
+	ResourceLoader::add_resource_format_loader(test_loader, true);
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	ResourceLoader::remove_resource_format_loader(test_loader);
+	test_loader.unref();
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestResourceLoader
@@ -0,0 +1,226 @@
+/*************************************************************************/
+/*  test_signals.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_signals.h"
+
+#include "core/class_db.h"
+#include "core/os/os.h"
+
+#define EMIT_COUNT 100000
+
+namespace TestSignals {
+
+class SignalListener : public Object {
+	GDCLASS(SignalListener, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_on_fired", "value"), &SignalListener::_on_fired);
+		ClassDB::bind_method(D_METHOD("_on_fired_bound", "value", "bound"), &SignalListener::_on_fired_bound);
+	}
+
+public:
+	int64_t total;
+
+	void _on_fired(int p_value) {
+		total += p_value;
+	}
+
+	void _on_fired_bound(int p_value, int p_bound) {
+		total += p_value * p_bound;
+	}
+
+	SignalListener() {
+		total = 0;
+	}
+};
+
+// Counts the calls that reach call(), which emitting must not bypass.
+class CallCountingListener : public SignalListener {
+	GDCLASS(CallCountingListener, SignalListener);
+
+public:
+	int calls;
+
+	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) override {
+		calls++;
+		return SignalListener::call(p_method, p_args, p_argcount, r_error);
+	}
+
+	CallCountingListener() {
+		calls = 0;
+	}
+};
+
+// Inherits the call() override without declaring its own.
+class CallCountingChild : public CallCountingListener {
+	GDCLASS(CallCountingChild, CallCountingListener);
+};
+
+// Emits a signal EMIT_COUNT times to p_listeners listeners and prints how long each emit took.
+static bool _measure(int p_listeners, bool p_binds) {
+	Object *emitter = memnew(Object);
+	emitter->add_user_signal(MethodInfo("fired", PropertyInfo(Variant::INT, "value")));
+
+	Vector<SignalListener *> listeners;
+	for (int i = 0; i < p_listeners; i++) {
+		SignalListener *listener = memnew(SignalListener);
+		if (p_binds) {
+			Vector<Variant> binds;
+			binds.push_back(2);
+			emitter->connect("fired", listener, "_on_fired_bound", binds);
+		} else {
+			emitter->connect("fired", listener, "_on_fired");
+		}
+		listeners.push_back(listener);
+	}
+
+	StringName signal = "fired";
+	Variant value = 1;
+	const Variant *args[1] = { &value };
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < EMIT_COUNT; i++) {
+		emitter->emit_signal(signal, args, 1);
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	bool all_called = true;
+	for (int i = 0; i < p_listeners; i++) {
+		all_called = all_called && listeners[i]->total == EMIT_COUNT * (p_binds ? 2 : 1);
+		memdelete(listeners[i]);
+	}
+	memdelete(emitter);
+
+	OS::get_singleton()->print("	%d listener(s): %.3f usec per emit\n", p_listeners, usec / double(EMIT_COUNT));
+	return all_called;
+}
+
+bool test_emit() {
+	OS::get_singleton()->print("\n\nTest emitting to 0, 1 and 10 listeners\n");
+
+	bool state = _measure(0, false);
+	state = _measure(1, false) && state;
+	state = _measure(10, false) && state;
+	return state;
+}
+
+bool test_emit_bound() {
+	OS::get_singleton()->print("\n\nTest emitting to listeners with a bound argument\n");
+
+	bool state = _measure(1, true);
+	state = _measure(10, true) && state;
+	return state;
+}
+
+bool test_oneshot() {
+	OS::get_singleton()->print("\n\nTest one shot connections\n");
+
+	Object *emitter = memnew(Object);
+	emitter->add_user_signal(MethodInfo("fired", PropertyInfo(Variant::INT, "value")));
+	SignalListener *once = memnew(SignalListener);
+	SignalListener *always = memnew(SignalListener);
+	emitter->connect("fired", once, "_on_fired", Vector<Variant>(), Object::CONNECT_ONESHOT);
+	emitter->connect("fired", always, "_on_fired");
+	emitter->emit_signal("fired", 1);
+	emitter->emit_signal("fired", 1);
+
+	bool state = once->total == 1 && always->total == 2;
+	state = state && !emitter->is_connected("fired", once, "_on_fired");
+	memdelete(once);
+	memdelete(always);
+	memdelete(emitter);
+	return state;
+}
+
+bool test_call_override() {
+	OS::get_singleton()->print("\n\nTest emitting goes through overridden call()\n");
+
+	Object *emitter = memnew(Object);
+	emitter->add_user_signal(MethodInfo("fired", PropertyInfo(Variant::INT, "value")));
+	SignalListener *plain = memnew(SignalListener);
+	CallCountingListener *counting = memnew(CallCountingListener);
+	CallCountingChild *child = memnew(CallCountingChild);
+	emitter->connect("fired", plain, "_on_fired");
+	emitter->connect("fired", counting, "_on_fired");
+	emitter->connect("fired", child, "_on_fired");
+	emitter->emit_signal("fired", 1);
+	emitter->emit_signal("fired", 1);
+
+	bool state = plain->total == 2 && counting->total == 2 && child->total == 2;
+	state = state && counting->calls == 2 && child->calls == 2;
+	memdelete(plain);
+	memdelete(counting);
+	memdelete(child);
+	memdelete(emitter);
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_emit,
+	test_emit_bound,
+	test_oneshot,
+	test_call_override,
+	nullptr
+
+};
+
+MainLoop *test() {
+	ClassDB::register_class<SignalListener>();
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestSignals
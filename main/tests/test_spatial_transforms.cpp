@@ -0,0 +1,242 @@
+/*************************************************************************/
+/*  test_spatial_transforms.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_spatial_transforms.h"
+
+#include "core/os/os.h"
+#include "core/project_settings.h"
+#include "scene/3d/spatial.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+// Enough branches for a level to be split across the worker threads when the parallel update is enabled.
+#define BRANCH_COUNT 300
+
+namespace TestSpatialTransforms {
+
+// A tree with a root spatial holding BRANCH_COUNT branches of two spatials each, and a second root
+// to reparent branches to. Every spatial asks for transform notifications, so all of them go through
+// the flat update in SceneTree::flush_transform_notifications().
+struct TransformScene {
+	SceneTree *tree;
+	Spatial *root;
+	Spatial *other_root;
+	Vector<Spatial *> branches;
+
+	Spatial *_create_spatial(Node *p_parent, int p_index) {
+		Spatial *spatial = memnew(Spatial);
+		spatial->set_notify_transform(true);
+		spatial->set_transform(Transform(Basis(Vector3(0, 1, 0), p_index * 0.01), Vector3(p_index % 7, 1, 0)));
+		p_parent->add_child(spatial);
+		return spatial;
+	}
+
+	TransformScene(bool p_parallel) {
+		ProjectSettings::get_singleton()->set("rendering/threads/parallel_transform_update", p_parallel);
+		tree = memnew(SceneTree);
+		tree->init();
+
+		root = _create_spatial(tree->get_root(), 1);
+		other_root = _create_spatial(tree->get_root(), 2);
+		for (int i = 0; i < BRANCH_COUNT; i++) {
+			Spatial *branch = _create_spatial(root, i);
+			_create_spatial(branch, i + 1);
+			branches.push_back(branch);
+		}
+		tree->flush_transform_notifications();
+	}
+
+	~TransformScene() {
+		tree->finish();
+		memdelete(tree);
+	}
+
+	void move(Spatial *p_spatial, real_t p_angle) {
+		p_spatial->rotate_z(p_angle);
+		p_spatial->translate(Vector3(0, 0, p_angle));
+	}
+
+	// Checks the global transforms of p_spatial and everything below it against the product of the local transforms.
+	bool check(Spatial *p_spatial, const Transform &p_parent_global) const {
+		Transform global = p_spatial->is_set_as_toplevel() ? p_spatial->get_transform() : p_parent_global * p_spatial->get_transform();
+		if (!p_spatial->get_global_transform().is_equal_approx(global)) {
+			return false;
+		}
+
+		for (int i = 0; i < p_spatial->get_child_count(); i++) {
+			Spatial *child = Object::cast_to<Spatial>(p_spatial->get_child(i));
+			if (child && !check(child, global)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool check() const {
+		return check(root, Transform()) && check(other_root, Transform());
+	}
+};
+
+bool test_move() {
+	OS::get_singleton()->print("\n\nTest global transforms after moving the root and some branches\n");
+
+	bool state = true;
+	for (int parallel = 0; parallel < 2; parallel++) {
+		TransformScene scene(parallel);
+		scene.move(scene.root, 0.5);
+		for (int i = 0; i < BRANCH_COUNT; i += 3) {
+			scene.move(scene.branches[i], 0.25);
+		}
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+	}
+
+	return state;
+}
+
+bool test_reparent() {
+	OS::get_singleton()->print("\n\nTest global transforms after reparenting branches\n");
+
+	bool state = true;
+	for (int parallel = 0; parallel < 2; parallel++) {
+		TransformScene scene(parallel);
+		scene.move(scene.root, 0.5);
+		for (int i = 0; i < BRANCH_COUNT; i += 2) {
+			scene.root->remove_child(scene.branches[i]);
+			scene.other_root->add_child(scene.branches[i]);
+		}
+		scene.move(scene.other_root, -0.75);
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+
+		// Move them back after their transforms were cached under the other root.
+		for (int i = 0; i < BRANCH_COUNT; i += 2) {
+			scene.other_root->remove_child(scene.branches[i]);
+			scene.root->add_child(scene.branches[i]);
+		}
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+	}
+
+	return state;
+}
+
+bool test_toplevel() {
+	OS::get_singleton()->print("\n\nTest global transforms of top level branches\n");
+
+	bool state = true;
+	for (int parallel = 0; parallel < 2; parallel++) {
+		TransformScene scene(parallel);
+		for (int i = 0; i < BRANCH_COUNT; i += 2) {
+			scene.branches[i]->set_as_toplevel(true);
+		}
+		scene.move(scene.root, 0.5);
+		scene.move(scene.branches[0], 0.25);
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+
+		// Leaving the top level keeps the global transform, but then follows the root again.
+		for (int i = 0; i < BRANCH_COUNT; i += 2) {
+			scene.branches[i]->set_as_toplevel(false);
+		}
+		scene.move(scene.root, -0.25);
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+	}
+
+	return state;
+}
+
+bool test_hide_show() {
+	OS::get_singleton()->print("\n\nTest global transforms of branches moved while hidden\n");
+
+	bool state = true;
+	for (int parallel = 0; parallel < 2; parallel++) {
+		TransformScene scene(parallel);
+		scene.root->hide();
+		scene.move(scene.root, 0.5);
+		for (int i = 0; i < BRANCH_COUNT; i += 3) {
+			scene.branches[i]->hide();
+			scene.move(scene.branches[i], 0.25);
+		}
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+
+		scene.root->show();
+		for (int i = 0; i < BRANCH_COUNT; i += 3) {
+			scene.move(scene.branches[i], 0.25);
+			scene.branches[i]->show();
+		}
+		scene.tree->flush_transform_notifications();
+		state = state && scene.check();
+	}
+
+	return state;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_move,
+	test_reparent,
+	test_toplevel,
+	test_hide_show,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestSpatialTransforms
@@ -31,7 +31,12 @@
 #include "test_string.h"
 
 #include "core/io/ip_address.h"
+#include "core/os/memory.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+#include "core/string_kernels.h"
+#include "core/string_name.h"
 #include "core/ustring.h"
 
 #include "modules/modules_enabled.gen.h" // For regex.
@@ -1211,6 +1216,248 @@ bool test_36() {
 	return true;
 }
 
+bool test_37() {
+	OS::get_singleton()->print("\n\nTest 37: StringName storage\n");
+	bool state = true;
+
+	// ASCII names are stored as chars, everything else as wide characters; both must behave the same.
+	String ascii = "test_37_ascii_name";
+	String wide = String::utf8("test_37_ñandú_name");
+	StringName ascii_name = ascii;
+	StringName wide_name = wide;
+	state = state && String(ascii_name) == ascii && String(wide_name) == wide;
+	state = state && ascii_name == ascii && wide_name == wide && ascii_name == "test_37_ascii_name";
+	state = state && ascii_name.hash() == ascii.hash() && wide_name.hash() == wide.hash();
+	state = state && StringName("test_37_ascii_name") == ascii_name && StringName::search(ascii.c_str()) == ascii_name;
+	state = state && StringName::search(wide) == wide_name && StringName::search(wide.c_str()) == wide_name;
+	// The first conversion widens the characters, the next ones share them.
+	state = state && String(ascii_name).ptr() == String(ascii_name).ptr() && String(StringName("test_37_ascii_name")) == ascii;
+	if (!state) {
+		OS::get_singleton()->print("\tFAIL: round trip\n");
+		return false;
+	}
+
+	const int count = 100000;
+	Vector<String> strings;
+	strings.resize(count);
+	for (int i = 0; i < count; i++) {
+		strings.write[i] = "Root/Level/Node_" + itos(i) + "/CollisionShape";
+	}
+
+	// What the names would take as Strings, and what they take as StringNames.
+	uint64_t mem = Memory::get_mem_usage();
+	Vector<String> copies;
+	copies.resize(count);
+	for (int i = 0; i < count; i++) {
+		copies.write[i] = String(strings[i].c_str());
+	}
+	uint64_t string_mem = Memory::get_mem_usage() - mem;
+	copies.clear();
+
+	// Built from temporaries, so the names don't share their characters with strings.
+	mem = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Vector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names.write[i] = String(strings[i].c_str());
+	}
+	uint64_t create_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t name_mem = Memory::get_mem_usage() - mem;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		state = state && StringName(strings[i]) == names[i];
+	}
+	uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int length = 0;
+	for (int i = 0; i < count; i++) {
+		length += String(names[i]).length();
+	}
+	uint64_t convert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		state = state && names[i] == strings[i];
+	}
+	uint64_t compare_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int expected_length = 0;
+	for (int i = 0; i < count; i++) {
+		expected_length += strings[i].length();
+	}
+	state = state && length == expected_length;
+	OS::get_singleton()->print("\t%i names of about %i characters:\n", count, strings[count - 1].length());
+	OS::get_singleton()->print("\t\tas Strings: %.1f bytes each\n", string_mem / double(count));
+	OS::get_singleton()->print("\t\tas StringNames: %.1f bytes each, including the table entry\n", name_mem / double(count));
+	OS::get_singleton()->print("\t\tcopy and create: %.3f usec, lookup: %.3f usec, to String: %.3f usec, == String: %.3f usec\n", create_usec / double(count), lookup_usec / double(count), convert_usec / double(count), compare_usec / double(count));
+
+	return state;
+}
+
+static String _kernel_results(const String &p_str) {
+	String results;
+	results += itos(p_str.find("bcX")) + "," + itos(p_str.find("bcX", 3)) + "," + itos(p_str.find(String::utf8("é日"))) + ",";
+	results += itos(p_str.find_char('_')) + "," + itos(p_str.find_char('_', 5)) + "," + itos(p_str.findn("XyZ")) + "," + itos(p_str.findn(String::utf8("É"))) + ",";
+	results += p_str.to_lower() + "," + p_str.replace("a", "[]") + "," + itos(p_str.split("Z").size()) + ",";
+	CharString utf8 = p_str.utf8();
+	results += itos(utf8.length()) + "," + itos(String::utf8(utf8.get_data()) == p_str) + "," + itos(String(p_str.c_str()) == p_str);
+	return results;
+}
+
+bool test_38() {
+	OS::get_singleton()->print("\n\nTest 38: String kernels\n");
+	bool state = true;
+
+	const StringKernels::Level supported = StringKernels::get_supported_level();
+	static const char *level_names[] = { "scalar", "SSE2", "AVX2" };
+	OS::get_singleton()->print("\tCPU supports: %s\n", level_names[supported]);
+
+	// Every level must give the scalar results, at every length and alignment the vector loops see.
+	const String alphabet = String::utf8("abcXYZ_ éÉ日");
+	uint32_t seed = 1;
+	for (int len = 0; len < 100 && state; len++) {
+		String sample;
+		for (int i = 0; i < len; i++) {
+			seed = seed * 1103515245 + 12345;
+			sample += alphabet[(seed >> 16) % alphabet.length()];
+		}
+
+		StringKernels::set_level(StringKernels::LEVEL_SCALAR);
+		const String expected = _kernel_results(sample);
+		for (int level = StringKernels::LEVEL_SSE2; level <= supported; level++) {
+			StringKernels::set_level(StringKernels::Level(level));
+			if (_kernel_results(sample) != expected) {
+				OS::get_singleton()->print("\tFAIL: %s differs from scalar for \"%ls\"\n", level_names[level], sample.c_str());
+				state = false;
+			}
+		}
+	}
+	StringKernels::set_level(supported);
+	if (!state) {
+		return false;
+	}
+
+	String text;
+	for (int i = 0; i < 1500; i++) {
+		text += "The quick brown fox jumps over the lazy dog. ";
+	}
+	text += "The end.";
+	const String mixed = text.replace("fox", String::utf8("renard à queue"));
+	const CharString mixed_utf8 = mixed.utf8();
+	const int repeat = 20;
+
+	OS::get_singleton()->print("\t%i characters, usec per call:\n\t\t%-16s", text.length(), "");
+	for (int level = StringKernels::LEVEL_SCALAR; level <= supported; level++) {
+		OS::get_singleton()->print("%10s", level_names[level]);
+	}
+	OS::get_singleton()->print("\n");
+
+	static const char *op_names[] = { "find", "findn", "replace", "split", "to_lower", "utf8", "parse_utf8" };
+	const int op_count = sizeof(op_names) / sizeof(op_names[0]);
+	for (int op = 0; op < op_count; op++) {
+		OS::get_singleton()->print("\t\t%-16s", op_names[op]);
+		int first_result = 0;
+		for (int level = StringKernels::LEVEL_SCALAR; level <= supported; level++) {
+			StringKernels::set_level(StringKernels::Level(level));
+			int result = 0;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < repeat; i++) {
+				switch (op) {
+					case 0:
+						result += text.find("The end");
+						break;
+					case 1:
+						result += text.findn("THE END");
+						break;
+					case 2:
+						result += text.replace("fox", "cat").length();
+						break;
+					case 3:
+						result += text.split(".").size();
+						break;
+					case 4:
+						result += text.to_lower().length();
+						break;
+					case 5:
+						result += mixed.utf8().length();
+						break;
+					case 6:
+						result += String::utf8(mixed_utf8.get_data(), mixed_utf8.length()).length();
+						break;
+				}
+			}
+			uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+			OS::get_singleton()->print("%10.1f", usec / double(repeat));
+
+			if (level == StringKernels::LEVEL_SCALAR) {
+				first_result = result;
+			}
+			state = state && result == first_result;
+		}
+		OS::get_singleton()->print("\n");
+	}
+	StringKernels::set_level(supported);
+
+	return state;
+}
+
+// Shared by the threads of test_39.
+static const int string_name_thread_count = 4;
+static const int string_name_shared_count = 256;
+static Vector<StringName> string_name_shared;
+static SafeNumeric<uint32_t> string_name_errors;
+
+static void _string_name_thread(void *p_userdata) {
+	int index = (intptr_t)p_userdata;
+	for (int round = 0; round < 20; round++) {
+		// Enough new names to grow the table while the others look theirs up, all freed again at the end of the round.
+		Vector<StringName> own;
+		for (int i = 0; i < 2000; i++) {
+			own.push_back(StringName("test_39_" + itos(index) + "_" + itos(i)));
+			const StringName &shared = string_name_shared[(i * 7 + round) % string_name_shared_count];
+			String expected = "test_39_shared_" + itos((i * 7 + round) % string_name_shared_count);
+			if (StringName(expected) != shared || StringName::search(expected) != shared || String(shared) != expected) {
+				string_name_errors.increment();
+			}
+		}
+		for (int i = 0; i < own.size(); i++) {
+			if (String(own[i]) != "test_39_" + itos(index) + "_" + itos(i)) {
+				string_name_errors.increment();
+			}
+		}
+	}
+}
+
+bool test_39() {
+	OS::get_singleton()->print("\n\nTest 39: StringName from several threads\n");
+
+	// Shared names are converted for the first time by all the threads at once.
+	string_name_shared.resize(string_name_shared_count);
+	for (int i = 0; i < string_name_shared_count; i++) {
+		string_name_shared.write[i] = StringName("test_39_shared_" + itos(i));
+	}
+	uint32_t names_before = StringName::get_table_stats().names;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Thread threads[string_name_thread_count];
+	for (int i = 0; i < string_name_thread_count; i++) {
+		threads[i].start(_string_name_thread, (void *)(intptr_t)i);
+	}
+	for (int i = 0; i < string_name_thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	OS::get_singleton()->print("\t%i threads: %.3f msec\n", string_name_thread_count, (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0);
+
+	// Every name the threads created was released again.
+	bool state = string_name_errors.get() == 0 && StringName::get_table_stats().names == names_before;
+	string_name_shared.clear();
+
+	return state;
+}
+
 typedef bool (*TestFunc)();
 
 TestFunc test_funcs[] = {
@@ -1251,6 +1498,9 @@ TestFunc test_funcs[] = {
 	test_34,
 	test_35,
 	test_36,
+	test_37,
+	test_38,
+	test_39,
 	nullptr
 
 };
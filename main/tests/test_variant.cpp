@@ -0,0 +1,201 @@
+/*************************************************************************/
+/*  test_variant.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_variant.h"
+
+#include "core/os/os.h"
+#include "core/variant.h"
+
+namespace TestVariant {
+
+#define BENCHMARK_CALLS 1000000
+
+bool test_1() {
+	OS::get_singleton()->print("\n\nTest 1: Resolved built-in method gives the same result as a call by name\n");
+
+	Variant v = Vector3(1, 2, 3);
+	Variant arg = Vector3(4, 5, 6);
+	const Variant *args[1] = { &arg };
+
+	Variant::CallError ce;
+	Variant by_name = v.call("dot", args, 1, ce);
+	if (ce.error != Variant::CallError::CALL_OK) {
+		return false;
+	}
+
+	Variant::BuiltInMethod method = Variant::get_builtin_method(Variant::VECTOR3, "dot");
+	if (!method) {
+		return false;
+	}
+
+	Variant resolved;
+	v.call_builtin(method, args, 1, &resolved, ce);
+
+	OS::get_singleton()->print("\tBy name: %ls, resolved: %ls\n", String(by_name).c_str(), String(resolved).c_str());
+
+	return ce.error == Variant::CallError::CALL_OK && by_name == resolved && resolved == Variant(32.0);
+}
+
+bool test_2() {
+	OS::get_singleton()->print("\n\nTest 2: Resolved built-in method rejects other types and unknown methods\n");
+
+	if (Variant::get_builtin_method(Variant::VECTOR3, "no_such_method")) {
+		return false;
+	}
+
+	Variant::BuiltInMethod method = Variant::get_builtin_method(Variant::VECTOR3, "length");
+	Variant v = Vector2(3, 4);
+	Variant ret;
+	Variant::CallError ce;
+	v.call_builtin(method, nullptr, 0, &ret, ce);
+	if (ce.error != Variant::CallError::CALL_ERROR_INVALID_METHOD) {
+		return false;
+	}
+
+	v.call_builtin(nullptr, nullptr, 0, &ret, ce);
+	return ce.error == Variant::CallError::CALL_ERROR_INVALID_METHOD;
+}
+
+bool test_3() {
+	OS::get_singleton()->print("\n\nTest 3: Benchmark Vector3.dot by name and resolved\n");
+
+	Variant v = Vector3(1, 2, 3);
+	Variant arg = Vector3(4, 5, 6);
+	const Variant *args[1] = { &arg };
+	StringName dot = "dot";
+	Variant ret;
+	Variant::CallError ce;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCHMARK_CALLS; i++) {
+		v.call_ptr(dot, args, 1, &ret, ce);
+	}
+	uint64_t by_name = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Variant::BuiltInMethod method = Variant::get_builtin_method(Variant::VECTOR3, dot);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCHMARK_CALLS; i++) {
+		v.call_builtin(method, args, 1, &ret, ce);
+	}
+	uint64_t resolved = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\t%i calls by name: %i usec, resolved: %i usec\n", BENCHMARK_CALLS, (int)by_name, (int)resolved);
+
+	return ce.error == Variant::CallError::CALL_OK && ret == Variant(32.0);
+}
+
+bool test_4() {
+	OS::get_singleton()->print("\n\nTest 4: Benchmark Array.push_back by name and resolved\n");
+
+	Array array;
+	Variant v = array;
+	Variant arg = 1;
+	const Variant *args[1] = { &arg };
+	StringName push_back = "push_back";
+	Variant::CallError ce;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCHMARK_CALLS; i++) {
+		v.call_ptr(push_back, args, 1, nullptr, ce);
+	}
+	uint64_t by_name = OS::get_singleton()->get_ticks_usec() - begin;
+
+	array.clear();
+
+	Variant::BuiltInMethod method = Variant::get_builtin_method(Variant::ARRAY, push_back);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCHMARK_CALLS; i++) {
+		v.call_builtin(method, args, 1, nullptr, ce);
+	}
+	uint64_t resolved = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\t%i calls by name: %i usec, resolved: %i usec\n", BENCHMARK_CALLS, (int)by_name, (int)resolved);
+
+	return ce.error == Variant::CallError::CALL_OK && array.size() == BENCHMARK_CALLS;
+}
+
+bool test_5() {
+	OS::get_singleton()->print("\n\nTest 5: Method list is sorted by name\n");
+
+	List<MethodInfo> methods;
+	Variant(Vector3()).get_method_list(&methods);
+	if (methods.size() < 2) {
+		return false;
+	}
+
+	for (List<MethodInfo>::Element *E = methods.front(); E->next(); E = E->next()) {
+		if (!(String(E->get().name) < String(E->next()->get().name))) {
+			OS::get_singleton()->print("\t%s listed before %s\n", String(E->get().name).utf8().get_data(), String(E->next()->get().name).utf8().get_data());
+			return false;
+		}
+	}
+	return true;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+
+	test_1,
+	test_2,
+	test_3,
+	test_4,
+	test_5,
+	nullptr
+
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+} // namespace TestVariant
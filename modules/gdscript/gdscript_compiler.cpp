@@ -74,6 +74,14 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+Variant::Type GDScriptCompiler::_get_known_builtin_type(const GDScriptParser::Node *p_node) const {
+	const GDScriptParser::DataType datatype = p_node->get_datatype();
+	if (!datatype.has_type || datatype.is_meta_type || datatype.kind != GDScriptParser::DataType::BUILTIN) {
+		return Variant::NIL;
+	}
+	return datatype.builtin_type;
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
 
@@ -82,8 +90,16 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 		return false;
 	}
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-	codegen.opcodes.push_back(op); //which operator
+	Variant::Type type_a = _get_known_builtin_type(on->arguments[0]);
+	Variant::ValidatedOperatorEvaluator evaluator = type_a != Variant::NIL ? Variant::get_validated_operator_evaluator(op, type_a, Variant::NIL) : nullptr;
+	if (evaluator) {
+		// Argument 2 repeats argument 1, so it has the same type at runtime.
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_VALIDATED); // perform operator, skipping type checks
+		codegen.opcodes.push_back(codegen.get_validated_operator_pos(evaluator, op, type_a, type_a));
+	} else {
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+		codegen.opcodes.push_back(op); //which operator
+	}
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
 	//codegen.opcodes.push_back(GDScriptFunction::ADDR_TYPE_NIL); // argument 2 (unary only takes one parameter)
@@ -106,8 +122,16 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 		return false;
 	}
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-	codegen.opcodes.push_back(op); //which operator
+	Variant::Type type_a = _get_known_builtin_type(on->arguments[0]);
+	Variant::Type type_b = _get_known_builtin_type(on->arguments[1]);
+	Variant::ValidatedOperatorEvaluator evaluator = (type_a != Variant::NIL && type_b != Variant::NIL) ? Variant::get_validated_operator_evaluator(op, type_a, type_b) : nullptr;
+	if (evaluator) {
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_VALIDATED); // perform operator, skipping type checks
+		codegen.opcodes.push_back(codegen.get_validated_operator_pos(evaluator, op, type_a, type_b));
+	} else {
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+		codegen.opcodes.push_back(op); //which operator
+	}
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
 	return true;
@@ -668,10 +692,23 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							arguments.push_back(ret);
 						}
 
-						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						// Resolve the method now if the base is known to be a builtin type other than Object.
+						Variant::Type base_type = _get_known_builtin_type(instance);
+						Variant::BuiltInMethod method = (base_type != Variant::NIL && base_type != Variant::OBJECT) ? Variant::get_builtin_method(base_type, static_cast<const GDScriptParser::IdentifierNode *>(on->arguments[1])->name) : nullptr;
+
+						if (method) {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL_VALIDATED : GDScriptFunction::OPCODE_CALL_RETURN_VALIDATED); // perform operator, skipping the method lookup
+						} else {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						}
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++) {
+						codegen.opcodes.push_back(arguments[0]); // base
+						codegen.opcodes.push_back(arguments[1]); // method name
+						if (method) {
+							codegen.opcodes.push_back(codegen.get_validated_builtin_method_pos(method, base_type));
+						}
+						for (int i = 2; i < arguments.size(); i++) {
 							codegen.opcodes.push_back(arguments[i]);
 						}
 					}
@@ -717,6 +754,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					}
 
 					int index;
+					StringName index_name;
 					if (p_index_addr != 0) {
 						index = p_index_addr;
 					} else if (named) {
@@ -738,13 +776,14 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							}
 						}
 
-						index = codegen.get_name_map_pos(static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+						index_name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name;
+						index = codegen.get_name_map_pos(index_name);
 
 					} else {
 						if (on->arguments[1]->type == GDScriptParser::Node::TYPE_CONSTANT && static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value.get_type() == Variant::STRING) {
 							//also, somehow, named (speed up anyway)
-							StringName name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
-							index = codegen.get_name_map_pos(name);
+							index_name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
+							index = codegen.get_name_map_pos(index_name);
 							named = true;
 
 						} else {
@@ -761,9 +800,33 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						}
 					}
 
-					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
-					codegen.opcodes.push_back(from); // argument 1
-					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					// Resolve the getter now if the type of the base is known.
+					Variant::Type base_type = p_index_addr == 0 ? _get_known_builtin_type(on->arguments[0]) : Variant::NIL;
+					int validated_pos = -1;
+					if (base_type != Variant::NIL) {
+						if (named) {
+							Variant::ValidatedGetter getter = Variant::get_validated_member_getter(base_type, index_name);
+							if (getter) {
+								validated_pos = codegen.get_validated_getter_pos(getter, base_type);
+							}
+						} else if (_get_known_builtin_type(on->arguments[1]) == Variant::INT) {
+							Variant::ValidatedIndexedGetter getter = Variant::get_validated_indexed_getter(base_type);
+							if (getter) {
+								validated_pos = codegen.get_validated_indexed_getter_pos(getter, base_type);
+							}
+						}
+					}
+
+					if (validated_pos >= 0) {
+						codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED_VALIDATED : GDScriptFunction::OPCODE_GET_VALIDATED); // perform operator, skipping type checks
+						codegen.opcodes.push_back(from); // argument 1
+						codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+						codegen.opcodes.push_back(validated_pos);
+					} else {
+						codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
+						codegen.opcodes.push_back(from); // argument 1
+						codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					}
 
 				} break;
 				case GDScriptParser::OperatorNode::OP_AND: {
@@ -1769,12 +1832,29 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 			gdfunc->global_names.write[E->get()] = E->key();
 		}
 		gdfunc->_global_names_count = gdfunc->global_names.size();
+		gdfunc->method_call_caches.resize(gdfunc->global_names.size());
+		gdfunc->_method_call_caches_ptr = gdfunc->method_call_caches.ptrw();
 
 	} else {
 		gdfunc->_global_names_ptr = nullptr;
 		gdfunc->_global_names_count = 0;
+		gdfunc->_method_call_caches_ptr = nullptr;
 	}
 
+	//validated instructions
+	gdfunc->validated_operators = codegen.validated_operators;
+	gdfunc->_validated_operators_ptr = gdfunc->validated_operators.ptr();
+	gdfunc->_validated_operators_count = gdfunc->validated_operators.size();
+	gdfunc->validated_getters = codegen.validated_getters;
+	gdfunc->_validated_getters_ptr = gdfunc->validated_getters.ptr();
+	gdfunc->_validated_getters_count = gdfunc->validated_getters.size();
+	gdfunc->validated_indexed_getters = codegen.validated_indexed_getters;
+	gdfunc->_validated_indexed_getters_ptr = gdfunc->validated_indexed_getters.ptr();
+	gdfunc->_validated_indexed_getters_count = gdfunc->validated_indexed_getters.size();
+	gdfunc->validated_builtin_methods = codegen.validated_builtin_methods;
+	gdfunc->_validated_builtin_methods_ptr = gdfunc->validated_builtin_methods.ptr();
+	gdfunc->_validated_builtin_methods_count = gdfunc->validated_builtin_methods.size();
+
 #ifdef TOOLS_ENABLED
 	// Named globals
 	if (codegen.named_globals.size()) {
@@ -118,6 +118,66 @@ class GDScriptCompiler {
 			return pos;
 		}
 
+		Vector<GDScriptFunction::ValidatedOperator> validated_operators;
+		Vector<GDScriptFunction::ValidatedGetter> validated_getters;
+		Vector<GDScriptFunction::ValidatedIndexedGetter> validated_indexed_getters;
+		Vector<GDScriptFunction::ValidatedBuiltInMethod> validated_builtin_methods;
+
+		int get_validated_operator_pos(Variant::ValidatedOperatorEvaluator p_evaluator, Variant::Operator p_op, Variant::Type p_type_a, Variant::Type p_type_b) {
+			for (int i = 0; i < validated_operators.size(); i++) {
+				const GDScriptFunction::ValidatedOperator &vop = validated_operators[i];
+				if (vop.evaluator == p_evaluator && vop.op == p_op && vop.type_a == p_type_a && vop.type_b == p_type_b) {
+					return i;
+				}
+			}
+			GDScriptFunction::ValidatedOperator vop;
+			vop.evaluator = p_evaluator;
+			vop.op = p_op;
+			vop.type_a = p_type_a;
+			vop.type_b = p_type_b;
+			validated_operators.push_back(vop);
+			return validated_operators.size() - 1;
+		}
+
+		int get_validated_getter_pos(Variant::ValidatedGetter p_getter, Variant::Type p_base_type) {
+			for (int i = 0; i < validated_getters.size(); i++) {
+				if (validated_getters[i].getter == p_getter && validated_getters[i].base_type == p_base_type) {
+					return i;
+				}
+			}
+			GDScriptFunction::ValidatedGetter vget;
+			vget.getter = p_getter;
+			vget.base_type = p_base_type;
+			validated_getters.push_back(vget);
+			return validated_getters.size() - 1;
+		}
+
+		int get_validated_indexed_getter_pos(Variant::ValidatedIndexedGetter p_getter, Variant::Type p_base_type) {
+			for (int i = 0; i < validated_indexed_getters.size(); i++) {
+				if (validated_indexed_getters[i].getter == p_getter && validated_indexed_getters[i].base_type == p_base_type) {
+					return i;
+				}
+			}
+			GDScriptFunction::ValidatedIndexedGetter vget;
+			vget.getter = p_getter;
+			vget.base_type = p_base_type;
+			validated_indexed_getters.push_back(vget);
+			return validated_indexed_getters.size() - 1;
+		}
+
+		int get_validated_builtin_method_pos(Variant::BuiltInMethod p_method, Variant::Type p_base_type) {
+			for (int i = 0; i < validated_builtin_methods.size(); i++) {
+				if (validated_builtin_methods[i].method == p_method && validated_builtin_methods[i].base_type == p_base_type) {
+					return i;
+				}
+			}
+			GDScriptFunction::ValidatedBuiltInMethod vcall;
+			vcall.method = p_method;
+			vcall.base_type = p_base_type;
+			validated_builtin_methods.push_back(vcall);
+			return validated_builtin_methods.size() - 1;
+		}
+
 		Vector<int> opcodes;
 		void alloc_stack(int p_level) {
 			if (p_level >= stack_max) {
@@ -140,6 +200,7 @@ class GDScriptCompiler {
 
 	void _set_error(const String &p_error, const GDScriptParser::Node *p_node);
 
+	Variant::Type _get_known_builtin_type(const GDScriptParser::Node *p_node) const;
 	bool _create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
 	bool _create_binary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false, int p_index_addr = 0);
 
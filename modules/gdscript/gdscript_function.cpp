@@ -187,12 +187,15 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_VALIDATED,          \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
 		&&OPCODE_GET,                         \
+		&&OPCODE_GET_VALIDATED,               \
 		&&OPCODE_SET_NAMED,                   \
 		&&OPCODE_GET_NAMED,                   \
+		&&OPCODE_GET_NAMED_VALIDATED,         \
 		&&OPCODE_SET_MEMBER,                  \
 		&&OPCODE_GET_MEMBER,                  \
 		&&OPCODE_ASSIGN,                      \
@@ -209,6 +212,8 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 		&&OPCODE_CONSTRUCT_DICTIONARY,        \
 		&&OPCODE_CALL,                        \
 		&&OPCODE_CALL_RETURN,                 \
+		&&OPCODE_CALL_VALIDATED,              \
+		&&OPCODE_CALL_RETURN_VALIDATED,       \
 		&&OPCODE_CALL_BUILT_IN,               \
 		&&OPCODE_CALL_SELF,                   \
 		&&OPCODE_CALL_SELF_BASE,              \
@@ -461,6 +466,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED) {
+				CHECK_SPACE(5);
+
+				int validated_idx = _code_ptr[ip + 1];
+				GD_ERR_BREAK(validated_idx < 0 || validated_idx >= _validated_operators_count);
+				const ValidatedOperator &validated = _validated_operators_ptr[validated_idx];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(a->get_type() != validated.type_a || b->get_type() != validated.type_b || !validated.evaluator(*a, *b, dst))) {
+					// Same as OPCODE_OPERATOR, so errors are reported identically.
+					Variant::Operator op = validated.op;
+					bool valid;
+#ifdef DEBUG_ENABLED
+					Variant ret;
+					Variant::evaluate(op, *a, *b, ret, valid);
+					if (!valid) {
+						if (ret.get_type() == Variant::STRING) {
+							//return a string when invalid with the error
+							err_text = ret;
+							err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
+						} else {
+							err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+						}
+						OPCODE_BREAK;
+					}
+					*dst = ret;
+#else
+					Variant::evaluate(op, *a, *b, *dst, valid);
+#endif
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 				CHECK_SPACE(4);
 
@@ -598,6 +640,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_VALIDATED) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(src, 1);
+				GET_VARIANT_PTR(index, 2);
+				GET_VARIANT_PTR(dst, 4);
+
+				int validated_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(validated_idx < 0 || validated_idx >= _validated_indexed_getters_count);
+				const ValidatedIndexedGetter &validated = _validated_indexed_getters_ptr[validated_idx];
+
+				if (unlikely(src->get_type() != validated.base_type || index->get_type() != Variant::INT || !validated.getter(*src, (int64_t)*index, dst))) {
+					// Same as OPCODE_GET, so errors are reported identically.
+					bool valid;
+#ifdef DEBUG_ENABLED
+					Variant ret = src->get(*index, &valid);
+					if (!valid) {
+						String v = index->operator String();
+						if (v != "") {
+							v = "'" + v + "'";
+						} else {
+							v = "of type '" + _get_var_type(index) + "'";
+						}
+						err_text = "Invalid get index " + v + " (on base: '" + _get_var_type(src) + "').";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
+#else
+					*dst = src->get(*index, &valid);
+#endif
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -657,6 +734,45 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_NAMED_VALIDATED) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(src, 1);
+				GET_VARIANT_PTR(dst, 4);
+
+				int validated_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(validated_idx < 0 || validated_idx >= _validated_getters_count);
+				const ValidatedGetter &validated = _validated_getters_ptr[validated_idx];
+
+				if (likely(src->get_type() == validated.base_type)) {
+					validated.getter(*src, dst);
+				} else {
+					// Same as OPCODE_GET_NAMED, so errors are reported identically.
+					int indexname = _code_ptr[ip + 2];
+
+					GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+					const StringName *index = &_global_names_ptr[indexname];
+
+					bool valid;
+#ifdef DEBUG_ENABLED
+					Variant ret = src->get_named(*index, &valid);
+					if (!valid) {
+						if (src->has_method(*index)) {
+							err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "'). Did you mean '." + index->operator String() + "()' or funcref(obj, \"" + index->operator String() + "\") ?";
+						} else {
+							err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+						}
+						OPCODE_BREAK;
+					}
+					*dst = ret;
+#else
+					*dst = src->get_named(*index, &valid);
+#endif
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 				CHECK_SPACE(3);
 				int indexname = _code_ptr[ip + 1];
@@ -1012,10 +1128,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_RETURN_VALIDATED)
+			OPCODE(OPCODE_CALL_VALIDATED)
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
 				CHECK_SPACE(4);
-				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
+				int opcode = _code_ptr[ip];
+				bool call_ret = opcode == OPCODE_CALL_RETURN || opcode == OPCODE_CALL_RETURN_VALIDATED;
 
 				int argc = _code_ptr[ip + 1];
 				GET_VARIANT_PTR(base, 2);
@@ -1026,6 +1145,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GD_ERR_BREAK(argc < 0);
 				ip += 4;
+
+				// The validated variants carry a builtin method resolved by the compiler, used if the base has the expected type.
+				const ValidatedBuiltInMethod *validated = nullptr;
+				if (opcode == OPCODE_CALL_VALIDATED || opcode == OPCODE_CALL_RETURN_VALIDATED) {
+					CHECK_SPACE(1);
+					int validated_idx = _code_ptr[ip];
+					GD_ERR_BREAK(validated_idx < 0 || validated_idx >= _validated_builtin_methods_count);
+					validated = &_validated_builtin_methods_ptr[validated_idx];
+					ip += 1;
+				}
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -1043,9 +1172,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #endif
 				Variant::CallError err;
+				// Objects go through call_cached(), so native methods are resolved once per call site.
+				Object *base_obj = base->get_type() == Variant::OBJECT ? base->operator Object *() : nullptr;
 				if (call_ret) {
 					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (base_obj) {
+						Variant result = base_obj->call_cached(*methodname, (const Variant **)argptrs, argc, err, &_method_call_caches_ptr[nameg]);
+						if (err.error == Variant::CallError::CALL_OK) {
+							*ret = result;
+						}
+					} else if (validated && base->get_type() == validated->base_type) {
+						base->call_builtin(validated->method, (const Variant **)argptrs, argc, ret, err);
+					} else {
+						base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
+				} else if (base_obj) {
+					base_obj->call_cached(*methodname, (const Variant **)argptrs, argc, err, &_method_call_caches_ptr[nameg]);
+				} else if (validated && base->get_type() == validated->base_type) {
+					base->call_builtin(validated->method, (const Variant **)argptrs, argc, nullptr, err);
 				} else {
 					base->call_ptr(*methodname, (const Variant **)argptrs, argc, nullptr, err);
 				}
@@ -1177,7 +1321,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					*dst = E->get()->call(p_instance, (const Variant **)argptrs, argc, err);
 				} else if (gds->native.ptr()) {
 					if (*methodname != GDScriptLanguage::get_singleton()->strings._init) {
-						MethodBind *mb = ClassDB::get_method(gds->native->get_name(), *methodname);
+						MethodBind *mb = ClassDB::get_method_cached(gds->native->get_name(), *methodname, &_method_call_caches_ptr[self_fun]);
 						if (!mb) {
 							err.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
 						} else {
@@ -1606,6 +1750,11 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+Variant::Operator GDScriptFunction::get_validated_operator(int p_idx) const {
+	ERR_FAIL_INDEX_V(p_idx, validated_operators.size(), Variant::OP_MAX);
+	return validated_operators[p_idx].op;
+}
+
 int GDScriptFunction::get_default_argument_count() const {
 	return _default_arg_count;
 }
@@ -1698,6 +1847,7 @@ GDScriptFunction::GDScriptFunction() :
 		function_list(this) {
 	_stack_size = 0;
 	_call_size = 0;
+	_method_call_caches_ptr = nullptr;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
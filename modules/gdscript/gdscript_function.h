@@ -160,12 +160,15 @@ class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_VALIDATED,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
 		OPCODE_GET,
+		OPCODE_GET_VALIDATED,
 		OPCODE_SET_NAMED,
 		OPCODE_GET_NAMED,
+		OPCODE_GET_NAMED_VALIDATED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
 		OPCODE_ASSIGN,
@@ -182,6 +185,8 @@ public:
 		OPCODE_CONSTRUCT_DICTIONARY,
 		OPCODE_CALL,
 		OPCODE_CALL_RETURN,
+		OPCODE_CALL_VALIDATED,
+		OPCODE_CALL_RETURN_VALIDATED,
 		OPCODE_CALL_BUILT_IN,
 		OPCODE_CALL_SELF,
 		OPCODE_CALL_SELF_BASE,
@@ -224,6 +229,30 @@ public:
 		StringName identifier;
 	};
 
+	// Fast paths emitted by the compiler when the operand types are known.
+	// They are only taken if the operands have the expected types at runtime.
+	struct ValidatedOperator {
+		Variant::ValidatedOperatorEvaluator evaluator;
+		Variant::Operator op;
+		Variant::Type type_a;
+		Variant::Type type_b;
+	};
+
+	struct ValidatedGetter {
+		Variant::ValidatedGetter getter;
+		Variant::Type base_type;
+	};
+
+	struct ValidatedIndexedGetter {
+		Variant::ValidatedIndexedGetter getter;
+		Variant::Type base_type;
+	};
+
+	struct ValidatedBuiltInMethod {
+		Variant::BuiltInMethod method;
+		Variant::Type base_type;
+	};
+
 private:
 	friend class GDScriptCompiler;
 
@@ -234,6 +263,15 @@ private:
 	int _constant_count;
 	const StringName *_global_names_ptr;
 	int _global_names_count;
+	MethodCallCache *_method_call_caches_ptr;
+	const ValidatedOperator *_validated_operators_ptr;
+	int _validated_operators_count;
+	const ValidatedGetter *_validated_getters_ptr;
+	int _validated_getters_count;
+	const ValidatedIndexedGetter *_validated_indexed_getters_ptr;
+	int _validated_indexed_getters_count;
+	const ValidatedBuiltInMethod *_validated_builtin_methods_ptr;
+	int _validated_builtin_methods_count;
 #ifdef TOOLS_ENABLED
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
@@ -254,6 +292,11 @@ private:
 	StringName name;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	Vector<MethodCallCache> method_call_caches; // One per global name, for native calls.
+	Vector<ValidatedOperator> validated_operators;
+	Vector<ValidatedGetter> validated_getters;
+	Vector<ValidatedIndexedGetter> validated_indexed_getters;
+	Vector<ValidatedBuiltInMethod> validated_builtin_methods;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -317,6 +360,7 @@ public:
 	int get_code_size() const;
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
+	Variant::Operator get_validated_operator(int p_idx) const;
 	StringName get_name() const;
 	int get_max_stack_size() const;
 	int get_default_argument_count() const;
@@ -108,6 +108,14 @@ Error ImageLoaderJPG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force
 	PoolVector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_len();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	const uint8_t *borrowed = f->borrow_buffer(src_image_len);
+	if (borrowed) {
+		Error err = jpeg_load_image_from_buffer(p_image.ptr(), borrowed, src_image_len);
+		f->close();
+		return err;
+	}
+
 	src_image.resize(src_image_len);
 
 	PoolVector<uint8_t>::Write w = src_image.write();
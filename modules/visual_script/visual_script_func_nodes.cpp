@@ -722,6 +722,7 @@ public:
 	VisualScriptFunctionCall::RPCCallMode rpc_mode;
 	StringName function;
 	StringName singleton;
+	MethodCallCache method_cache;
 
 	VisualScriptFunctionCall *node;
 	VisualScriptInstance *instance;
@@ -767,9 +768,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(object, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = object->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = object->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				} else {
-					object->call(function, p_inputs, input_args, r_error);
+					object->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				}
 			} break;
 			case VisualScriptFunctionCall::CALL_MODE_NODE_PATH: {
@@ -790,9 +791,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(node, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = another->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = another->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				} else {
-					another->call(function, p_inputs, input_args, r_error);
+					another->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				}
 
 			} break;
@@ -839,9 +840,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(object, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = object->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = object->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				} else {
-					object->call(function, p_inputs, input_args, r_error);
+					object->call_cached(function, p_inputs, input_args, r_error, &method_cache);
 				}
 			} break;
 		}
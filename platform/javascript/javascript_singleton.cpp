@@ -80,6 +80,9 @@ public:
 	virtual Variant getvar(const Variant &p_key, bool *r_valid = nullptr) const override;
 	virtual void setvar(const Variant &p_key, const Variant &p_value, bool *r_valid = nullptr) override;
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argc, Variant::CallError &r_error) override;
+	virtual bool _overrides_call() const override {
+		return true;
+	}
 	JavaScriptObjectImpl() {}
 	JavaScriptObjectImpl(int p_id) { _js_id = p_id; }
 	~JavaScriptObjectImpl() {
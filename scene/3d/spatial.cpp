@@ -32,6 +32,7 @@
 
 #include "core/engine.h"
 #include "core/message_queue.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/viewport.h"
 #include "scene/scene_string_names.h"
@@ -268,28 +269,119 @@ Transform Spatial::get_transform() const {
 
 	return data.local_transform;
 }
+// Expects the global transform of the parent to be up to date.
+void Spatial::_update_global_transform() const {
+	if (data.dirty & DIRTY_LOCAL) {
+		_update_local_transform();
+	}
+
+	if (data.parent && !data.toplevel_active) {
+		data.global_transform = data.parent->data.global_transform * data.local_transform;
+	} else {
+		data.global_transform = data.local_transform;
+	}
+
+	if (data.disable_scale) {
+		data.global_transform.basis.orthonormalize();
+	}
+
+	data.dirty &= ~DIRTY_GLOBAL;
+}
+
 Transform Spatial::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform());
 
 	if (data.dirty & DIRTY_GLOBAL) {
-		if (data.dirty & DIRTY_LOCAL) {
-			_update_local_transform();
+		if (data.parent && !data.toplevel_active) {
+			data.parent->get_global_transform();
 		}
+		_update_global_transform();
+	}
 
-		if (data.parent && !data.toplevel_active) {
-			data.global_transform = data.parent->get_global_transform() * data.local_transform;
-		} else {
-			data.global_transform = data.local_transform;
+	return data.global_transform;
+}
+
+#define UPDATE_GLOBAL_TRANSFORMS_GRAIN 128
+
+uint32_t Spatial::update_pass = 0;
+LocalVector<Spatial *> Spatial::update_nodes;
+LocalVector<Spatial *> Spatial::update_sorted_nodes;
+LocalVector<uint32_t> Spatial::update_depth_offsets;
+
+void Spatial::_update_global_transform_task(void *p_userdata, uint32_t p_index) {
+	((Spatial **)p_userdata)[p_index]->_update_global_transform();
+}
+
+void Spatial::update_global_transforms(const SelfList<Node>::List &p_list, bool p_parallel) {
+	update_pass++;
+	update_nodes.clear();
+	uint32_t max_depth = 0;
+
+	// Gather the dirty spatials, climbing to their first clean ancestor, with their depth below it.
+	for (const SelfList<Node> *E = p_list.first(); E; E = E->next()) {
+		Spatial *spatial = Object::cast_to<Spatial>(E->self());
+		uint32_t chain_begin = update_nodes.size();
+		uint32_t depth = 0;
+
+		while (spatial && (spatial->data.dirty & DIRTY_GLOBAL)) {
+			if (spatial->data.update_pass == update_pass) {
+				depth = spatial->data.update_depth + 1;
+				break;
+			}
+			spatial->data.update_pass = update_pass;
+			update_nodes.push_back(spatial);
+			if (spatial->data.toplevel_active) {
+				break;
+			}
+			spatial = spatial->data.parent;
 		}
 
-		if (data.disable_scale) {
-			data.global_transform.basis.orthonormalize();
+		// The chain was gathered from the bottom up.
+		for (uint32_t i = update_nodes.size(); i > chain_begin; i--) {
+			update_nodes[i - 1]->data.update_depth = depth;
+			max_depth = MAX(max_depth, depth);
+			depth++;
 		}
+	}
 
-		data.dirty &= ~DIRTY_GLOBAL;
+	if (update_nodes.size() == 0) {
+		return;
 	}
 
-	return data.global_transform;
+	// Sort by depth, so every level only depends on the previous ones.
+	update_depth_offsets.resize(max_depth + 2);
+	for (uint32_t i = 0; i < update_depth_offsets.size(); i++) {
+		update_depth_offsets[i] = 0;
+	}
+	for (uint32_t i = 0; i < update_nodes.size(); i++) {
+		update_depth_offsets[update_nodes[i]->data.update_depth + 1]++;
+	}
+	for (uint32_t i = 1; i < update_depth_offsets.size(); i++) {
+		update_depth_offsets[i] += update_depth_offsets[i - 1];
+	}
+	update_sorted_nodes.resize(update_nodes.size());
+	for (uint32_t i = 0; i < update_nodes.size(); i++) {
+		update_sorted_nodes[update_depth_offsets[update_nodes[i]->data.update_depth]++] = update_nodes[i];
+	}
+
+	// The offsets now point to the end of each level.
+	ThreadWorkPool *work_pool = p_parallel ? ThreadWorkPool::get_singleton() : nullptr;
+	uint32_t level_begin = 0;
+	for (uint32_t depth = 0; depth <= max_depth; depth++) {
+		uint32_t level_end = update_depth_offsets[depth];
+		uint32_t count = level_end - level_begin;
+		Spatial **level = &update_sorted_nodes[level_begin];
+
+		if (work_pool && work_pool->get_thread_count() > 0 && count > UPDATE_GLOBAL_TRANSFORMS_GRAIN) {
+			work_pool->wait_for_group_task_completion(work_pool->add_group_task(_update_global_transform_task, level, count, UPDATE_GLOBAL_TRANSFORMS_GRAIN));
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				level[i]->_update_global_transform();
+			}
+		}
+
+		level_begin = level_end;
+	}
 }
 
 #ifdef TOOLS_ENABLED
@@ -814,6 +906,8 @@ Spatial::Spatial() :
 	data.inside_world = false;
 	data.visible = true;
 	data.disable_scale = false;
+	data.update_pass = 0;
+	data.update_depth = 0;
 
 	data.spatial_flags = SPATIAL_FLAG_VI_VISIBLE;
 
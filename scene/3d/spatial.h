@@ -31,6 +31,7 @@
 #ifndef SPATIAL_H
 #define SPATIAL_H
 
+#include "core/local_vector.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 
@@ -99,6 +100,10 @@ private:
 		bool visible;
 		bool disable_scale;
 
+		// Used by update_global_transforms().
+		uint32_t update_pass;
+		uint32_t update_depth;
+
 #ifdef TOOLS_ENABLED
 		Ref<SpatialGizmo> gizmo;
 		bool gizmo_disabled;
@@ -107,9 +112,16 @@ private:
 
 	} data;
 
+	static uint32_t update_pass;
+	static LocalVector<Spatial *> update_nodes;
+	static LocalVector<Spatial *> update_sorted_nodes;
+	static LocalVector<uint32_t> update_depth_offsets;
+
 	void _update_gizmo();
 	void _notify_dirty();
 	void _propagate_transform_changed(Spatial *p_origin);
+	void _update_global_transform() const;
+	static void _update_global_transform_task(void *p_userdata, uint32_t p_index);
 
 	void _propagate_visibility_changed();
 
@@ -230,6 +242,10 @@ public:
 
 	void force_update_transform();
 
+	// Brings the global transforms of the dirty spatials in the list, and of their dirty ancestors, up to date.
+	// They are processed one depth level at a time, and each level can be split across the worker threads.
+	static void update_global_transforms(const SelfList<Node>::List &p_list, bool p_parallel);
+
 	Spatial();
 	~Spatial();
 };
@@ -34,6 +34,62 @@
 #include "servers/visual_server.h"
 #include "skeleton.h"
 
+int VisualInstance::transform_batch_depth = 0;
+LocalVector<VisualInstance::TransformBatchItem> VisualInstance::transform_batch;
+
+void VisualInstance::begin_transform_batch() {
+	transform_batch_depth++;
+}
+
+void VisualInstance::end_transform_batch() {
+	ERR_FAIL_COND(transform_batch_depth == 0);
+	transform_batch_depth--;
+	if (transform_batch_depth > 0) {
+		return;
+	}
+
+	if (transform_batch.empty()) {
+		return;
+	}
+
+	Vector<RID> instances;
+	Vector<Transform> transforms;
+	instances.resize(transform_batch.size());
+	transforms.resize(transform_batch.size());
+	RID *instancesw = instances.ptrw();
+	Transform *transformsw = transforms.ptrw();
+	int count = 0;
+	for (uint32_t i = 0; i < transform_batch.size(); i++) {
+		VisualInstance *vi = transform_batch[i].visual_instance;
+		if (vi) {
+			instancesw[count] = vi->instance;
+			transformsw[count] = transform_batch[i].transform;
+			count++;
+			vi->transform_batch_index = -1;
+		}
+	}
+	transform_batch.clear();
+
+	instances.resize(count);
+	transforms.resize(count);
+	VisualServer::get_singleton()->instances_set_transforms(instances, transforms);
+}
+
+void VisualInstance::_send_transform() {
+	Transform gt = get_global_transform();
+	if (transform_batch_depth == 0) {
+		VisualServer::get_singleton()->instance_set_transform(instance, gt);
+	} else if (transform_batch_index >= 0) {
+		transform_batch[transform_batch_index].transform = gt;
+	} else {
+		transform_batch_index = transform_batch.size();
+		TransformBatchItem item;
+		item.visual_instance = this;
+		item.transform = gt;
+		transform_batch.push_back(item);
+	}
+}
+
 AABB VisualInstance::get_transformed_aabb() const {
 	return get_global_transform().xform(get_aabb());
 }
@@ -57,8 +113,7 @@ void VisualInstance::_update_visibility() {
 
 	// if making visible, make sure the visual server is up to date with the transform
 	if (visible && (!already_visible)) {
-		Transform gt = get_global_transform();
-		VisualServer::get_singleton()->instance_set_transform(instance, gt);
+		_send_transform();
 	}
 
 	_change_notify("visible");
@@ -81,11 +136,14 @@ void VisualInstance::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			if (_get_spatial_flags() & SPATIAL_FLAG_VI_VISIBLE) {
-				Transform gt = get_global_transform();
-				VisualServer::get_singleton()->instance_set_transform(instance, gt);
+				_send_transform();
 			}
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
+			if (transform_batch_index >= 0) {
+				transform_batch[transform_batch_index].visual_instance = nullptr;
+				transform_batch_index = -1;
+			}
 			VisualServer::get_singleton()->instance_set_scenario(instance, RID());
 			VisualServer::get_singleton()->instance_attach_skeleton(instance, RID());
 			//VS::get_singleton()->instance_geometry_set_baked_light_sampler(instance, RID() );
@@ -159,10 +217,14 @@ VisualInstance::VisualInstance() {
 	instance = VisualServer::get_singleton()->instance_create();
 	VisualServer::get_singleton()->instance_attach_object_instance_id(instance, get_instance_id());
 	layers = 1;
+	transform_batch_index = -1;
 	set_notify_transform(true);
 }
 
 VisualInstance::~VisualInstance() {
+	if (transform_batch_index >= 0) {
+		transform_batch[transform_batch_index].visual_instance = nullptr;
+	}
 	VisualServer::get_singleton()->free(instance);
 }
 
@@ -31,6 +31,7 @@
 #ifndef VISUAL_INSTANCE_H
 #define VISUAL_INSTANCE_H
 
+#include "core/local_vector.h"
 #include "core/math/face3.h"
 #include "core/rid.h"
 #include "scene/3d/cull_instance.h"
@@ -44,7 +45,17 @@ class VisualInstance : public CullInstance {
 	RID instance;
 	uint32_t layers;
 
+	struct TransformBatchItem {
+		VisualInstance *visual_instance;
+		Transform transform;
+	};
+
+	static int transform_batch_depth;
+	static LocalVector<TransformBatchItem> transform_batch;
+	int transform_batch_index;
+
 	RID _get_visual_instance_rid() const;
+	void _send_transform();
 
 protected:
 	void _update_visibility();
@@ -60,6 +71,10 @@ public:
 		FACES_DYNAMIC = 4 // dynamic object geometry
 	};
 
+	// While a batch is open, transform changes are gathered and sent to the VisualServer when the last one is closed.
+	static void begin_transform_batch();
+	static void end_transform_batch();
+
 	RID get_instance() const;
 	virtual AABB get_aabb() const = 0;
 	virtual PoolVector<Face3> get_faces(uint32_t p_usage_flags) const = 0;
@@ -47,6 +47,23 @@ VARIANT_ENUM_CAST(Node::PauseMode);
 
 int Node::orphan_node_count = 0;
 
+// Source of Node::data.path_generation values. They are never reused, so a cached lookup can't be
+// mistaken for one made from another node, or from the same node before something below it was removed.
+static SafeNumeric<uint64_t> node_path_generation(1);
+
+// Paths recently resolved by get_node_or_null(), per thread. Entries are direct-mapped by the node the
+// path was resolved from and the path hash, and are checked against the tree before being returned.
+#define NODE_PATH_CACHE_SIZE 256
+
+struct NodePathCacheEntry {
+	const Node *from;
+	Node *result;
+	uint64_t generation;
+	uint32_t path_hash;
+};
+
+static thread_local NodePathCacheEntry node_path_cache[NODE_PATH_CACHE_SIZE];
+
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
@@ -905,17 +922,24 @@ StringName Node::get_name() const {
 }
 
 void Node::_set_name_nocheck(const StringName &p_name) {
+	StringName old_name = data.name;
 	data.name = p_name;
+
+	if (data.parent) {
+		data.parent->_child_renamed(this, old_name);
+	}
 }
 
 void Node::set_name(const String &p_name) {
 	String name = p_name.validate_node_name();
 
 	ERR_FAIL_COND(name == "");
+	StringName old_name = data.name;
 	data.name = name;
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this);
+		data.parent->_child_renamed(this, old_name);
 	}
 
 	propagate_notification(NOTIFICATION_PATH_CHANGED);
@@ -968,18 +992,7 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			unique = false;
 		} else {
 			//check if exists
-			Node **children = data.children.ptrw();
-			int cc = data.children.size();
-
-			for (int i = 0; i < cc; i++) {
-				if (children[i] == p_child) {
-					continue;
-				}
-				if (children[i]->data.name == p_child->data.name) {
-					unique = false;
-					break;
-				}
-			}
+			unique = !_has_child_named(p_child->data.name, p_child);
 		}
 
 		if (!unique) {
@@ -1036,24 +1049,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	}
 
 	//quickly test if proposed name exists
-	int cc = data.children.size(); //children count
-	const Node *const *children_ptr = data.children.ptr();
-
-	{
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) { //exclude self in renaming if its already a child
-				continue;
-			}
-			if (children_ptr[i]->data.name == name) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
-			return; //if it does not exist, it does not need validation
-		}
+	if (!_has_child_named(name, p_child)) { //exclude self in renaming if its already a child
+		return; //if it does not exist, it does not need validation
 	}
 
 	// Extract trailing number
@@ -1080,18 +1077,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 
 	for (;;) {
 		StringName attempt = name_string + nums;
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) {
-				continue;
-			}
-			if (children_ptr[i]->data.name == attempt) {
-				exists = true;
-			}
-		}
 
-		if (!exists) {
+		if (!_has_child_named(attempt, p_child)) {
 			name = attempt;
 			return;
 		} else {
@@ -1112,6 +1099,9 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	p_child->data.name = p_name;
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
+	if (data.child_name_index) {
+		data.child_name_index->set(p_name, p_child);
+	}
 	p_child->data.parent = this;
 	p_child->notification(NOTIFICATION_PARENTED);
 
@@ -1213,6 +1203,12 @@ void Node::remove_child(Node *p_child) {
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
 	data.children.remove(idx);
+	if (data.child_name_index) {
+		Node **indexed = data.child_name_index->getptr(p_child->data.name);
+		if (indexed && *indexed == p_child) {
+			data.child_name_index->erase(p_child->data.name);
+		}
+	}
 
 	//update pointer and size
 	child_count = data.children.size();
@@ -1226,6 +1222,11 @@ void Node::remove_child(Node *p_child) {
 	p_child->data.parent = nullptr;
 	p_child->data.pos = -1;
 
+	// Nodes are always removed before being freed, so cached lookups based here or higher up may now point to freed nodes.
+	for (Node *ancestor = this; ancestor; ancestor = ancestor->data.parent) {
+		ancestor->data.path_generation = node_path_generation.increment();
+	}
+
 	// validate owner
 	p_child->_propagate_validate_owner();
 
@@ -1243,7 +1244,62 @@ Node *Node::get_child(int p_index) const {
 	return data.children[p_index];
 }
 
+void Node::set_child_name_index_enabled(bool p_enabled) {
+	if (p_enabled == (data.child_name_index != nullptr)) {
+		return;
+	}
+
+	if (p_enabled) {
+		data.child_name_index = memnew(ChildNameIndex);
+		for (int i = 0; i < data.children.size(); i++) {
+			data.child_name_index->set(data.children[i]->data.name, data.children[i]);
+		}
+	} else {
+		memdelete(data.child_name_index);
+		data.child_name_index = nullptr;
+	}
+}
+
+bool Node::is_child_name_index_enabled() const {
+	return data.child_name_index != nullptr;
+}
+
+void Node::_child_renamed(Node *p_child, const StringName &p_old_name) {
+	if (!data.child_name_index || p_child->data.name == p_old_name) {
+		return;
+	}
+
+	Node **indexed = data.child_name_index->getptr(p_old_name);
+	if (indexed && *indexed == p_child) {
+		data.child_name_index->erase(p_old_name);
+	}
+	data.child_name_index->set(p_child->data.name, p_child);
+}
+
+bool Node::_has_child_named(const StringName &p_name, const Node *p_exclude) const {
+	if (data.child_name_index) {
+		Node *const *indexed = data.child_name_index->getptr(p_name);
+		return indexed && *indexed != p_exclude;
+	}
+
+	int cc = data.children.size();
+	const Node *const *cd = data.children.ptr();
+
+	for (int i = 0; i < cc; i++) {
+		if (cd[i] != p_exclude && cd[i]->data.name == p_name) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 Node *Node::_get_child_by_name(const StringName &p_name) const {
+	if (data.child_name_index) {
+		Node *const *indexed = data.child_name_index->getptr(p_name);
+		return indexed ? *indexed : nullptr;
+	}
+
 	int cc = data.children.size();
 	Node *const *cd = data.children.ptr();
 
@@ -1263,6 +1319,18 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 	ERR_FAIL_COND_V_MSG(!data.inside_tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	uint32_t path_hash = p_path.hash();
+	NodePathCacheEntry &cached = node_path_cache[(path_hash ^ (uint32_t)((uintptr_t)this >> 4)) & (NODE_PATH_CACHE_SIZE - 1)];
+
+	if (cached.from == this && cached.path_hash == path_hash) {
+		// The cached result is only known to be alive while nothing was removed below the node the path starts from.
+		int first = 0;
+		const Node *base = _get_path_base(p_path, first);
+		if (base && base->data.path_generation == cached.generation && _resolves_path_to(p_path, first, base, cached.result)) {
+			return cached.result;
+		}
+	}
+
 	Node *current = nullptr;
 	Node *root = nullptr;
 
@@ -1296,16 +1364,8 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 		} else {
-			next = nullptr;
-
-			for (int j = 0; j < current->data.children.size(); j++) {
-				Node *child = current->data.children[j];
+			next = current->_get_child_by_name(name);
 
-				if (child->data.name == name) {
-					next = child;
-					break;
-				}
-			}
 			if (next == nullptr) {
 				return nullptr;
 			};
@@ -1313,9 +1373,64 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		current = next;
 	}
 
+	if (current) {
+		int first = 0;
+		const Node *base = _get_path_base(p_path, first);
+		if (base && _resolves_path_to(p_path, first, base, current)) {
+			cached.from = this;
+			cached.result = current;
+			cached.generation = base->data.path_generation;
+			cached.path_hash = path_hash;
+		}
+	}
+
 	return current;
 }
 
+// Returns the node that following p_path from this node starts from, which is the root for absolute paths, and
+// in r_first the index of the first name below it. Returns nullptr if the path climbs past the root.
+const Node *Node::_get_path_base(const NodePath &p_path, int &r_first) const {
+	int name_count = p_path.get_name_count();
+
+	if (p_path.is_absolute()) {
+		if (!data.tree || name_count == 0) {
+			return nullptr;
+		}
+		const Node *root = data.tree->get_root();
+		if (root->data.name != p_path.get_name(0)) {
+			return nullptr;
+		}
+		r_first = 1;
+		return root;
+	}
+
+	const Node *base = this;
+	const StringName &doubledot = SceneStringNames::get_singleton()->doubledot;
+	r_first = 0;
+	while (r_first < name_count && p_path.get_name(r_first) == doubledot) {
+		base = base->data.parent;
+		if (!base) {
+			return nullptr;
+		}
+		r_first++;
+	}
+	return base;
+}
+
+// Checks that the names of p_path from p_first on lead from p_base to p_node by walking up from p_node, which is
+// cheap enough to validate cached lookups. Paths with "." or ".." past their start are never accepted.
+bool Node::_resolves_path_to(const NodePath &p_path, int p_first, const Node *p_base, const Node *p_node) {
+	const Node *node = p_node;
+	for (int i = p_path.get_name_count() - 1; i >= p_first; i--) {
+		if (!node || node->data.name != p_path.get_name(i)) {
+			return false;
+		}
+		node = node->data.parent;
+	}
+
+	return node == p_base;
+}
+
 Node *Node::get_node(const NodePath &p_path) const {
 	Node *node = get_node_or_null(p_path);
 	if (p_path.is_absolute()) {
@@ -2720,6 +2835,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_child_count"), &Node::get_child_count);
 	ClassDB::bind_method(D_METHOD("get_children"), &Node::_get_children);
 	ClassDB::bind_method(D_METHOD("get_child", "idx"), &Node::get_child);
+	ClassDB::bind_method(D_METHOD("set_child_name_index_enabled", "enabled"), &Node::set_child_name_index_enabled);
+	ClassDB::bind_method(D_METHOD("is_child_name_index_enabled"), &Node::is_child_name_index_enabled);
 	ClassDB::bind_method(D_METHOD("has_node", "path"), &Node::has_node);
 	ClassDB::bind_method(D_METHOD("get_node", "path"), &Node::get_node);
 	ClassDB::bind_method(D_METHOD("get_node_or_null", "path"), &Node::get_node_or_null);
@@ -2947,6 +3064,8 @@ Node::Node() {
 	data.pause_owner = nullptr;
 	data.network_master = 1; //server by default
 	data.path_cache = nullptr;
+	data.path_generation = node_path_generation.increment();
+	data.child_name_index = nullptr;
 	data.parent_owned = false;
 	data.in_constructor = true;
 	data.viewport = nullptr;
@@ -2963,6 +3082,10 @@ Node::~Node() {
 	data.owned.clear();
 	data.children.clear();
 
+	if (data.child_name_index) {
+		memdelete(data.child_name_index);
+	}
+
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children.size());
 
@@ -32,6 +32,7 @@
 #define NODE_H
 
 #include "core/class_db.h"
+#include "core/hash_map.h"
 #include "core/map.h"
 #include "core/node_path.h"
 #include "core/object.h"
@@ -87,6 +88,8 @@ private:
 		GroupData() { persistent = false; }
 	};
 
+	typedef HashMap<StringName, Node *> ChildNameIndex;
+
 	struct Data {
 		String filename;
 		Ref<SceneState> instance_state;
@@ -95,6 +98,7 @@ private:
 		Node *parent;
 		Node *owner;
 		Vector<Node *> children; // list of children
+		ChildNameIndex *child_name_index; // optional, see set_child_name_index_enabled()
 		int pos;
 		int depth;
 		int blocked; // safeguard that throws an error when attempting to modify the tree in a harmful way while being traversed.
@@ -141,6 +145,8 @@ private:
 		bool editable_instance;
 
 		mutable NodePath *path_cache;
+		// Changes whenever a node below this one is removed, see get_node_or_null().
+		uint64_t path_generation;
 
 	} data;
 
@@ -150,6 +156,10 @@ private:
 	void _print_tree(const Node *p_node);
 
 	Node *_get_child_by_name(const StringName &p_name) const;
+	bool _has_child_named(const StringName &p_name, const Node *p_exclude) const;
+	void _child_renamed(Node *p_child, const StringName &p_old_name);
+	const Node *_get_path_base(const NodePath &p_path, int &r_first) const;
+	static bool _resolves_path_to(const NodePath &p_path, int p_first, const Node *p_base, const Node *p_node);
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -259,6 +269,8 @@ public:
 
 	int get_child_count() const;
 	Node *get_child(int p_index) const;
+	void set_child_name_index_enabled(bool p_enabled);
+	bool is_child_name_index_enabled() const;
 	bool has_node(const NodePath &p_path) const;
 	Node *get_node(const NodePath &p_path) const;
 	Node *get_node_or_null(const NodePath &p_path) const;
@@ -40,6 +40,8 @@
 #include "core/project_settings.h"
 #include "main/input_default.h"
 #include "node.h"
+#include "scene/3d/spatial.h"
+#include "scene/3d/visual_instance.h"
 #include "scene/debugger/script_debugger_remote.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
@@ -127,36 +129,60 @@ void SceneTree::node_renamed(Node *p_node) {
 }
 
 SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
-		E = group_map.insert(p_group, Group());
+	Group *g = _get_group(p_group);
+	if (!g) {
+		g = memnew(Group);
+		group_map.set(p_group, g);
 	}
 
-	ERR_FAIL_COND_V_MSG(E->get().nodes.find(p_node) != -1, &E->get(), "Already in group: " + p_group + ".");
-	E->get().nodes.push_back(p_node);
-	//E->get().last_tree_version=0;
-	E->get().changed = true;
-	return &E->get();
+	ERR_FAIL_COND_V_MSG(g->indices.has(p_node->get_instance_id()), g, "Already in group: " + p_group + ".");
+	g->indices.insert(p_node->get_instance_id(), g->nodes.size());
+	g->nodes.push_back(p_node);
+	//g->last_tree_version=0;
+	g->changed = true;
+	return g;
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	ERR_FAIL_COND(!E);
+	Group *g = _get_group(p_group);
+	ERR_FAIL_COND(!g);
+
+	int index;
+	if (g->indices.lookup(p_node->get_instance_id(), index)) {
+		// Move the last node into the gap, the order is restored lazily when needed.
+		int last = g->nodes.size() - 1;
+		if (index != last) {
+			Node *moved = g->nodes[last];
+			g->nodes.set(index, moved);
+			g->indices.set(moved->get_instance_id(), index);
+			g->changed = true;
+		}
+		g->nodes.resize(last);
+		g->indices.remove(p_node->get_instance_id());
+	}
 
-	E->get().nodes.erase(p_node);
-	if (E->get().nodes.empty()) {
-		group_map.erase(E);
+	if (g->nodes.empty()) {
+		group_map.erase(p_group);
+		memdelete(g);
 	}
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (E) {
-		E->get().changed = true;
+	Group *g = _get_group(p_group);
+	if (g) {
+		g->changed = true;
 	}
 }
 
 void SceneTree::flush_transform_notifications() {
+	if (!xform_change_list.first()) {
+		return;
+	}
+
+	// Global transforms are computed in one pass before notifying, so the notifications only read them.
+	Spatial::update_global_transforms(xform_change_list, parallel_transform_update);
+	VisualInstance::begin_transform_batch();
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -165,6 +191,8 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	VisualInstance::end_transform_batch();
 }
 
 void SceneTree::_flush_ugc() {
@@ -204,15 +232,18 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 		SortArray<Node *, Node::Comparator> node_sort;
 		node_sort.sort(nodes, node_count);
 	}
+	for (int i = 0; i < node_count; i++) {
+		g.indices.set(nodes[i]->get_instance_id(), i);
+	}
 	g.changed = false;
 }
 
 void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *gp = _get_group(p_group);
+	if (!gp) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *gp;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -242,7 +273,9 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 		return;
 	}
 
-	_update_group_order(g);
+	if (!(p_call_flags & GROUP_CALL_UNORDERED)) {
+		_update_group_order(g);
+	}
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -292,16 +325,18 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 }
 
 void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *gp = _get_group(p_group);
+	if (!gp) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *gp;
 	if (g.nodes.empty()) {
 		return;
 	}
 
-	_update_group_order(g);
+	if (!(p_call_flags & GROUP_CALL_UNORDERED)) {
+		_update_group_order(g);
+	}
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -343,16 +378,18 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 }
 
 void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *gp = _get_group(p_group);
+	if (!gp) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *gp;
 	if (g.nodes.empty()) {
 		return;
 	}
 
-	_update_group_order(g);
+	if (!(p_call_flags & GROUP_CALL_UNORDERED)) {
+		_update_group_order(g);
+	}
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -906,11 +943,11 @@ bool SceneTree::is_paused() const {
 }
 
 void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p_method, const Ref<InputEvent> &p_input) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *gp = _get_group(p_group);
+	if (!gp) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *gp;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -954,11 +991,11 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 }
 
 void SceneTree::_notify_group_pause(const StringName &p_group, int p_notification) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *gp = _get_group(p_group);
+	if (!gp) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *gp;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -1057,20 +1094,20 @@ int64_t SceneTree::get_event_count() const {
 
 Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
 	Array ret;
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = _get_group(p_group);
+	if (!g) {
 		return ret;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	_update_group_order(*g); //update order just in case
+	int nc = g->nodes.size();
 	if (nc == 0) {
 		return ret;
 	}
 
 	ret.resize(nc);
 
-	Node **ptr = E->get().nodes.ptrw();
+	Node *const *ptr = g->nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		ret[i] = ptr[i];
 	}
@@ -1082,17 +1119,17 @@ bool SceneTree::has_group(const StringName &p_identifier) const {
 	return group_map.has(p_identifier);
 }
 void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_list) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = _get_group(p_group);
+	if (!g) {
 		return;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	_update_group_order(*g); //update order just in case
+	int nc = g->nodes.size();
 	if (nc == 0) {
 		return;
 	}
-	Node **ptr = E->get().nodes.ptrw();
+	Node *const *ptr = g->nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		p_list->push_back(ptr[i]);
 	}
@@ -1930,6 +1967,7 @@ void SceneTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(GROUP_CALL_REVERSE);
 	BIND_ENUM_CONSTANT(GROUP_CALL_REALTIME);
 	BIND_ENUM_CONSTANT(GROUP_CALL_UNIQUE);
+	BIND_ENUM_CONSTANT(GROUP_CALL_UNORDERED);
 
 	BIND_ENUM_CONSTANT(STRETCH_MODE_DISABLED);
 	BIND_ENUM_CONSTANT(STRETCH_MODE_2D);
@@ -2020,6 +2058,7 @@ SceneTree::SceneTree() {
 	debug_navigation_color = GLOBAL_DEF("debug/shapes/navigation/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
 	debug_navigation_disabled_color = GLOBAL_DEF("debug/shapes/navigation/disabled_geometry_color", Color(1.0, 0.7, 0.1, 0.4));
 	collision_debug_contacts = GLOBAL_DEF("debug/shapes/collision/max_contacts_displayed", 10000);
+	parallel_transform_update = GLOBAL_DEF("rendering/threads/parallel_transform_update", false);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/shapes/collision/max_contacts_displayed", PropertyInfo(Variant::INT, "debug/shapes/collision/max_contacts_displayed", PROPERTY_HINT_RANGE, "0,20000,1")); // No negative
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
@@ -2152,6 +2191,11 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+	const StringName *key = nullptr;
+	while ((key = group_map.next(key))) {
+		memdelete(group_map[*key]);
+	}
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
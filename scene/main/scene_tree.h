@@ -31,7 +31,9 @@
 #ifndef SCENE_MAIN_LOOP_H
 #define SCENE_MAIN_LOOP_H
 
+#include "core/hash_map.h"
 #include "core/io/multiplayer_api.h"
+#include "core/oa_hash_map.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
 #include "core/self_list.h"
@@ -97,9 +99,11 @@ public:
 private:
 	struct Group {
 		Vector<Node *> nodes;
+		OAHashMap<ObjectID, int> indices; // position of each node in nodes, for constant time removal
 		//uint64_t last_tree_version;
 		bool changed;
-		Group() { changed = false; };
+		Group() :
+				indices(8) { changed = false; };
 	};
 
 	Viewport *root;
@@ -117,7 +121,7 @@ private:
 	bool pause;
 	int root_lock;
 
-	Map<StringName, Group> group_map;
+	HashMap<StringName, Group *> group_map;
 	bool _quit;
 	bool initialized;
 	bool input_handled;
@@ -161,6 +165,10 @@ private:
 	bool ugc_locked;
 	void _flush_ugc();
 
+	_FORCE_INLINE_ Group *_get_group(const StringName &p_group) const {
+		Group *const *g = group_map.getptr(p_group);
+		return g ? *g : nullptr;
+	}
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
 	void _update_listener();
 
@@ -219,6 +227,7 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	bool parallel_transform_update;
 
 	friend class ScriptDebuggerRemote;
 #ifdef DEBUG_ENABLED
@@ -278,6 +287,7 @@ public:
 		GROUP_CALL_REALTIME = 2,
 		GROUP_CALL_UNIQUE = 4,
 		GROUP_CALL_MULTILEVEL = 8,
+		GROUP_CALL_UNORDERED = 16,
 	};
 
 	_FORCE_INLINE_ Viewport *get_root() const {
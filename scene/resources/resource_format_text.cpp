@@ -363,11 +363,63 @@ Ref<PackedScene> ResourceInteractiveLoaderText::_parse_node_tag(VariantParser::R
 	return packed_scene;
 }
 
+Error ResourceInteractiveLoaderText::_set_ext_resource(int p_index, const String &p_path, const String &p_type, RES p_res) {
+	if (p_res.is_null()) {
+		if (ResourceLoader::get_abort_on_missing_resources()) {
+			error = ERR_FILE_CORRUPT;
+			error_text = "[ext_resource] referenced nonexistent resource at: " + p_path;
+			_printerr();
+			return error;
+		} else {
+			ResourceLoader::notify_dependency_error(local_path, p_path, p_type);
+		}
+	} else {
+#ifdef TOOLS_ENABLED
+		//remember ID for saving
+		p_res->set_id_for_path(local_path, p_index);
+#endif
+	}
+
+	ExtResource er;
+	er.cache = p_res;
+	er.path = p_path;
+	er.type = p_type;
+	ext_resources[p_index] = er;
+
+	return OK;
+}
+
+Error ResourceInteractiveLoaderText::_get_threaded_ext_resources() {
+	while (threaded_ext_resources.size()) {
+		int index = threaded_ext_resources[0];
+		threaded_ext_resources.remove(0);
+
+		String path = ext_resources[index].path;
+		String type = ext_resources[index].type;
+		RES res = ResourceLoader::load_threaded_get(path);
+
+		Error err = _set_ext_resource(index, path, type, res);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	return OK;
+}
+
 Error ResourceInteractiveLoaderText::poll() {
 	if (error != OK) {
 		return error;
 	}
 
+	if (next_tag.name != "ext_resource" && threaded_ext_resources.size()) {
+		// All external resources were requested, now they are needed.
+		error = _get_threaded_ext_resources();
+		if (error != OK) {
+			return error;
+		}
+	}
+
 	if (next_tag.name == "ext_resource") {
 		if (!next_tag.fields.has("path")) {
 			error = ERR_FILE_CORRUPT;
@@ -403,30 +455,20 @@ Error ResourceInteractiveLoaderText::poll() {
 			path = remaps[path];
 		}
 
-		RES res = ResourceLoader::load(path, type);
-
-		if (res.is_null()) {
-			if (ResourceLoader::get_abort_on_missing_resources()) {
-				error = ERR_FILE_CORRUPT;
-				error_text = "[ext_resource] referenced nonexistent resource at: " + path;
-				_printerr();
+		if (ResourceLoader::is_loading_with_sub_threads() && ResourceLoader::load_threaded_request(path, type, true) == OK) {
+			// Load it in parallel with the following ones, it's retrieved once all of them are requested.
+			ExtResource er;
+			er.path = path;
+			er.type = type;
+			ext_resources[index] = er;
+			threaded_ext_resources.push_back(index);
+		} else {
+			RES res = ResourceLoader::load(path, type);
+			if (_set_ext_resource(index, path, type, res) != OK) {
 				return error;
-			} else {
-				ResourceLoader::notify_dependency_error(local_path, path, type);
 			}
-		} else {
-#ifdef TOOLS_ENABLED
-			//remember ID for saving
-			res->set_id_for_path(local_path, index);
-#endif
 		}
 
-		ExtResource er;
-		er.cache = res;
-		er.path = path;
-		er.type = type;
-		ext_resources[index] = er;
-
 		error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
 
 		if (error) {
@@ -634,6 +676,11 @@ ResourceInteractiveLoaderText::ResourceInteractiveLoaderText() {
 }
 
 ResourceInteractiveLoaderText::~ResourceInteractiveLoaderText() {
+	// Release the threaded loads that weren't retrieved because loading stopped early.
+	for (int i = 0; i < threaded_ext_resources.size(); i++) {
+		ResourceLoader::load_threaded_get(ext_resources[threaded_ext_resources[i]].path);
+	}
+
 	memdelete(f);
 }
 
@@ -62,6 +62,7 @@ class ResourceInteractiveLoaderText : public ResourceInteractiveLoader {
 
 	Map<int, ExtResource> ext_resources;
 	Map<int, RES> int_resources;
+	Vector<int> threaded_ext_resources; // Requested with ResourceLoader::load_threaded_request(), not retrieved yet.
 
 	int resources_total;
 	int resource_current;
@@ -80,6 +81,9 @@ class ResourceInteractiveLoaderText : public ResourceInteractiveLoader {
 	Error _parse_sub_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
 	Error _parse_ext_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
 
+	Error _set_ext_resource(int p_index, const String &p_path, const String &p_type, RES p_res);
+	Error _get_threaded_ext_resources();
+
 	// for converter
 	class DummyResource : public Resource {
 	public:
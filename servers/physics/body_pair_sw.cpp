@@ -209,18 +209,17 @@ real_t combine_friction(BodySW *A, BodySW *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
-bool BodyPairSW::setup(real_t p_step) {
+// Returns false if the bodies can't collide, otherwise updates the contacts.
+// Only reads the bodies and writes to the pair, so pairs can be tested concurrently.
+bool BodyPairSW::_narrow_phase() {
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
 		return false;
 	}
 
-	bool report_contacts_only = false;
 	if ((A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) && (B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC)) {
-		if ((A->get_max_contacts_reported() > 0) || (B->get_max_contacts_reported() > 0)) {
-			report_contacts_only = true;
-		} else {
+		if ((A->get_max_contacts_reported() == 0) && (B->get_max_contacts_reported() == 0)) {
 			collided = false;
 			return false;
 		}
@@ -230,6 +229,32 @@ bool BodyPairSW::setup(real_t p_step) {
 
 	validate_contacts();
 
+	Vector3 offset_A = A->get_transform().get_origin();
+	Transform xform_A = Transform(A->get_transform().basis, Vector3()) * A->get_shape_transform(shape_A);
+
+	Transform xform_B = B->get_transform();
+	xform_B.origin -= offset_A;
+	xform_B = xform_B * B->get_shape_transform(shape_B);
+
+	collided = CollisionSolverSW::solve_static(A->get_shape(shape_A), xform_A, B->get_shape(shape_B), xform_B, _contact_added_callback, this, &sep_axis);
+	return true;
+}
+
+void BodyPairSW::narrow_phase(real_t p_step) {
+	narrow_phase_result = _narrow_phase();
+	narrow_phase_done = true;
+}
+
+bool BodyPairSW::setup(real_t p_step) {
+	bool can_collide = narrow_phase_done ? narrow_phase_result : _narrow_phase();
+	narrow_phase_done = false;
+	if (!can_collide) {
+		return false;
+	}
+
+	// Bodies that can't move only get this far when they report contacts.
+	bool report_contacts_only = (A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) && (B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC);
+
 	Vector3 offset_A = A->get_transform().get_origin();
 	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
 	Transform xform_A = xform_Au * A->get_shape_transform(shape_A);
@@ -241,9 +266,6 @@ bool BodyPairSW::setup(real_t p_step) {
 	ShapeSW *shape_A_ptr = A->get_shape(shape_A);
 	ShapeSW *shape_B_ptr = B->get_shape(shape_B);
 
-	bool collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
-	this->collided = collided;
-
 	if (!collided) {
 		//test ccd (currently just a raycast)
 
@@ -472,6 +494,8 @@ BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	narrow_phase_done = false;
+	narrow_phase_result = false;
 }
 
 BodyPairSW::~BodyPairSW() {
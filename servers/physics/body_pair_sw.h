@@ -76,16 +76,21 @@ class BodyPairSW : public ConstraintSW {
 	int contact_count;
 	bool collided;
 
+	bool narrow_phase_done;
+	bool narrow_phase_result;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B);
 
 	void validate_contacts();
 	bool _test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
+	bool _narrow_phase();
 
 	SpaceSW *space;
 
 public:
+	virtual void narrow_phase(real_t p_step);
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
@@ -1288,6 +1288,8 @@ void PhysicsServerSW::set_collision_iterations(int p_iterations) {
 void PhysicsServerSW::init() {
 	iterations = 8; // 8?
 	stepper = memnew(StepSW);
+	stepper->set_solve_islands_in_parallel(GLOBAL_GET("physics/3d/godot_physics/solve_islands_in_parallel"));
+	stepper->set_narrow_phase_in_parallel(GLOBAL_GET("physics/3d/godot_physics/narrow_phase_in_parallel"));
 };
 
 void PhysicsServerSW::step(real_t p_step) {
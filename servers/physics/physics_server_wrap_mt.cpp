@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  physics_server_wrap_mt.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "physics_server_wrap_mt.h"
+
+#include "core/os/os.h"
+
+void PhysicsServerWrapMT::thread_exit() {
+	exit.set();
+}
+
+void PhysicsServerWrapMT::thread_step(real_t p_delta) {
+	physics_server->step(p_delta);
+	step_sem.post();
+}
+
+int PhysicsServerWrapMT::thread_body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 *r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin) {
+	return physics_server->body_test_ray_separation(p_body, p_transform, p_infinite_inertia, *r_recover_motion, r_results, p_result_max, p_margin);
+}
+
+void PhysicsServerWrapMT::_thread_callback(void *_instance) {
+	PhysicsServerWrapMT *psmt = reinterpret_cast<PhysicsServerWrapMT *>(_instance);
+
+	psmt->thread_loop();
+}
+
+void PhysicsServerWrapMT::thread_loop() {
+	server_thread = Thread::get_caller_id();
+
+	physics_server->init();
+
+	exit.clear();
+	step_thread_up.set();
+	while (!exit.is_set()) {
+		// flush commands one by one, until exit is requested
+		command_queue.wait_and_flush_one();
+	}
+
+	command_queue.flush_all(); // flush all
+
+	physics_server->finish();
+}
+
+/* EVENT QUEUING */
+
+void PhysicsServerWrapMT::step(float p_step) {
+	if (create_thread) {
+		step_pending = true;
+		command_queue.push(this, &PhysicsServerWrapMT::thread_step, p_step);
+	} else {
+		command_queue.flush_all(); //flush all pending from other threads
+		physics_server->step(p_step);
+	}
+}
+
+void PhysicsServerWrapMT::flush_queries() {
+	// The step runs on the physics thread while the main thread is idle processing and drawing,
+	// the results can only be reported once it is done.
+	if (create_thread && step_pending) {
+		step_sem.wait();
+		step_pending = false;
+	}
+
+	physics_server->flush_queries();
+}
+
+void PhysicsServerWrapMT::init() {
+	if (create_thread) {
+		thread.start(_thread_callback, this);
+		while (!step_thread_up.is_set()) {
+			OS::get_singleton()->delay_usec(1000);
+		}
+	} else {
+		physics_server->init();
+	}
+}
+
+void PhysicsServerWrapMT::finish() {
+	if (create_thread) {
+		command_queue.push(this, &PhysicsServerWrapMT::thread_exit);
+		thread.wait_to_finish();
+	} else {
+		physics_server->finish();
+	}
+
+	space_free_cached_ids();
+	area_free_cached_ids();
+}
+
+PhysicsServerWrapMT::PhysicsServerWrapMT(PhysicsServer *p_contained, bool p_create_thread) :
+		command_queue(p_create_thread) {
+	physics_server = p_contained;
+	create_thread = p_create_thread;
+	step_pending = false;
+
+	pool_max_size = GLOBAL_GET("memory/limits/multithreaded_server/rid_pool_prealloc");
+
+	if (!p_create_thread) {
+		server_thread = Thread::get_caller_id();
+	} else {
+		server_thread = 0;
+	}
+
+	main_thread = Thread::get_caller_id();
+}
+
+PhysicsServerWrapMT::~PhysicsServerWrapMT() {
+	memdelete(physics_server);
+}
@@ -31,6 +31,7 @@
 #include "space_sw.h"
 
 #include "collision_solver_sw.h"
+#include "core/os/thread_work_pool.h"
 #include "core/project_settings.h"
 #include "physics_server_sw.h"
 
@@ -99,17 +100,13 @@ int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResu
 	return cc;
 }
 
-bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+static bool _intersect_ray_candidates(const Vector3 &p_from, const Vector3 &p_to, CollisionObjectSW *const *p_objects, const int *p_subindices, int p_amount, bool p_test_bounds, PhysicsDirectSpaceState::RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
 	Vector3 begin, end;
 	Vector3 normal;
 	begin = p_from;
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -118,22 +115,26 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	const CollisionObjectSW *res_obj;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		if (p_pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
+		const CollisionObjectSW *col_obj = p_objects[i];
+
+		int shape_idx = p_subindices[i];
+		if (p_test_bounds && !col_obj->get_shape_aabb(shape_idx).intersects_segment(begin, end)) {
+			continue;
+		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -178,6 +179,98 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	return true;
 }
 
+bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, r_result, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_ray);
+}
+
+void PhysicsDirectSpaceStateSW::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	uint32_t first = 0;
+	int amount = ray_batch_objects.size();
+	if (!p_batch->shared_candidates) {
+		first = ray_batch_offsets[p_index];
+		amount = ray_batch_offsets[p_index + 1] - first;
+	}
+	p_batch->hits[p_index] = _intersect_ray_candidates(p_batch->from[p_index], p_batch->to[p_index], ray_batch_objects.ptr() + first, ray_batch_subindices.ptr() + first, amount, p_batch->shared_candidates, p_batch->results[p_index], *p_batch->exclude, p_batch->collision_mask, p_batch->collide_with_bodies, p_batch->collide_with_areas, p_batch->pick_ray);
+}
+
+int PhysicsDirectSpaceStateSW::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	ERR_FAIL_COND_V(p_ray_count < 0, 0);
+
+	if (p_ray_count == 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+
+	// Rays cast together are usually close to each other, so cull their common bounds once and let every ray
+	// test the candidates against its own segment. The broadphase can only be culled from one thread at a time.
+	AABB bounds(p_from[0], Vector3());
+	for (int i = 0; i < p_ray_count; i++) {
+		bounds.expand_to(p_from[i]);
+		bounds.expand_to(p_to[i]);
+	}
+
+	ray_batch_objects.resize(RAY_BATCH_SHARED_CANDIDATES_MAX + 1);
+	ray_batch_subindices.resize(RAY_BATCH_SHARED_CANDIDATES_MAX + 1);
+	int amount = space->broadphase->cull_aabb(bounds, ray_batch_objects.ptr(), RAY_BATCH_SHARED_CANDIDATES_MAX + 1, ray_batch_subindices.ptr());
+
+	if (amount <= RAY_BATCH_SHARED_CANDIDATES_MAX) {
+		batch.shared_candidates = true;
+		ray_batch_objects.resize(amount);
+		ray_batch_subindices.resize(amount);
+	} else {
+		// The rays are spread out, testing all the candidates for each would cost more than culling per ray.
+		ray_batch_offsets.resize(p_ray_count + 1);
+		ray_batch_objects.clear();
+		ray_batch_subindices.clear();
+
+		for (int i = 0; i < p_ray_count; i++) {
+			ray_batch_offsets[i] = ray_batch_objects.size();
+
+			amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+			for (int j = 0; j < amount; j++) {
+				ray_batch_objects.push_back(space->intersection_query_results[j]);
+				ray_batch_subindices.push_back(space->intersection_query_subindex_results[j]);
+			}
+		}
+		ray_batch_offsets[p_ray_count] = ray_batch_objects.size();
+	}
+
+	// The shape tests only read the space, so they can run on the worker threads.
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+	batch.pick_ray = p_pick_ray;
+
+	ThreadWorkPool *work_pool = ThreadWorkPool::get_singleton();
+	if (work_pool) {
+		work_pool->do_work(p_ray_count, this, &PhysicsDirectSpaceStateSW::_intersect_ray_batch_task, &batch, 16);
+	} else {
+		for (int i = 0; i < p_ray_count; i++) {
+			_intersect_ray_batch_task(i, &batch);
+		}
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
 int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -32,6 +32,7 @@
 #include "joints_sw.h"
 
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 
 void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -103,6 +104,14 @@ void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, real_t p_de
 	}
 }
 
+void StepSW::_solve_island_task(uint32_t p_island_index, void *p_userdata) {
+	_solve_island(constraint_islands[p_island_index], iterations, delta);
+}
+
+void StepSW::_narrow_phase_task(uint32_t p_constraint_index, void *p_userdata) {
+	constraints[p_constraint_index]->narrow_phase(delta);
+}
+
 void StepSW::_check_suspend(BodySW *p_island, real_t p_delta) {
 	bool can_sleep = true;
 
@@ -225,6 +234,25 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	ThreadWorkPool *work_pool = ThreadWorkPool::get_singleton();
+	if (narrow_phase_in_parallel && work_pool) {
+		// BodyPairSW::narrow_phase() only reads the bodies, so all pairs are tested on the worker threads.
+		// _setup_island() below still applies impulses and reports contacts on this thread, in island order.
+		constraints.clear();
+		ConstraintSW *island = constraint_island_list;
+		while (island) {
+			ConstraintSW *ci = island;
+			while (ci) {
+				constraints.push_back(ci);
+				ci = ci->get_island_next();
+			}
+			island = island->get_island_list_next();
+		}
+
+		delta = p_delta;
+		work_pool->do_work(constraints.size(), this, &StepSW::_narrow_phase_task, (void *)nullptr, 8);
+	}
+
 	{
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
@@ -241,7 +269,20 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	if (solve_islands_in_parallel && work_pool) {
+		// A dynamic body belongs to a single island. The static and kinematic bodies islands have in common
+		// ignore impulses (see BodySW::apply_impulse()), so each island can be solved on its own thread.
+		constraint_islands.clear();
+		ConstraintSW *ci = constraint_island_list;
+		while (ci) {
+			constraint_islands.push_back(ci);
+			ci = ci->get_island_list_next();
+		}
+
+		iterations = p_iterations;
+		delta = p_delta;
+		work_pool->do_work(constraint_islands.size(), this, &StepSW::_solve_island_task, (void *)nullptr);
+	} else {
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
@@ -33,15 +33,32 @@
 
 #include "space_sw.h"
 
+#include "core/local_vector.h"
+
 class StepSW {
 	uint64_t _step;
 
+	int iterations = 0;
+	real_t delta = 0.0;
+
+	bool solve_islands_in_parallel = false;
+	bool narrow_phase_in_parallel = false;
+	LocalVector<ConstraintSW *> constraint_islands;
+	LocalVector<ConstraintSW *> constraints;
+
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
 	void _setup_island(ConstraintSW *p_island, real_t p_delta);
 	void _solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta);
+	void _solve_island_task(uint32_t p_island_index, void *p_userdata);
+	void _narrow_phase_task(uint32_t p_constraint_index, void *p_userdata);
 	void _check_suspend(BodySW *p_island, real_t p_delta);
 
 public:
+	void set_solve_islands_in_parallel(bool p_enable) { solve_islands_in_parallel = p_enable; }
+	bool is_solving_islands_in_parallel() const { return solve_islands_in_parallel; }
+	void set_narrow_phase_in_parallel(bool p_enable) { narrow_phase_in_parallel = p_enable; }
+	bool is_narrow_phase_in_parallel() const { return narrow_phase_in_parallel; }
+
 	void step(SpaceSW *p_space, real_t p_delta, int p_iterations);
 	StepSW();
 };
@@ -219,18 +219,17 @@ real_t combine_friction(Body2DSW *A, Body2DSW *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
-bool BodyPair2DSW::setup(real_t p_step) {
+// Returns false if the bodies can't collide, otherwise updates the contacts.
+// Only reads the bodies and writes to the pair, so pairs can be tested concurrently.
+bool BodyPair2DSW::_narrow_phase() {
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
 		return false;
 	}
 
-	bool report_contacts_only = false;
 	if ((A->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC) && (B->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC)) {
-		if ((A->get_max_contacts_reported() > 0) || (B->get_max_contacts_reported() > 0)) {
-			report_contacts_only = true;
-		} else {
+		if ((A->get_max_contacts_reported() == 0) && (B->get_max_contacts_reported() == 0)) {
 			collided = false;
 			return false;
 		}
@@ -241,16 +240,11 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
 	_validate_contacts();
 
-	Vector2 offset_A = A->get_transform().get_origin();
-	Transform2D xform_Au = A->get_transform().untranslated();
-	Transform2D xform_A = xform_Au * A->get_shape_transform(shape_A);
-
-	Transform2D xform_Bu = B->get_transform();
-	xform_Bu.elements[2] -= A->get_transform().get_origin();
-	Transform2D xform_B = xform_Bu * B->get_shape_transform(shape_B);
+	Transform2D xform_A = A->get_transform().untranslated() * A->get_shape_transform(shape_A);
 
-	Shape2DSW *shape_A_ptr = A->get_shape(shape_A);
-	Shape2DSW *shape_B_ptr = B->get_shape(shape_B);
+	Transform2D xform_B = B->get_transform();
+	xform_B.elements[2] -= A->get_transform().get_origin();
+	xform_B = xform_B * B->get_shape_transform(shape_B);
 
 	Vector2 motion_A, motion_B;
 
@@ -261,9 +255,38 @@ bool BodyPair2DSW::setup(real_t p_step) {
 		motion_B = B->get_motion();
 	}
 
-	bool prev_collided = collided;
+	prev_collided = collided;
+
+	collided = CollisionSolver2DSW::solve(A->get_shape(shape_A), xform_A, motion_A, B->get_shape(shape_B), xform_B, motion_B, _add_contact, this, &sep_axis);
+	return true;
+}
+
+void BodyPair2DSW::narrow_phase(real_t p_step) {
+	narrow_phase_result = _narrow_phase();
+	narrow_phase_done = true;
+}
+
+bool BodyPair2DSW::setup(real_t p_step) {
+	bool can_collide = narrow_phase_done ? narrow_phase_result : _narrow_phase();
+	narrow_phase_done = false;
+	if (!can_collide) {
+		return false;
+	}
+
+	// Bodies that can't move only get this far when they report contacts.
+	bool report_contacts_only = (A->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC) && (B->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC);
+
+	Vector2 offset_A = A->get_transform().get_origin();
+	Transform2D xform_Au = A->get_transform().untranslated();
+	Transform2D xform_A = xform_Au * A->get_shape_transform(shape_A);
+
+	Transform2D xform_Bu = B->get_transform();
+	xform_Bu.elements[2] -= A->get_transform().get_origin();
+	Transform2D xform_B = xform_Bu * B->get_shape_transform(shape_B);
+
+	Shape2DSW *shape_A_ptr = A->get_shape(shape_A);
+	Shape2DSW *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
 	if (!collided) {
 		//test ccd (currently just a raycast)
 
@@ -501,7 +524,10 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	prev_collided = false;
 	oneway_disabled = false;
+	narrow_phase_done = false;
+	narrow_phase_result = false;
 }
 
 BodyPair2DSW::~BodyPair2DSW() {
@@ -1204,6 +1204,8 @@ void Physics2DServerSW::init() {
 	doing_sync = false;
 	iterations = 8; // 8?
 	stepper = memnew(Step2DSW);
+	stepper->set_solve_islands_in_parallel(GLOBAL_GET("physics/2d/solve_islands_in_parallel"));
+	stepper->set_narrow_phase_in_parallel(GLOBAL_GET("physics/2d/narrow_phase_in_parallel"));
 };
 
 void Physics2DServerSW::step(real_t p_step) {
@@ -1319,6 +1321,8 @@ Physics2DServerSW::Physics2DServerSW() {
 	GLOBAL_DEF("physics/2d/large_object_surface_threshold_in_cells", 512);
 	GLOBAL_DEF("physics/2d/bvh_collision_margin", 1.0);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/bvh_collision_margin", PropertyInfo(Variant::REAL, "physics/2d/bvh_collision_margin", PROPERTY_HINT_RANGE, "0.0,20.0,0.1"));
+	GLOBAL_DEF("physics/2d/solve_islands_in_parallel", false);
+	GLOBAL_DEF("physics/2d/narrow_phase_in_parallel", false);
 
 	bool use_bvh = GLOBAL_GET("physics/2d/use_bvh");
 
@@ -32,6 +32,7 @@
 
 #include "collision_solver_2d_sw.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/pair.h"
 #include "physics_2d_server_sw.h"
 
@@ -121,17 +122,13 @@ int Physics2DDirectSpaceStateSW::intersect_point_on_canvas(const Vector2 &p_poin
 	return _intersect_point_impl(p_point, r_results, p_result_max, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_point, true, p_canvas_instance_id);
 }
 
-bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+static bool _intersect_ray_candidates(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW *const *p_objects, const int *p_subindices, int p_amount, bool p_test_bounds, Physics2DDirectSpaceState::RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	Vector2 begin, end;
 	Vector2 normal;
 	begin = p_from;
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -140,18 +137,22 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 	const CollisionObject2DSW *res_obj;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
+		const CollisionObject2DSW *col_obj = p_objects[i];
+
+		int shape_idx = p_subindices[i];
+		if (p_test_bounds && !col_obj->get_shape_aabb(shape_idx).intersects_segment(begin, end)) {
+			continue;
+		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -201,6 +202,96 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 	return true;
 }
 
+bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, r_result, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+}
+
+void Physics2DDirectSpaceStateSW::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	uint32_t first = 0;
+	int amount = ray_batch_objects.size();
+	if (!p_batch->shared_candidates) {
+		first = ray_batch_offsets[p_index];
+		amount = ray_batch_offsets[p_index + 1] - first;
+	}
+	p_batch->hits[p_index] = _intersect_ray_candidates(p_batch->from[p_index], p_batch->to[p_index], ray_batch_objects.ptr() + first, ray_batch_subindices.ptr() + first, amount, p_batch->shared_candidates, p_batch->results[p_index], *p_batch->exclude, p_batch->collision_mask, p_batch->collide_with_bodies, p_batch->collide_with_areas);
+}
+
+int Physics2DDirectSpaceStateSW::intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	ERR_FAIL_COND_V(p_ray_count < 0, 0);
+
+	if (p_ray_count == 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+
+	// One broadphase query for the rectangle enclosing every ray, each ray then skips the candidates whose
+	// bounds its segment misses. This has to happen on this thread, the broadphase isn't safe to cull concurrently.
+	Rect2 bounds(p_from[0], Vector2());
+	for (int i = 0; i < p_ray_count; i++) {
+		bounds.expand_to(p_from[i]);
+		bounds.expand_to(p_to[i]);
+	}
+
+	ray_batch_objects.resize(RAY_BATCH_SHARED_CANDIDATES_MAX + 1);
+	ray_batch_subindices.resize(RAY_BATCH_SHARED_CANDIDATES_MAX + 1);
+	int amount = space->broadphase->cull_aabb(bounds, ray_batch_objects.ptr(), RAY_BATCH_SHARED_CANDIDATES_MAX + 1, ray_batch_subindices.ptr());
+
+	if (amount <= RAY_BATCH_SHARED_CANDIDATES_MAX) {
+		batch.shared_candidates = true;
+		ray_batch_objects.resize(amount);
+		ray_batch_subindices.resize(amount);
+	} else {
+		// Too many objects between the rays, go back to a segment query per ray.
+		ray_batch_offsets.resize(p_ray_count + 1);
+		ray_batch_objects.clear();
+		ray_batch_subindices.clear();
+
+		for (int i = 0; i < p_ray_count; i++) {
+			ray_batch_offsets[i] = ray_batch_objects.size();
+
+			amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+			for (int j = 0; j < amount; j++) {
+				ray_batch_objects.push_back(space->intersection_query_results[j]);
+				ray_batch_subindices.push_back(space->intersection_query_subindex_results[j]);
+			}
+		}
+		ray_batch_offsets[p_ray_count] = ray_batch_objects.size();
+	}
+
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+
+	ThreadWorkPool *work_pool = ThreadWorkPool::get_singleton();
+	if (work_pool) {
+		work_pool->do_work(p_ray_count, this, &Physics2DDirectSpaceStateSW::_intersect_ray_batch_task, &batch, 16);
+	} else {
+		for (int i = 0; i < p_ray_count; i++) {
+			_intersect_ray_batch_task(i, &batch);
+		}
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
 int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (p_result_max <= 0) {
 		return 0;
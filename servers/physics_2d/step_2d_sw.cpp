@@ -30,6 +30,7 @@
 
 #include "step_2d_sw.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -92,6 +93,14 @@ void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, real_t
 	}
 }
 
+void Step2DSW::_solve_island_task(uint32_t p_island_index, void *p_userdata) {
+	_solve_island(constraint_islands[p_island_index], iterations, delta);
+}
+
+void Step2DSW::_narrow_phase_task(uint32_t p_constraint_index, void *p_userdata) {
+	constraints[p_constraint_index]->narrow_phase(delta);
+}
+
 void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 	bool can_sleep = true;
 
@@ -214,6 +223,25 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	ThreadWorkPool *work_pool = ThreadWorkPool::get_singleton();
+	if (narrow_phase_in_parallel && work_pool) {
+		// Collide every pair on the worker pool. The loop below then sets up the constraints from the cached
+		// results, keeping CCD, warm starting and contact reports on this thread and in the serial order.
+		constraints.clear();
+		Constraint2DSW *island = constraint_island_list;
+		while (island) {
+			Constraint2DSW *ci = island;
+			while (ci) {
+				constraints.push_back(ci);
+				ci = ci->get_island_next();
+			}
+			island = island->get_island_list_next();
+		}
+
+		delta = p_delta;
+		work_pool->do_work(constraints.size(), this, &Step2DSW::_narrow_phase_task, (void *)nullptr, 8);
+	}
+
 	{
 		Constraint2DSW *ci = constraint_island_list;
 		Constraint2DSW *prev_ci = nullptr;
@@ -257,7 +285,20 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	if (solve_islands_in_parallel && work_pool) {
+		// One thread solves each island, in the same order as below. Islands can only meet at static or kinematic
+		// bodies, which Body2DSW leaves untouched when impulses are applied.
+		constraint_islands.clear();
+		Constraint2DSW *ci = constraint_island_list;
+		while (ci) {
+			constraint_islands.push_back(ci);
+			ci = ci->get_island_list_next();
+		}
+
+		iterations = p_iterations;
+		delta = p_delta;
+		work_pool->do_work(constraint_islands.size(), this, &Step2DSW::_solve_island_task, (void *)nullptr);
+	} else {
 		Constraint2DSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
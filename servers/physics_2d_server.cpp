@@ -278,6 +278,76 @@ Dictionary Physics2DDirectSpaceState::_intersect_ray(const Vector2 &p_from, cons
 	return d;
 }
 
+Dictionary Physics2DDirectSpaceState::_intersect_ray_batch(const PoolVector2Array &p_from, const PoolVector2Array &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++) {
+		exclude.insert(p_exclude[i]);
+	}
+
+	int ray_count = p_from.size();
+	Vector<RayResult> results;
+	Vector<bool> hits;
+	results.resize(ray_count);
+	hits.resize(ray_count);
+
+	{
+		PoolVector2Array::Read from = p_from.read();
+		PoolVector2Array::Read to = p_to.read();
+		intersect_rays(from.ptr(), to.ptr(), ray_count, results.ptrw(), hits.ptrw(), exclude, p_layers, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	PoolVector2Array positions;
+	PoolVector2Array normals;
+	PoolIntArray shapes;
+	Array colliders;
+	Array collider_ids;
+	Array rids;
+	Array metadata;
+	positions.resize(ray_count);
+	normals.resize(ray_count);
+	shapes.resize(ray_count);
+	colliders.resize(ray_count);
+	collider_ids.resize(ray_count);
+	rids.resize(ray_count);
+	metadata.resize(ray_count);
+
+	{
+		PoolVector2Array::Write position_w = positions.write();
+		PoolVector2Array::Write normal_w = normals.write();
+		PoolIntArray::Write shape_w = shapes.write();
+		const RayResult *r = results.ptr();
+		for (int i = 0; i < ray_count; i++) {
+			if (!hits[i]) {
+				position_w[i] = Vector2();
+				normal_w[i] = Vector2();
+				shape_w[i] = -1;
+				collider_ids[i] = 0;
+				continue;
+			}
+			position_w[i] = r[i].position;
+			normal_w[i] = r[i].normal;
+			shape_w[i] = r[i].shape;
+			colliders[i] = r[i].collider;
+			collider_ids[i] = r[i].collider_id;
+			rids[i] = r[i].rid;
+			metadata[i] = r[i].metadata;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["collider"] = colliders;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+	d["metadata"] = metadata;
+
+	return d;
+}
+
 Array Physics2DDirectSpaceState::_intersect_shape(const Ref<Physics2DShapeQueryParameters> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
 
@@ -398,10 +468,22 @@ Dictionary Physics2DDirectSpaceState::_get_rest_info(const Ref<Physics2DShapeQue
 Physics2DDirectSpaceState::Physics2DDirectSpaceState() {
 }
 
+int Physics2DDirectSpaceState::intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		r_hits[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 void Physics2DDirectSpaceState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "point", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_point_on_canvas", "point", "canvas_instance_id", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point_on_canvas, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_ray_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape"), &Physics2DDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -273,6 +273,72 @@ Dictionary PhysicsDirectSpaceState::_intersect_ray(const Vector3 &p_from, const
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState::_intersect_ray_batch(const PoolVector3Array &p_from, const PoolVector3Array &p_to, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++) {
+		exclude.insert(p_exclude[i]);
+	}
+
+	int ray_count = p_from.size();
+	Vector<RayResult> results;
+	Vector<bool> hits;
+	results.resize(ray_count);
+	hits.resize(ray_count);
+
+	{
+		PoolVector3Array::Read from = p_from.read();
+		PoolVector3Array::Read to = p_to.read();
+		intersect_rays(from.ptr(), to.ptr(), ray_count, results.ptrw(), hits.ptrw(), exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	PoolVector3Array positions;
+	PoolVector3Array normals;
+	PoolIntArray shapes;
+	Array colliders;
+	Array collider_ids;
+	Array rids;
+	positions.resize(ray_count);
+	normals.resize(ray_count);
+	shapes.resize(ray_count);
+	colliders.resize(ray_count);
+	collider_ids.resize(ray_count);
+	rids.resize(ray_count);
+
+	{
+		PoolVector3Array::Write position_w = positions.write();
+		PoolVector3Array::Write normal_w = normals.write();
+		PoolIntArray::Write shape_w = shapes.write();
+		const RayResult *r = results.ptr();
+		for (int i = 0; i < ray_count; i++) {
+			if (!hits[i]) {
+				position_w[i] = Vector3();
+				normal_w[i] = Vector3();
+				shape_w[i] = -1;
+				collider_ids[i] = 0;
+				continue;
+			}
+			position_w[i] = r[i].position;
+			normal_w[i] = r[i].normal;
+			shape_w[i] = r[i].shape;
+			colliders[i] = r[i].collider;
+			collider_ids[i] = r[i].collider_id;
+			rids[i] = r[i].rid;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["collider"] = colliders;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
 Array PhysicsDirectSpaceState::_intersect_point(const Vector3 &p_point, int p_max_results, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	Set<RID> exclude;
 	for (int i = 0; i < p_exclude.size(); i++) {
@@ -376,9 +442,21 @@ Dictionary PhysicsDirectSpaceState::_get_rest_info(const Ref<PhysicsShapeQueryPa
 PhysicsDirectSpaceState::PhysicsDirectSpaceState() {
 }
 
+int PhysicsDirectSpaceState::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		r_hits[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_ray);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 void PhysicsDirectSpaceState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "point", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_point, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_ray_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape", "motion"), &PhysicsDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -800,7 +878,7 @@ void PhysicsServer::_bind_methods() {
 }
 
 PhysicsServer::PhysicsServer() {
-	ERR_FAIL_COND(singleton != nullptr);
+	// A multithreaded wrapper is created after the server it wraps, and takes over.
 	singleton = this;
 }
 
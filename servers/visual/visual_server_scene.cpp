@@ -31,6 +31,7 @@
 #include "visual_server_scene.h"
 
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 
@@ -680,7 +681,22 @@ void VisualServerScene::instance_set_transform(RID p_instance, const Transform &
 	Instance *instance = instance_owner.get(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->transform == p_transform) {
+	_instance_set_transform(instance, p_transform);
+}
+void VisualServerScene::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_transform(instance, transforms[i]);
+	}
+}
+void VisualServerScene::_instance_set_transform(Instance *p_instance, const Transform &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -697,8 +713,8 @@ void VisualServerScene::instance_set_transform(RID p_instance, const Transform &
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
 }
 void VisualServerScene::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.get(p_instance);
@@ -1934,6 +1950,209 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	p_instance->lightmap_capture_data.write[0].a = interior ? 0.0f : 1.0f;
 }
 
+template <class U>
+void VisualServerScene::_cull_work(uint32_t p_elements, void (VisualServerScene::*p_method)(uint32_t, U), U p_userdata) {
+	ThreadWorkPool *work_pool = ThreadWorkPool::get_singleton();
+	if (_parallel_culling && work_pool) {
+		work_pool->do_work(p_elements, this, p_method, p_userdata, CULL_WORK_GRAIN);
+	} else {
+		for (uint32_t i = 0; i < p_elements; i++) {
+			(this->*p_method)(i, p_userdata);
+		}
+	}
+}
+
+void VisualServerScene::_update_instance_geometry_pairs(Instance *p_instance) {
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+
+	if (geom->lighting_dirty) {
+		int l = 0;
+		//only called when lights AABB enter/exit this geometry
+		p_instance->light_instances.resize(geom->lighting.size());
+
+		for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
+			InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+
+			p_instance->light_instances.write[l++] = light->instance;
+		}
+
+		geom->lighting_dirty = false;
+	}
+
+	if (geom->reflection_dirty) {
+		int l = 0;
+		//only called when reflection probe AABB enter/exit this geometry
+		p_instance->reflection_probe_instances.resize(geom->reflection_probes.size());
+
+		for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
+			InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
+
+			p_instance->reflection_probe_instances.write[l++] = reflection_probe->instance;
+		}
+
+		geom->reflection_dirty = false;
+	}
+
+	if (geom->gi_probes_dirty) {
+		int l = 0;
+		//only called when reflection probe AABB enter/exit this geometry
+		p_instance->gi_probe_instances.resize(geom->gi_probes.size());
+
+		for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
+			InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
+
+			p_instance->gi_probe_instances.write[l++] = gi_probe->probe_instance;
+		}
+
+		geom->gi_probes_dirty = false;
+	}
+}
+
+void VisualServerScene::_cull_instance(uint32_t p_index, const InstanceCullParams *p_params) {
+	Instance *ins = instance_cull_result[p_index];
+	uint8_t flags = 0;
+
+	if ((p_params->camera_layer_mask & ins->layer_mask) == 0) {
+		//failure
+	} else if (!ins->visible) {
+		//hidden
+	} else if (ins->base_type == VS::INSTANCE_LIGHT || ins->base_type == VS::INSTANCE_REFLECTION_PROBE || ins->base_type == VS::INSTANCE_GI_PROBE) {
+		flags = CULL_FLAG_PROCESS_SERIALLY;
+	} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		flags = CULL_FLAG_KEEP;
+		if (ins->redraw_if_visible || ins->base_type == VS::INSTANCE_PARTICLES) {
+			flags |= CULL_FLAG_PROCESS_SERIALLY;
+		}
+
+		_update_instance_geometry_pairs(ins);
+	}
+
+	instance_cull_flags[p_index] = flags;
+}
+
+bool VisualServerScene::_prepare_scene_instance(Instance *p_instance, RID p_shadow_atlas, RID p_reflection_probe) {
+	Instance *ins = p_instance;
+
+	if (ins->base_type == VS::INSTANCE_LIGHT) {
+		if (light_cull_count < MAX_LIGHTS_CULLED) {
+			InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+
+			if (!light->geometries.empty()) {
+				//do not add this light if no geometry is affected by it..
+				light_cull_result[light_cull_count] = ins;
+				light_instance_cull_result[light_cull_count] = light->instance;
+				if (p_shadow_atlas.is_valid() && VSG::storage->light_has_shadow(ins->base)) {
+					VSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
+				}
+
+				light_cull_count++;
+			}
+		}
+		return false;
+	}
+
+	if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE) {
+		if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
+			InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
+
+			if (p_reflection_probe != reflection_probe->instance) {
+				//avoid entering The Matrix
+
+				if (!reflection_probe->geometries.empty()) {
+					//do not add this light if no geometry is affected by it..
+
+					if (reflection_probe->reflection_dirty || VSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
+						if (!reflection_probe->update_list.in_list()) {
+							reflection_probe->render_step = 0;
+							reflection_probe_render_list.add_last(&reflection_probe->update_list);
+						}
+
+						reflection_probe->reflection_dirty = false;
+					}
+
+					if (VSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
+						reflection_probe_instance_cull_result[reflection_probe_cull_count] = reflection_probe->instance;
+						reflection_probe_cull_count++;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	if (ins->base_type == VS::INSTANCE_GI_PROBE) {
+		InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
+		if (!gi_probe->update_element.in_list()) {
+			gi_probe_update_list.add(&gi_probe->update_element);
+		}
+		return false;
+	}
+
+	// Geometry, the pairs were already updated by _cull_instance().
+
+	if (ins->redraw_if_visible) {
+		VisualServerRaster::redraw_request();
+	}
+
+	if (ins->base_type == VS::INSTANCE_PARTICLES) {
+		//particles visible? process them
+		if (VSG::storage->particles_is_inactive(ins->base)) {
+			//but if nothing is going on, don't do it.
+			return false;
+		}
+
+		VSG::storage->particles_request_process(ins->base);
+		//particles visible? request redraw
+		VisualServerRaster::redraw_request();
+	}
+
+	return true;
+}
+
+void VisualServerScene::_cull_instance_depth(uint32_t p_index, const InstanceCullParams *p_params) {
+	// Only visible geometry is left in the cull result at this point.
+	Instance *ins = instance_cull_result[p_index];
+
+	Vector3 aabb_center = ins->transformed_aabb.position + (ins->transformed_aabb.size * 0.5);
+	ins->depth = p_params->near_plane.distance_to(aabb_center);
+	ins->depth_layer = CLAMP(int(ins->depth * 16 / p_params->z_far), 0, 15);
+}
+
+void VisualServerScene::_cull_shadow_caster(uint32_t p_index, const Plane *p_near_plane) {
+	Instance *instance = instance_shadow_cull_result[p_index];
+	uint8_t flags = 0;
+
+	if (instance->visible && ((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) && static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+		flags = CULL_FLAG_KEEP;
+		if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+			flags |= CULL_FLAG_ANIMATED_MATERIAL;
+		}
+
+		instance->depth = p_near_plane->distance_to(instance->transform.origin);
+		instance->depth_layer = 0;
+	}
+
+	instance_shadow_cull_flags[p_index] = flags;
+}
+
+int VisualServerScene::_cull_shadow_casters(int p_cull_count, const Plane &p_near_plane, bool &r_animated_material_found) {
+	instance_shadow_cull_flags.resize(p_cull_count);
+	_cull_work(p_cull_count, &VisualServerScene::_cull_shadow_caster, &p_near_plane);
+
+	int keep_count = 0;
+	for (int i = 0; i < p_cull_count; i++) {
+		uint8_t flags = instance_shadow_cull_flags[i];
+		if (flags & CULL_FLAG_KEEP) {
+			instance_shadow_cull_result[keep_count++] = instance_shadow_cull_result[i];
+			if (flags & CULL_FLAG_ANIMATED_MATERIAL) {
+				r_animated_material_found = true;
+			}
+		}
+	}
+
+	return keep_count;
+}
+
 bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
@@ -2167,19 +2386,12 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 				Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 
+				bool cascade_animated_material_found = false; // Not tracked for directional shadows.
+				cull_count = _cull_shadow_casters(cull_count, near_plane, cascade_animated_material_found);
+
 				for (int j = 0; j < cull_count; j++) {
 					float min, max;
-					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-						j--;
-						continue;
-					}
-
-					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
+					instance_shadow_cull_result[j]->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
 					if (max > z_max) {
 						z_max = max;
 					}
@@ -2225,21 +2437,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					int cull_count = p_scenario->sps->cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
-					for (int j = 0; j < cull_count; j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					cull_count = _cull_shadow_casters(cull_count, near_plane, animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -2277,20 +2475,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					int cull_count = _cull_convex_from_point(p_scenario, light_transform.origin, planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, light->previous_room_id_hint, VS::INSTANCE_GEOMETRY_MASK);
 
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-					for (int j = 0; j < cull_count; j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					cull_count = _cull_shadow_casters(cull_count, near_plane, animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -2312,20 +2497,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			int cull_count = _cull_convex_from_point(p_scenario, light_transform.origin, planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, light->previous_room_id_hint, VS::INSTANCE_GEOMETRY_MASK);
 
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-			for (int j = 0; j < cull_count; j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-					j--;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-				}
-			}
+			cull_count = _cull_shadow_casters(cull_count, near_plane, animated_material_found);
 
 			VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
 			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -2507,135 +2679,34 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
-	for (int i = 0; i < instance_cull_count; i++) {
-		Instance *ins = instance_cull_result[i];
-
-		bool keep = false;
-
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
-			//failure
-		} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
-			if (light_cull_count < MAX_LIGHTS_CULLED) {
-				InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
-
-				if (!light->geometries.empty()) {
-					//do not add this light if no geometry is affected by it..
-					light_cull_result[light_cull_count] = ins;
-					light_instance_cull_result[light_cull_count] = light->instance;
-					if (p_shadow_atlas.is_valid() && VSG::storage->light_has_shadow(ins->base)) {
-						VSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
-					}
-
-					light_cull_count++;
-				}
-			}
-		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE && ins->visible) {
-			if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
-				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
-
-				if (p_reflection_probe != reflection_probe->instance) {
-					//avoid entering The Matrix
-
-					if (!reflection_probe->geometries.empty()) {
-						//do not add this light if no geometry is affected by it..
-
-						if (reflection_probe->reflection_dirty || VSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
-							if (!reflection_probe->update_list.in_list()) {
-								reflection_probe->render_step = 0;
-								reflection_probe_render_list.add_last(&reflection_probe->update_list);
-							}
-
-							reflection_probe->reflection_dirty = false;
-						}
-
-						if (VSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
-							reflection_probe_instance_cull_result[reflection_probe_cull_count] = reflection_probe->instance;
-							reflection_probe_cull_count++;
-						}
-					}
-				}
-			}
-
-		} else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
-			InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
-			if (!gi_probe->update_element.in_list()) {
-				gi_probe_update_list.add(&gi_probe->update_element);
-			}
-
-		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
-			keep = true;
-
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
-
-			if (ins->redraw_if_visible) {
-				VisualServerRaster::redraw_request();
-			}
-
-			if (ins->base_type == VS::INSTANCE_PARTICLES) {
-				//particles visible? process them
-				if (VSG::storage->particles_is_inactive(ins->base)) {
-					//but if nothing is going on, don't do it.
-					keep = false;
-				} else {
-					VSG::storage->particles_request_process(ins->base);
-					//particles visible? request redraw
-					VisualServerRaster::redraw_request();
-				}
-			}
-
-			if (geom->lighting_dirty) {
-				int l = 0;
-				//only called when lights AABB enter/exit this geometry
-				ins->light_instances.resize(geom->lighting.size());
-
-				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-
-					ins->light_instances.write[l++] = light->instance;
-				}
-
-				geom->lighting_dirty = false;
-			}
-
-			if (geom->reflection_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->reflection_probe_instances.resize(geom->reflection_probes.size());
-
-				for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
-					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
-
-					ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
-				}
-
-				geom->reflection_dirty = false;
-			}
+	InstanceCullParams cull_params;
+	cull_params.camera_layer_mask = camera_layer_mask;
+	cull_params.near_plane = near_plane;
+	cull_params.z_far = z_far;
 
-			if (geom->gi_probes_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->gi_probe_instances.resize(geom->gi_probes.size());
+	// Geometry is processed in parallel, anything that touches shared state is flagged to be processed below.
+	instance_cull_flags.resize(instance_cull_count);
+	_cull_work(instance_cull_count, &VisualServerScene::_cull_instance, (const InstanceCullParams *)&cull_params);
 
-				for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
-					InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
-
-					ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
-				}
+	int keep_count = 0;
+	for (int i = 0; i < instance_cull_count; i++) {
+		Instance *ins = instance_cull_result[i];
+		uint8_t flags = instance_cull_flags[i];
 
-				geom->gi_probes_dirty = false;
-			}
+		bool keep = flags & CULL_FLAG_KEEP;
+		if (flags & CULL_FLAG_PROCESS_SERIALLY) {
+			keep = _prepare_scene_instance(ins, p_shadow_atlas, p_reflection_probe);
 		}
 
 		if (!keep) {
 			// remove, no reason to keep
-			instance_cull_count--;
-			SWAP(instance_cull_result[i], instance_cull_result[instance_cull_count]);
-			i--;
 			ins->last_render_pass = 0; // make invalid
 		} else {
+			instance_cull_result[keep_count++] = ins;
 			ins->last_render_pass = render_pass;
 		}
 	}
+	instance_cull_count = keep_count;
 
 	/* STEP 5 - PROCESS LIGHTS */
 
@@ -2774,15 +2845,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	}
 
 	// Calculate instance->depth from the camera, after shadow calculation has stopped overwriting instance->depth
-	for (int i = 0; i < instance_cull_count; i++) {
-		Instance *ins = instance_cull_result[i];
-
-		if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
-			Vector3 aabb_center = ins->transformed_aabb.position + (ins->transformed_aabb.size * 0.5);
-			ins->depth = near_plane.distance_to(aabb_center);
-			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
-		}
-	}
+	_cull_work(instance_cull_count, &VisualServerScene::_cull_instance_depth, (const InstanceCullParams *)&cull_params);
 }
 
 void VisualServerScene::_render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, const int p_eye, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
@@ -4098,6 +4161,7 @@ VisualServerScene::VisualServerScene() {
 	_use_bvh = GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", true);
 	GLOBAL_DEF("rendering/quality/spatial_partitioning/bvh_collision_margin", 0.1);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/spatial_partitioning/bvh_collision_margin", PropertyInfo(Variant::REAL, "rendering/quality/spatial_partitioning/bvh_collision_margin", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"));
+	_parallel_culling = GLOBAL_DEF("rendering/threads/parallel_culling", false);
 
 	_visual_server_callbacks = nullptr;
 }
@@ -33,6 +33,7 @@
 
 #include "servers/visual/rasterizer.h"
 
+#include "core/local_vector.h"
 #include "core/math/bvh.h"
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
@@ -308,6 +309,7 @@ public:
 
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_materials = false);
+	void _instance_set_transform(Instance *p_instance, const Transform &p_transform);
 
 	struct InstanceGeometryData : public InstanceBaseData {
 		List<Instance *> lighting;
@@ -509,6 +511,24 @@ public:
 	RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
 	int reflection_probe_cull_count;
 
+	// Per instance results of the parallel culling passes, merged into the cull results serially.
+	enum {
+		CULL_FLAG_KEEP = 1,
+		CULL_FLAG_PROCESS_SERIALLY = 2, // Touches shared state, such as the light and probe lists.
+		CULL_FLAG_ANIMATED_MATERIAL = 4,
+		CULL_WORK_GRAIN = 256,
+	};
+
+	struct InstanceCullParams {
+		uint32_t camera_layer_mask;
+		Plane near_plane;
+		float z_far;
+	};
+
+	LocalVector<uint8_t> instance_cull_flags;
+	LocalVector<uint8_t> instance_shadow_cull_flags;
+	bool _parallel_culling;
+
 	RID_Owner<Instance> instance_owner;
 
 	virtual RID instance_create();
@@ -517,6 +537,7 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material);
@@ -699,12 +720,24 @@ public:
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
+	template <class U>
+	void _cull_work(uint32_t p_elements, void (VisualServerScene::*p_method)(uint32_t, U), U p_userdata);
+	void _cull_instance(uint32_t p_index, const InstanceCullParams *p_params);
+	void _cull_instance_depth(uint32_t p_index, const InstanceCullParams *p_params);
+	void _cull_shadow_caster(uint32_t p_index, const Plane *p_near_plane);
+	int _cull_shadow_casters(int p_cull_count, const Plane &p_near_plane, bool &r_animated_material_found);
+	_FORCE_INLINE_ void _update_instance_geometry_pairs(Instance *p_instance);
+	_FORCE_INLINE_ bool _prepare_scene_instance(Instance *p_instance, RID p_shadow_atlas, RID p_reflection_probe);
+
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
 
 	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int32_t &r_previous_room_id_hint);
 	void _render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, const int p_eye, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 	void render_empty_scene(RID p_scenario, RID p_shadow_atlas);
 
+	void set_parallel_culling(bool p_enable) { _parallel_culling = p_enable; }
+	bool is_parallel_culling_enabled() const { return _parallel_culling; }
+
 	void render_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void render_camera(Ref<ARVRInterface> &p_interface, ARVRInterface::Eyes p_eye, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void update_dirty_instances();
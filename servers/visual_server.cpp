@@ -116,6 +116,23 @@ Array VisualServer::_instances_cull_convex_bind(const Array &p_convex, RID p_sce
 	return to_array(ids);
 }
 
+void VisualServer::_instances_set_transforms_bind(const Array &p_instances, const Array &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	Vector<RID> instances;
+	Vector<Transform> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	RID *instancesw = instances.ptrw();
+	Transform *transformsw = transforms.ptrw();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instancesw[i] = p_instances[i];
+		transformsw[i] = p_transforms[i];
+	}
+
+	instances_set_transforms(instances, transforms);
+}
+
 RID VisualServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -2128,6 +2145,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &VisualServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &VisualServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &VisualServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &VisualServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &VisualServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &VisualServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_material", "instance", "surface", "material"), &VisualServer::instance_set_surface_material);
@@ -2681,6 +2699,7 @@ VisualServer::VisualServer() {
 	GLOBAL_DEF("rendering/gles2/compatibility/disable_half_float", false);
 	GLOBAL_DEF("rendering/gles2/compatibility/disable_half_float.iOS", true);
 	GLOBAL_DEF("rendering/gles2/compatibility/enable_high_float.Android", false);
+	GLOBAL_DEF("rendering/gles3/shaders/shader_cache_enabled", true);
 	GLOBAL_DEF("rendering/batching/precision/uv_contract", false);
 	GLOBAL_DEF("rendering/batching/precision/uv_contract_amount", 100);
 